@@ -0,0 +1,45 @@
+#include <iostream>
+#include <string>
+#include "../lib/mathsolver.h"
+#include "../lib/test/bench-common.h"
+
+using namespace MathSolver;
+
+int main(int argc, char** argv)
+{
+	BenchModule bench("Adaptive precision vs fixed 256 bits");
+	const std::string exprs[] =
+	{
+		"sin(pi/7)",
+		"cos(1/3)",
+		"pi/7+1/3",
+		"(2/3)^20*pi",
+		"exp(pi*163^(1/2))",
+		"cos(pi*10^80)"
+	};
+
+	for (const auto& str : exprs)
+	{
+		ExprNode* expr = parseString(str);
+		flattenExpr(expr);
+
+		std::string fixed, ball;
+		bench.run(str + ", evaluateExpr (256 bits)", 1000, [&]() {
+			ExprNode* res = evaluateExpr(copyOf(expr));
+			fixed = toInfixString(res);
+			freeExpression(res);
+		});
+
+		bench.run(str + ", evaluateBall (256 bits)", 1000, [&]() {
+			evaluateBall(expr, MATHSOLVER_FLOAT_DEFAULT_PREC).roundsTo(MATHSOLVER_ADAPTIVE_DIGITS, ball);
+		});
+
+		AdaptiveResult res;
+		bench.run(str + ", evaluateAdaptive", 1000, [&]() { res = evaluateAdaptive(expr); });
+		bench.note(str + ", fixed / adaptive", fixed + " / " + res.digits + " at " + std::to_string(res.precision) + " bits");
+		freeExpression(expr);
+	}
+
+	std::cout << bench.result() << std::endl;
+	return 0;
+}
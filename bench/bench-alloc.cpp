@@ -0,0 +1,68 @@
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <gmp.h>
+#include "../lib/mathsolver.h"
+#include "../lib/test/bench-common.h"
+
+using namespace MathSolver;
+
+// Allocation counters for operator new and GMP/MPFR limbs
+size_t gNewCount = 0;
+size_t gGmpCount = 0;
+
+void* operator new(size_t size)
+{
+	++gNewCount;
+	void* p = std::malloc(size);
+	if (p == nullptr)	throw std::bad_alloc();
+	return p;
+}
+
+void* operator new[](size_t size)
+{
+	++gNewCount;
+	void* p = std::malloc(size);
+	if (p == nullptr)	throw std::bad_alloc();
+	return p;
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+void* gmpAlloc(size_t size) { ++gGmpCount; return std::malloc(size); }
+void* gmpRealloc(void* p, size_t, size_t size) { ++gGmpCount; return std::realloc(p, size); }
+void gmpFree(void* p, size_t) { std::free(p); }
+
+int main(int argc, char** argv)
+{
+	mp_set_memory_functions(gmpAlloc, gmpRealloc, gmpFree);
+	BenchModule bench("Allocations per evaluateExpr");
+
+	for (const std::string str : { "2*x*1*y*1*z", "1.0*x*y+2.5*x^2*1.0", "(x+1)(x-1)/1", "-1*a*b+-1*c*d+2*x^2*1", "3*4*5/2+1.5*2" })
+	{
+		ExprNode* expr = parseString(str);
+		flattenExpr(expr);
+
+		ExprNode* warm = evaluateExpr(copyOf(expr));
+		freeExpression(warm);
+
+		ExprNode* copy = copyOf(expr);
+		size_t news = gNewCount, gmps = gGmpCount;
+		ExprNode* res = evaluateExpr(copy);
+		news = gNewCount - news;
+		gmps = gGmpCount - gmps;
+
+		bench.note(str + ", operator new", std::to_string(news));
+		bench.note(str + ", GMP/MPFR", std::to_string(gmps));
+		bench.run(str + ", time", 1000, [&]() { freeExpression(evaluateExpr(copyOf(expr))); });
+		freeExpression(res);
+		freeExpression(expr);
+	}
+
+	std::cout << bench.result() << std::endl;
+	return 0;
+}
@@ -0,0 +1,46 @@
+#include <iostream>
+#include <string>
+#include <thread>
+#include "../lib/mathsolver.h"
+#include "../lib/test/bench-common.h"
+
+using namespace MathSolver;
+
+int main(int argc, char** argv)
+{
+	const std::string exprs[] =
+	{
+		"sin(x) > x^2 - 1",
+		"x^3 - 2*x + 1 <= 0",
+		"cos(3*x) * exp(x/10) > 1/2",
+		"log(x^2 + 1) < sin(x) + 1"
+	};
+
+	size_t cores = std::max<size_t>(1, std::thread::hardware_concurrency());
+	interval_t domain = { -50.0, 50.0, true, true };
+	BisectionOptions opts;
+	opts.tolerance = 1e-12;
+
+	BenchModule bench("Branch-and-bound solve on [-50, 50], tolerance 1e-12, " + std::to_string(cores) + " core(s)");
+	for (const auto& str : exprs)
+	{
+		ExprNode* expr = parseString(str);
+		flattenExpr(expr);
+		for (size_t threads : { (size_t)1, cores })
+		{
+			opts.threads = threads;
+			BisectionResult res = solveInequality(expr, domain, opts);
+			std::string label = str + ", " + std::to_string(threads) + " thread(s)";
+			bench.record(label, res.seconds * 1e6);
+			bench.note(label + ", boxes", std::to_string(res.boxes) + ((res.complete) ? "" : " (budget exhausted)"));
+			bench.note(label + ", intervals", std::to_string(res.range.data().size()));
+			if (threads == cores)
+				break;
+		}
+
+		freeExpression(expr);
+	}
+
+	std::cout << bench.result() << std::endl;
+	return 0;
+}
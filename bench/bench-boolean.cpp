@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../lib/mathsolver.h"
+#include "../lib/test/bench-common.h"
+
+using namespace MathSolver;
+
+// Returns a variable name made of letters only: a, b, ..., z, ba, bb, ...
+std::string varName(size_t i)
+{
+	std::string name;
+	do
+	{
+		name.insert(name.begin(), (char)('a' + i % 26));
+		i /= 26;
+	} while (i != 0);
+	return "v" + name;
+}
+
+// Returns 'outer' over 'count' random clauses, each applying 'inner' to 'width' random literals
+// over 'varCount' variables: a CNF for (and, or), a DNF for (or, and).
+ExprNode* randomNormalForm(std::mt19937& rng, const std::string& outer, const std::string& inner,
+						   size_t count, size_t width, size_t varCount)
+{
+	std::uniform_int_distribution<size_t> var(0, varCount - 1);
+	std::bernoulli_distribution neg(0.5);
+	ExprNode* expr = new OpNode(outer);
+	for (size_t i = 0; i < count; ++i)
+	{
+		ExprNode* clause = new OpNode(inner, expr);
+		for (size_t j = 0; j < width; ++j)
+		{
+			ExprNode* lit = new VarNode(varName(var(rng)));
+			if (neg(rng))
+			{
+				ExprNode* op = new OpNode("not", clause);
+				lit->setParent(op);
+				op->children().push_back(lit);
+				lit = op;
+			}
+			
+			lit->setParent(clause);
+			clause->children().push_back(lit);
+		}
+
+		expr->children().push_back(clause);
+	}
+
+	return expr;
+}
+
+// Returns the number of terms of a sum of products.
+std::string termCount(ExprNode* expr)
+{
+	if (expr->isOperator() && ((OpNode*)expr)->name() == "or")
+		return std::to_string(expr->children().size());
+	return (expr->type() == ExprNode::BOOLEAN) ? "0" : "1";
+}
+
+void benchCnf(BenchModule& bench, std::mt19937& rng, const std::string& label, ExprNode* cnf)
+{
+	bool sat = false;
+	bench.run(label + ", satisfiable", 1, [&]() { sat = isSatisfiable(cnf); });
+	bench.note(label + ", satisfiable", sat ? "true" : "false");
+
+	ExprNode* shuffled = copyOf(cnf);
+	std::vector<ExprNode*> clauses(shuffled->children().begin(), shuffled->children().end());
+	std::shuffle(clauses.begin(), clauses.end(), rng);
+	shuffled->children().assign(clauses.begin(), clauses.end());
+
+	bool eqv = false;
+	bench.run(label + ", equivalent to shuffled clauses", 1, [&]() { eqv = isEquivalent(cnf, shuffled); });
+	bench.note(label + ", equivalent to shuffled clauses", eqv ? "true" : "false");
+	bench.note(label + ", BDD nodes by appearance / frequency",
+			   std::to_string(bddSize(cnf, BooleanOrder::APPEARANCE)) + " / " + std::to_string(bddSize(cnf, BooleanOrder::FREQUENCY)));
+	freeExpression(cnf);
+	freeExpression(shuffled);
+}
+
+int main(int argc, char** argv)
+{
+	std::mt19937 rng(0);
+	BenchModule bench("Boolean engine");
+
+	// Word equality a = b as CNF: (a_i or not b_i) and (not a_i or b_i) for each bit
+	for (size_t bits : { 50, 150 })
+	{
+		std::string label = "equality of " + std::to_string(bits) + "-bit words, " + std::to_string(2 * bits) + " clauses";
+		ExprNode* cnf = new OpNode("and");
+		for (size_t i = 0; i < 2 * bits; ++i)
+		{
+			ExprNode* clause = new OpNode("or", cnf);
+			ExprNode* a = new VarNode("a" + varName(i / 2));
+			ExprNode* b = new VarNode("b" + varName(i / 2));
+			ExprNode* neg = new OpNode("not", clause);
+			(i % 2 == 0 ? b : a)->setParent(neg);
+			neg->children().push_back(i % 2 == 0 ? b : a);
+			(i % 2 == 0 ? a : b)->setParent(clause);
+			clause->children().push_back(i % 2 == 0 ? a : b);
+			clause->children().push_back(neg);
+			cnf->children().push_back(clause);
+		}
+
+		benchCnf(bench, rng, label, cnf);
+	}
+
+	for (size_t varCount : { 20, 30 })
+	{
+		std::string label = "3-CNF, " + std::to_string(varCount) + " variables, " + std::to_string(4 * varCount) + " clauses";
+		benchCnf(bench, rng, label, randomNormalForm(rng, "and", "or", 4 * varCount, 3, varCount));
+	}
+
+	for (auto dims : { std::make_pair(6, 40), std::make_pair(12, 400) })
+	{
+		std::string label = "DNF, " + std::to_string(dims.first) + " variables, " + std::to_string(dims.second) + " terms";
+		ExprNode* dnf = randomNormalForm(rng, "or", "and", dims.second, dims.first / 2 + 1, dims.first);
+		ExprNode* orig = copyOf(dnf);
+		bench.run(label + ", minimize", 1, [&]() { dnf = minimizeBoolean(dnf); });
+		bench.note(label + ", terms after / equivalent", termCount(dnf) + (isEquivalent(orig, dnf) ? " / true" : " / false"));
+		freeExpression(orig);
+		freeExpression(dnf);
+	}
+
+	std::cout << bench.result() << std::endl;
+	return 0;
+}
@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../lib/mathsolver.h"
+#include "../lib/test/bench-common.h"
+
+using namespace MathSolver;
+
+// Returns a random expression of 'terms' conjunctions of three literals over the variables,
+// joined by 'or' and 'xor'.
+ExprNode* randomFormula(std::mt19937& rng, const std::vector<std::string>& vars, size_t terms)
+{
+	std::string str;
+	for (size_t i = 0; i < terms; ++i)
+	{
+		if (i != 0)
+			str += (rng() % 4 == 0) ? " xor " : " or ";
+
+		str += "(";
+		for (size_t j = 0; j < 3; ++j)
+		{
+			if (j != 0)			str += " and ";
+			if (rng() % 2)		str += "not ";
+			str += vars[rng() % vars.size()];
+		}
+		str += ")";
+	}
+
+	ExprNode* expr = parseString(str);
+	flattenExpr(expr);
+	return expr;
+}
+
+// Replaces each variable with its value in the row.
+ExprNode* assign(ExprNode* expr, const std::vector<std::string>& vars, const std::vector<std::vector<uint64_t>>& cols, size_t row)
+{
+	if (expr->type() == ExprNode::VARIABLE)
+	{
+		size_t i = std::lower_bound(vars.begin(), vars.end(), ((VarNode*)expr)->name()) - vars.begin();
+		ExprNode* val = new BoolNode((cols[i][row / 64] >> (row % 64)) & 1, expr->parent());
+		delete expr;
+		return val;
+	}
+
+	for (auto& e : expr->children())
+		e = assign(e, vars, cols, row);
+	return expr;
+}
+
+std::string rowsPerSecond(size_t rows, double usec)
+{
+	return std::to_string((long long)(rows / (usec * 1e-6)));
+}
+
+int main(int argc, char** argv)
+{
+	std::mt19937_64 rng(0);
+	std::mt19937 rng32(0);
+	BenchModule bench("Batch boolean evaluation");
+
+	std::vector<std::string> vars;
+	for (char c = 'a'; c <= 't'; ++c)
+		vars.push_back(std::string("v") + c);   // single letters include constants such as e
+
+	const size_t rows = 1 << 20;
+	std::vector<std::vector<uint64_t>> cols(vars.size(), std::vector<uint64_t>(rows / 64));
+	for (auto& c : cols)
+	{
+		for (auto& w : c)
+			w = rng();
+	}
+
+	for (size_t terms : { 10, 100 })
+	{
+		std::string label = std::to_string(terms) + " terms";
+		ExprNode* expr = randomFormula(rng32, vars, terms);
+		BoolProgram prog;
+		prog.lower(expr);
+
+		std::vector<const uint64_t*> columns;
+		for (const auto& v : prog.variables())
+			columns.push_back(cols[std::lower_bound(vars.begin(), vars.end(), v) - vars.begin()].data());
+
+		size_t treeRows = 200;
+		double usec = bench.run(label + ", tree walker, " + std::to_string(treeRows) + " rows", 1, [&]() {
+			for (size_t r = 0; r < treeRows; ++r)
+				freeExpression(evaluateExpr(assign(copyOf(expr), vars, cols, r)));
+		});
+		bench.note(label + ", tree walker, rows/s", rowsPerSecond(treeRows, usec));
+
+		size_t scalarRows = 1 << 14;
+		usec = bench.run(label + ", program, one row at a time, " + std::to_string(scalarRows) + " rows", 1, [&]() {
+			std::vector<bool> vals(prog.variables().size());
+			for (size_t r = 0; r < scalarRows; ++r)
+			{
+				for (size_t i = 0; i < vals.size(); ++i)
+					vals[i] = (columns[i][r / 64] >> (r % 64)) & 1;
+				prog.evaluate(vals);
+			}
+		});
+		bench.note(label + ", program, one row at a time, rows/s", rowsPerSecond(scalarRows, usec));
+
+		std::vector<uint64_t> out;
+		usec = bench.run(label + ", program, bitmaps, " + std::to_string(rows) + " rows", 1, [&]() { out = prog.evaluate(columns, rows); });
+		bench.note(label + ", program, bitmaps, rows/s", rowsPerSecond(rows, usec));
+		bench.note(label + ", instructions", std::to_string(prog.instructions().size()));
+		freeExpression(expr);
+	}
+
+	std::cout << bench.result() << std::endl;
+	return 0;
+}
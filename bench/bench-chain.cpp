@@ -0,0 +1,47 @@
+#include <iostream>
+#include <string>
+#include "../lib/mathsolver.h"
+#include "../lib/test/bench-common.h"
+
+using namespace MathSolver;
+
+// Returns an increasing chain of 'count' alternating Integers and Floats, 1<1.5<2<2.5<..., or
+// its expansion into pairs, 1<1.5 and 1.5<2 and ...
+ExprNode* numericChain(size_t count, bool expand)
+{
+	std::string str = "1";
+	for (size_t i = 1; i < count; ++i)
+	{
+		std::string operand = std::to_string(i / 2 + 1) + ((i % 2) ? ".5" : "");
+		str += "<" + operand;
+		if (expand && i + 1 < count)
+			str += " and " + operand;
+	}
+
+	gErrorManager.clear();  // the parser refuses input while errors are pending
+	ExprNode* expr = parseString(str);
+	flattenExpr(expr);
+	return expr;
+}
+
+int main(int argc, char** argv)
+{
+	for (size_t count : { 1000, 10000 })
+	{
+		BenchModule bench("Increasing chain of " + std::to_string(count) + " Integers and Floats");
+
+		ExprNode* expr = numericChain(count, false);
+		bench.run("chain, one sweep", 1, [&]() { expr = evaluateExpr(expr); });
+		bench.note("chain, result", toInfixString(expr));
+		freeExpression(expr);
+
+		expr = numericChain(count, true);
+		bench.run("expanded into pairs", 1, [&]() { expr = evaluateExpr(expr); });
+		bench.note("expanded, result", toInfixString(expr));
+		freeExpression(expr);
+
+		std::cout << bench.result() << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../lib/mathsolver.h"
+#include "../lib/test/bench-common.h"
+
+using namespace MathSolver;
+
+// Returns 'n' pseudo-random points in [lo, hi).
+std::vector<double> makePoints(size_t n, double lo, double hi)
+{
+	std::vector<double> pts(n);
+	unsigned long long state = 0x2545F4914F6CDD1DULL;
+	for (auto& x : pts)
+	{
+		state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+		x = lo + (hi - lo) * (double)(state >> 11) / (double)(1ULL << 53);
+	}
+
+	return pts;
+}
+
+// Returns the number of points classified as inside.
+size_t countInside(const bool* res, size_t n)
+{
+	return std::count(res, res + n, true);
+}
+
+int main(int argc, char** argv)
+{
+	size_t n = (argc > 1) ? std::stoul(argv[1]) : 10000000;
+	BenchModule bench("Batch classification of " + std::to_string(n) + " points");
+
+	// x^2 - 3x + 2 > 0 and x != 5 and not in [0.1, 0.7], whose endpoints are not doubles
+	Range small = { { "-inf", "1", false, false }, { "2", "5", false, false }, { "5", "inf", false, false } };
+	small = small.subtract(Range("0.1", "0.7", true, true));
+	Range large;
+	for (int k = 0; k < 1000; ++k)
+		large.data().push_back({ Float(std::to_string(2 * k)), Float(std::to_string(2 * k + 1)), true, false });
+
+	std::vector<double> pts = makePoints(n, -10.0, 2000.0);
+	std::vector<double> sorted = pts;
+	std::sort(sorted.begin(), sorted.end());
+	std::unique_ptr<bool[]> res(new bool[n]);
+
+	// Baseline: one Float per point, parsed from a string
+	size_t m = std::min<size_t>(n, 100000), inside = 0;
+	double usec = bench.run("4 intervals, contains(Float(string)), " + std::to_string(m) + " points", 1, [&]() {
+		for (size_t i = 0; i < m; ++i)
+			inside += small.contains(Float(std::to_string(pts[i])));
+	});
+	bench.note("4 intervals, contains(Float(string)), ns/point", std::to_string(1000.0 * usec / m));
+
+	usec = bench.run("4 intervals, batch double (scan)", 1, [&]() { small.contains(pts.data(), n, res.get()); });
+	bench.note("4 intervals, batch double (scan), ns/point", std::to_string(1000.0 * usec / n));
+	bench.note("4 intervals, inside", std::to_string(countInside(res.get(), n)));
+
+	usec = bench.run("1000 intervals, batch double, unsorted (search)", 1, [&]() { large.contains(pts.data(), n, res.get()); });
+	bench.note("1000 intervals, batch double, unsorted (search), ns/point", std::to_string(1000.0 * usec / n));
+	bench.note("1000 intervals, inside", std::to_string(countInside(res.get(), n)));
+
+	usec = bench.run("1000 intervals, batch double, sorted (sweep)", 1, [&]() { large.contains(sorted.data(), n, res.get()); });
+	bench.note("1000 intervals, batch double, sorted (sweep), ns/point", std::to_string(1000.0 * usec / n));
+	bench.note("1000 intervals, inside", std::to_string(countInside(res.get(), n)));
+
+	std::vector<Float> fpts;
+	for (size_t i = 0; i < m; ++i)
+		fpts.push_back(Float(std::to_string(sorted[i * (n / m)])));
+	usec = bench.run("1000 intervals, batch Float, sorted, " + std::to_string(m) + " points", 1, [&]() { large.contains(fpts.data(), m, res.get()); });
+	bench.note("1000 intervals, batch Float, sorted, ns/point", std::to_string(1000.0 * usec / m));
+
+	std::cout << bench.result() << std::endl;
+	return 0;
+}
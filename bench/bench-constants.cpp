@@ -0,0 +1,58 @@
+#include <iostream>
+#include <string>
+#include "../lib/mathsolver.h"
+#include "../lib/test/bench-common.h"
+
+using namespace MathSolver;
+
+int main(int argc, char** argv)
+{
+	BenchModule bench("Constants with interleaved printing");
+	ExprNode* expr = parseString("sin(pi/7)");
+	std::string str;
+
+	bench.run("sin(pi/7), evaluateExpr + print", 1000, [&]() {
+		ExprNode* res = evaluateExpr(copyOf(expr));
+		str = toInfixString(res);
+		freeExpression(res);
+	});
+
+	// Printing used to free the MPFR caches, forcing pi to be recomputed by the next operation
+	bench.run("sin(pi/7), evaluateExpr + print + mpfr_free_cache", 1000, [&]() {
+		ExprNode* res = evaluateExpr(copyOf(expr));
+		str = toInfixString(res);
+		mpfr_free_cache();
+		freeExpression(res);
+	});
+
+	bench.note("sin(pi/7)", str);
+	freeExpression(expr);
+
+	Float seven("7");
+	bench.run("sin(pi/7), Float + constant table + print", 10000, [&]() {
+		str = sin(*constantValue("pi") / seven).toString();
+	});
+
+	bench.run("sin(pi/7), Float + mpfr_const_pi + print + mpfr_free_cache", 10000, [&]() {
+		Float pi;
+		mpfr_const_pi(pi.data(), MATHSOLVER_FLOAT_DEFAULT_RND_MODE);
+		str = sin(pi / seven).toString();
+		mpfr_free_cache();
+	});
+
+	for (mpfr_prec_t prec : { 1024, 4096 })
+	{
+		std::string label = "pi at " + std::to_string(prec) + " bits";
+		constantValue("pi", prec);
+		bench.run(label + ", constant table", 1000, [&]() { constantValue("pi", prec); });
+		bench.run(label + ", mpfr_const_pi after mpfr_free_cache", 1000, [&]() {
+			Float pi;
+			pi.setPrecision(prec);
+			mpfr_const_pi(pi.data(), MATHSOLVER_FLOAT_DEFAULT_RND_MODE);
+			mpfr_free_cache();
+		});
+	}
+
+	std::cout << bench.result() << std::endl;
+	return 0;
+}
@@ -0,0 +1,43 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../lib/mathsolver.h"
+#include "../lib/test/bench-common.h"
+
+using namespace MathSolver;
+
+// Returns the conjunction (and (x0 > 0) (x1 < n+1) (x0 > 1) ...) of 'count' strict bounds spread
+// over 'varCount' variables. Lower bounds rise and upper bounds fall so each one tightens the range.
+ExprNode* boundConjunction(size_t count, size_t varCount)
+{
+	ExprNode* conj = new OpNode("and");
+	for (size_t i = 0; i < count; ++i)
+	{
+		ExprNode* bound = new OpNode((i % 2 == 0) ? ">" : "<", conj);
+		ExprNode* var = new VarNode("x" + std::to_string((i / 2) % varCount), bound);
+		ExprNode* num = new IntNode(Integer((i % 2 == 0) ? i / 2 : count - i / 2), bound);
+		bound->children().push_back(var);
+		bound->children().push_back(num);
+		conj->children().push_back(bound);
+	}
+
+	return conj;
+}
+
+int main(int argc, char** argv)
+{
+	size_t count = 10000;
+	BenchModule bench("Conjunction of " + std::to_string(count) + " bounds");
+
+	for (size_t varCount : { 1, 100, 5000 })
+	{
+		ExprNode* expr = boundConjunction(count, varCount);
+		bench.run(std::to_string(varCount) + " variable(s)", 1, [&]() { expr = inequalityAnd(expr); });
+		bool isConj = expr->isOperator() && ((OpNode*)expr)->name() == "and";
+		bench.note(std::to_string(varCount) + " variable(s), terms left", std::to_string(isConj ? expr->children().size() : 1));
+		freeExpression(expr);
+	}
+
+	std::cout << bench.result() << std::endl;
+	return 0;
+}
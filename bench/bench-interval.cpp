@@ -0,0 +1,57 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../lib/mathsolver.h"
+#include "../lib/test/bench-common.h"
+
+using namespace MathSolver;
+
+// Tiles [-10, 10] x [-1, 1] into n x n boxes.
+std::vector<IntervalBox> makeBoxes(int n, mpfr_prec_t prec)
+{
+	std::vector<IntervalBox> boxes;
+	for (int i = 0; i < n; ++i)
+	{
+		Interval x(Float(std::to_string(-10.0 + 20.0 * i / n)), Float(std::to_string(-10.0 + 20.0 * (i + 1) / n)), prec);
+		for (int j = 0; j < n; ++j)
+		{
+			Interval y(Float(std::to_string(-1.0 + 2.0 * j / n)), Float(std::to_string(-1.0 + 2.0 * (j + 1) / n)), prec);
+			boxes.push_back({ { "x", x }, { "y", y } });
+		}
+	}
+
+	return boxes;
+}
+
+int main(int argc, char** argv)
+{
+	BenchModule bench("Interval enclosures over 10^4 boxes");
+	const std::string exprs[] =
+	{
+		"x^2-2*x*y+y^2",
+		"x^5-3*x^3+x-1/7",
+		"sin(x)*exp(y)-cos(x*y)",
+		"(x^2+1)/(y^2+1)+pi*x"
+	};
+
+	for (mpfr_prec_t prec : { 64, 256 })
+	{
+		std::vector<IntervalBox> boxes = makeBoxes(100, prec);
+		for (const auto& str : exprs)
+		{
+			ExprNode* expr = parseString(str);
+			size_t undef = 0;
+			double usec = bench.run(str + ", " + std::to_string(prec) + " bits", 1, [&]() {
+				for (const auto& box : boxes)
+					undef += evaluateInterval(expr, box, prec).isUndef();
+			});
+
+			bench.note(str + ", " + std::to_string(prec) + " bits, enclosures/s",
+					   std::to_string((size_t)(boxes.size() / (usec * 1e-6))) + " (" + std::to_string(undef) + " undef)");
+			freeExpression(expr);
+		}
+	}
+
+	std::cout << bench.result() << std::endl;
+	return 0;
+}
@@ -0,0 +1,64 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../lib/mathsolver.h"
+#include "../lib/test/bench-common.h"
+
+using namespace MathSolver;
+
+// Returns 'count' random constraints a . x < b over 'vars' variables with integer coefficients in
+// [-20, 20] and b in [1, 100], so the origin is always feasible.
+LinearSystem randomSystem(std::mt19937& rng, size_t vars, size_t count)
+{
+	std::uniform_int_distribution<int> coeff(-20, 20), bound(1, 100);
+	LinearSystem system(vars);
+	for (size_t i = 0; i < count; ++i)
+	{
+		std::vector<Rational> coeffs(vars);
+		for (auto& c : coeffs)
+			c = Rational(Integer(coeff(rng)));
+		system.add(coeffs, Rational(Integer(bound(rng))), true);
+	}
+
+	return system;
+}
+
+int main(int argc, char** argv)
+{
+	std::mt19937 rng(48);
+	for (size_t vars : { 2, 5 })
+	{
+		BenchModule bench("Random linear systems in " + std::to_string(vars) + " variables");
+		for (size_t count : { 100, 300 })
+		{
+			std::string label = std::to_string(count) + " constraints";
+			LinearSystem system = randomSystem(rng, vars, count);
+			bool feasible = false;
+			bench.run(label + ", feasibility", 1, [&]() { feasible = system.feasible(); });
+
+			Range range;
+			bench.run(label + ", projection onto x_0", 1, [&]() { range = linearRange(system, 0); });
+			bench.note(label + ", x_0 in", range.toString());
+
+			// Shifting one constraint past the origin's opposite side makes the system infeasible
+			LinearSystem empty = system;
+			std::vector<Rational> coeffs(vars);
+			coeffs[0] = Rational(Integer(-1));
+			empty.add(coeffs, Rational(Integer(-1000)), false);
+			bench.run(label + ", infeasible", 1, [&]() { feasible = empty.feasible(); });
+			bench.note(label + ", infeasible detected", feasible ? "no" : "yes");
+
+			if (count <= 100)
+			{
+				std::vector<size_t> kept;
+				bench.run(label + ", reduction", 1, [&]() { kept = system.reduce(); });
+				bench.note(label + ", irredundant", std::to_string(kept.size()));
+			}
+		}
+
+		std::cout << bench.result() << std::endl;
+	}
+
+	return 0;
+}
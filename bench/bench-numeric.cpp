@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include "../lib/mathsolver.h"
+#include "../lib/test/bench-common.h"
+
+using namespace MathSolver;
+
+// Returns an operator node with the given operands.
+ExprNode* naryOp(const std::string& name, const std::vector<ExprNode*>& operands)
+{
+	ExprNode* op = new OpNode(name);
+	for (auto e : operands)
+	{
+		e->setParent(op);
+		op->children().push_back(e);
+	}
+
+	return op;
+}
+
+// Returns n integers in [-10^6, 10^6], half of which cancel another operand.
+std::vector<ExprNode*> intTerms(size_t n)
+{
+	std::mt19937 rng(n);
+	std::vector<ExprNode*> terms;
+	for (size_t i = 0; i < n / 2; ++i)
+	{
+		int v = (int)(rng() % 2000001) - 1000000;
+		terms.push_back(new IntNode(v));
+		terms.push_back(new IntNode((i % 2 == 0) ? -v : (int)(rng() % 2000001) - 1000000));
+	}
+
+	std::shuffle(terms.begin(), terms.end(), rng);
+	return terms;
+}
+
+// Returns n floats in [-1, 1], half of which cancel another operand.
+std::vector<ExprNode*> floatTerms(size_t n)
+{
+	std::mt19937 rng(n);
+	std::uniform_real_distribution<double> dist(-1.0, 1.0);
+	std::vector<ExprNode*> terms;
+	for (size_t i = 0; i < n / 2; ++i)
+	{
+		std::string v = std::to_string(dist(rng));
+		terms.push_back(new FloatNode(Float(v)));
+		terms.push_back(new FloatNode((i % 2 == 0) ? -Float(v) : Float(std::to_string(dist(rng)))));
+	}
+
+	std::shuffle(terms.begin(), terms.end(), rng);
+	return terms;
+}
+
+int main(int argc, char** argv)
+{
+	BenchModule bench("Numeric n-ary sums and products");
+	const size_t N = 10000;
+
+	ExprNode* res = nullptr;
+	std::vector<ExprNode*> ints = intTerms(N);
+	ExprNode* isum = naryOp("+", ints);
+	bench.run("sum of 10^4 integers", 1, [&]() { res = numericAdd(copyOf(isum)); });
+	bench.note("sum of 10^4 integers, result", toInfixString(res));
+	freeExpression(res);
+	freeExpression(isum);
+
+	std::vector<ExprNode*> floats = floatTerms(N);
+	ExprNode* fsum = naryOp("+", floats);
+	bench.run("sum of 10^4 floats", 1, [&]() { res = numericAdd(copyOf(fsum)); });
+	bench.note("sum of 10^4 floats, result", toInfixString(res));
+	freeExpression(res);
+	freeExpression(fsum);
+
+	std::vector<ExprNode*> factors;
+	for (size_t i = 1; i <= N; ++i)
+		factors.push_back(new IntNode((int)i));
+	ExprNode* iprod = naryOp("*", factors);
+	bench.run("product 1*2*...*10^4 (integers)", 1, [&]() { res = numericMul(copyOf(iprod)); });
+	bench.note("product 1*2*...*10^4, result", integerToFloat(((IntNode*)res)->value(), 64).toString());
+	freeExpression(res);
+	freeExpression(iprod);
+
+	factors.clear();
+	for (size_t i = 1; i <= N; ++i)
+		factors.push_back(new FloatNode(Float(std::to_string(1.0 + 1.0 / i))));
+	ExprNode* fprod = naryOp("*", factors);
+	bench.run("product of 10^4 floats", 1, [&]() { res = numericMul(copyOf(fprod)); });
+	bench.note("product of 10^4 floats, result", toInfixString(res));
+	freeExpression(res);
+	freeExpression(fprod);
+
+	std::cout << bench.result() << std::endl;
+	return 0;
+}
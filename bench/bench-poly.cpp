@@ -0,0 +1,83 @@
+#include <iostream>
+#include <string>
+#include "../lib/mathsolver.h"
+#include "../lib/test/bench-common.h"
+
+using namespace MathSolver;
+
+// Returns (x+y+1)^n fully distributed into 3^n unsimplified products,
+// e.g. n = 2: x*x+x*y+x*1+y*x+...+1*1
+ExprNode* distributed(size_t n)
+{
+	const char* FACTORS[3] = { "x", "y", "1" };
+	size_t terms = 1;
+	for (size_t i = 0; i < n; ++i)
+		terms *= 3;
+
+	ExprNode* add = new OpNode("+");
+	for (size_t t = 0; t < terms; ++t)
+	{
+		ExprNode* mul = new OpNode("*", add);
+		for (size_t i = 0, digits = t; i < n; ++i, digits /= 3)
+		{
+			if (digits % 3 == 2)	mul->children().push_back(new IntNode(1, mul));
+			else					mul->children().push_back(new VarNode(FACTORS[digits % 3], mul));
+		}
+
+		add->children().push_back(mul);
+	}
+
+	return add;
+}
+
+int main(int argc, char** argv)
+{
+	BenchModule bench("Polynomial expansion");
+
+	for (int n : { 5, 10, 20 })
+	{
+		std::string label = "(x+y+1)^" + std::to_string(n);
+		ExprNode* expr = parseString(label);
+		SparsePoly base;
+		toSparsePoly(expr->children().front(), base);
+
+		bench.run(label + ", SparsePoly::pow", 10, [&]() { base.pow(n); });
+		bench.run(label + ", expandPolynomial", 10, [&]() { freeExpression(expandPolynomial(copyOf(expr))); });
+
+		ExprNode* res = evaluateExpr(copyOf(expr));
+		bench.note(label + ", evaluateExpr (tree)", toInfixString(res));
+		freeExpression(res);
+		freeExpression(expr);
+	}
+
+	std::cout << bench.result() << std::endl;
+
+	bench.reset("Collecting like terms of distributed (x+y+1)^n");
+	for (size_t n : { 3, 4, 5 })
+	{
+		ExprNode* expr = distributed(n);
+		std::string label = std::to_string(expr->children().size()) + " terms";
+		SparsePoly poly;
+
+		bench.run(label + ", evaluateExpr (tree)", 1, [&]() { freeExpression(evaluateExpr(copyOf(expr))); });
+		bench.run(label + ", toSparsePoly", 10, [&]() { toSparsePoly(expr, poly); });
+		bench.note(label + ", distinct terms", std::to_string(poly.size()));
+		freeExpression(expr);
+	}
+
+	std::cout << bench.result() << std::endl;
+
+	bench.reset("Dense univariate expansion");
+	for (unsigned int n : { 20, 100, 500 })
+	{
+		std::string label = "(x+1)^" + std::to_string(n);
+		DensePoly base({ Integer(1), Integer(1) });
+		DensePoly poly;
+
+		bench.run(label + ", DensePoly::pow", 5, [&]() { poly = base.pow(n); });
+		bench.note(label + ", degree", std::to_string(poly.degree()));
+	}
+
+	std::cout << bench.result() << std::endl;
+	return 0;
+}
@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include "../lib/mathsolver.h"
+#include "../lib/test/bench-common.h"
+
+using namespace MathSolver;
+
+// Replaces each variable in the expression with its value.
+ExprNode* substitute(ExprNode* expr, const std::vector<std::string>& vars, const std::vector<Float>& vals)
+{
+	if (expr->type() == ExprNode::VARIABLE)
+	{
+		size_t i = std::find(vars.begin(), vars.end(), ((VarNode*)expr)->name()) - vars.begin();
+		ExprNode* val = new FloatNode(vals[i], expr->parent());
+		delete expr;
+		return val;
+	}
+
+	for (auto& e : expr->children())
+		e = substitute(e, vars, vals);
+	return expr;
+}
+
+// Returns a random dense polynomial of the given degree in x with coefficients in [-99, 99].
+ExprNode* randomPolynomial(size_t degree)
+{
+	std::mt19937 rng(degree);
+	std::vector<Integer> coeffs;
+	for (size_t i = 0; i <= degree; ++i)
+		coeffs.push_back(Integer((int)(rng() % 199) - 99));
+	return fromDensePoly(DensePoly(std::move(coeffs)), "x");
+}
+
+// Times evaluation of the polynomial through the expression tree and the lowered program.
+void benchPolynomial(BenchModule& bench, const std::string& label, ExprNode* expr, size_t count)
+{
+	PolyProgram horner, estrin;
+	horner.lower(expr);
+	estrin.lower(expr, PolyProgram::ESTRIN);
+
+	std::vector<double> dvals(horner.variables().size(), 0.75);
+	std::vector<Float> fvals(horner.variables().size(), Float("0.75"));
+	Float res;
+
+	bench.run(label + ", evaluateExpr (tree)", count, [&]() { freeExpression(evaluateExpr(substitute(copyOf(expr), horner.variables(), fvals))); });
+	bench.run(label + ", Horner (256-bit)", count, [&]() { res = horner.evaluate(fvals); });
+	bench.run(label + ", Estrin (256-bit)", count, [&]() { res = estrin.evaluate(fvals); });
+	bench.run(label + ", Horner (double)", count, [&]() { horner.evaluate(dvals); });
+	bench.run(label + ", Estrin (double)", count, [&]() { estrin.evaluate(dvals); });
+	bench.note(label + ", instructions", std::to_string(horner.instructions().size()) + " Horner, " +
+										 std::to_string(estrin.instructions().size()) + " Estrin");
+}
+
+int main(int argc, char** argv)
+{
+	BenchModule bench("Polynomial evaluation");
+
+	for (size_t degree : { 10, 100 })
+	{
+		ExprNode* expr = randomPolynomial(degree);
+		benchPolynomial(bench, "degree " + std::to_string(degree), expr, 100);
+		freeExpression(expr);
+	}
+
+	for (const std::string str : { "(x+y+1)^10", "(x+y+z)^8" })
+	{
+		ExprNode* expr = parseString(str);
+		expr = expandPolynomial(expr);
+		benchPolynomial(bench, str + " expanded", expr, 100);
+		freeExpression(expr);
+	}
+
+	std::cout << bench.result() << std::endl;
+	return 0;
+}
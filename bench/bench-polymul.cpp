@@ -0,0 +1,41 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include "../lib/mathsolver.h"
+#include "../lib/test/bench-common.h"
+
+using namespace MathSolver;
+
+// Returns a random polynomial of the given length with coefficients in [-max, max].
+DensePoly randomPoly(std::mt19937& rng, size_t len, int max)
+{
+	std::uniform_int_distribution<int> dist(-max, max);
+	std::vector<Integer> coeffs;
+	for (size_t i = 0; i < len; ++i)
+		coeffs.push_back(Integer(dist(rng)));
+	return DensePoly(std::move(coeffs));
+}
+
+int main(int argc, char** argv)
+{
+	BenchModule bench("Dense polynomial multiplication");
+	std::mt19937 rng(0);
+
+	for (size_t len : { 10, 100, 1000, 10000 })
+	{
+		std::string label = "degree " + std::to_string(len - 1);
+		DensePoly a = randomPoly(rng, len, 1000);
+		DensePoly b = randomPoly(rng, len, 1000);
+		DensePoly res;
+		size_t count = (len <= 100) ? 100 : 1;
+
+		if (len <= 1000)
+			bench.run(label + ", schoolbook", count, [&]() { res = mulSchoolbook(a, b); });
+		bench.run(label + ", Karatsuba", count, [&]() { res = mulKaratsuba(a, b); });
+		bench.run(label + ", NTT", count, [&]() { mulNTT(a, b, res); });
+		bench.run(label + ", mul", count, [&]() { res = mul(a, b); });
+	}
+
+	std::cout << bench.result() << std::endl;
+	return 0;
+}
@@ -0,0 +1,81 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "../lib/mathsolver.h"
+#include "../lib/test/bench-common.h"
+
+using namespace MathSolver;
+
+// Returns a polynomial in x and y of the given number of terms in standard form,
+// e.g. 3x^2y+2xy+y+1
+ExprNode* polynomial(size_t terms)
+{
+	ExprNode* add = new OpNode("+");
+	for (size_t i = terms - 1; i > 0; --i)
+	{
+		ExprNode* mul = new OpNode("**", add);
+		ExprNode* pow = new OpNode("^", mul);
+		pow->children().push_back(new VarNode("x", pow));
+		pow->children().push_back(new IntNode(Integer((int)i), pow));
+		mul->children().push_back(new IntNode(Integer((int)i + 1), mul));
+		mul->children().push_back(pow);
+		mul->children().push_back(new VarNode("y", mul));
+		add->children().push_back(mul);
+	}
+
+	add->children().push_back(new IntNode(1, add));
+	return add;
+}
+
+// Returns a polynomial in x in Horner form with the given number of terms,
+// e.g. ((4x+3)x+2)x+1. The depth of the tree grows with the number of terms.
+ExprNode* nestedPolynomial(size_t terms)
+{
+	ExprNode* expr = new IntNode(Integer((int)terms));
+	for (size_t i = terms - 1; i > 0; --i)
+	{
+		ExprNode* add = new OpNode("+");
+		ExprNode* mul = new OpNode("*", add);
+		mul->children().push_back(expr);
+		mul->children().push_back(new VarNode("x", mul));
+		expr->setParent(mul);
+		add->children().push_back(mul);
+		add->children().push_back(new IntNode(Integer((int)i), add));
+		expr = add;
+	}
+
+	return expr;
+}
+
+template <typename Gen>
+void benchPrinters(BenchModule& bench, const Gen& gen, const std::string& name, size_t terms)
+{
+	ExprNode* expr = gen(terms);
+	std::string label = std::to_string(terms) + " terms (" + name + ")";
+	size_t count = 20000 / terms + 1;
+	std::string buf;
+	std::ostringstream out;
+
+	bench.run(label + ", toInfixString", count, [&]() { toInfixString(expr); });
+	bench.run(label + ", appendInfix (reused buffer)", count, [&]() { buf.clear(); appendInfix(buf, expr); });
+	bench.run(label + ", printInfix (ostream)", count, [&]() { out.str(""); printInfix(out, expr); });
+	bench.run(label + ", toPrefixString", count, [&]() { toPrefixString(expr); });
+	bench.run(label + ", appendPrefix (reused buffer)", count, [&]() { buf.clear(); appendPrefix(buf, expr); });
+	bench.note(label + ", output size", std::to_string(buf.size()) + " bytes");
+	freeExpression(expr);
+}
+
+int main(int argc, char** argv)
+{
+	const size_t SIZES[] = { 100, 1000, 5000 };
+	BenchModule bench("Expression printers");
+
+	for (size_t terms : SIZES)
+	{
+		benchPrinters(bench, polynomial, "standard form", terms);
+		benchPrinters(bench, nestedPolynomial, "Horner form", terms);
+	}
+
+	std::cout << bench.result() << std::endl;
+	return 0;
+}
@@ -0,0 +1,101 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../lib/mathsolver.h"
+#include "../lib/test/bench-common.h"
+
+using namespace MathSolver;
+
+// Small deterministic generator
+struct Lcg
+{
+	unsigned long long state = 0x9E3779B97F4A7C15ULL;
+	size_t next(size_t n) { state = state * 6364136223846793005ULL + 1442695040888963407ULL; return (state >> 33) % n; }
+};
+
+// Returns a Range of 1 to 4 intervals in [0, 10000] with endpoints on a grid of 1/4.
+Range randomRange(Lcg& rng)
+{
+	std::vector<interval_t> ivals;
+	size_t count = 1 + rng.next(4);
+	for (size_t i = 0; i < count; ++i)
+	{
+		double lo = rng.next(40000) / 4.0;
+		double hi = lo + rng.next(400) / 4.0;
+		ivals.push_back({ lo, hi, rng.next(2) == 0, rng.next(2) == 0 });
+	}
+
+	return Range(std::move(ivals));
+}
+
+int main(int argc, char** argv)
+{
+	size_t rangeCount = 5000, pointCount = 10000, queryCount = 10000;
+	BenchModule bench("RangeIndex vs naive loop, " + std::to_string(rangeCount) + " ranges");
+
+	Lcg rng;
+	std::vector<Range> ranges;
+	for (size_t i = 0; i < rangeCount; ++i)
+		ranges.push_back(randomRange(rng));
+
+	std::vector<Float> points;
+	for (size_t i = 0; i < pointCount; ++i)
+		points.push_back(Float(std::to_string(rng.next(40000) / 4.0 + 0.125 * rng.next(2))));
+
+	std::vector<interval_t> queries;
+	for (size_t i = 0; i < queryCount; ++i)
+	{
+		double lo = rng.next(40000) / 4.0;
+		queries.push_back({ lo, lo + 5.0, true, false });
+	}
+
+	RangeIndex index;
+	bench.run("bulk build", 1, [&]() { index = RangeIndex(ranges); });
+
+	RangeIndex incremental;
+	bench.run("incremental insert", 1, [&]() {
+		for (const auto& r : ranges)
+			incremental.insert(r);
+	});
+
+	size_t naiveHits = 0, indexHits = 0, incrementalHits = 0;
+	bench.run("stab, naive loop, " + std::to_string(pointCount) + " points", 1, [&]() {
+		for (const auto& x : points)
+		{
+			for (const auto& r : ranges)
+				naiveHits += r.contains(x);
+		}
+	});
+
+	bench.run("stab, RangeIndex, " + std::to_string(pointCount) + " points", 1, [&]() {
+		for (const auto& x : points)
+			indexHits += index.stab(x).size();
+	});
+
+	bench.run("stab, RangeIndex (incremental), " + std::to_string(pointCount) + " points", 1, [&]() {
+		for (const auto& x : points)
+			incrementalHits += incremental.stab(x).size();
+	});
+
+	bench.note("stab hits, naive / index / incremental", std::to_string(naiveHits) + " / " + std::to_string(indexHits) +
+			   " / " + std::to_string(incrementalHits));
+
+	naiveHits = indexHits = 0;
+	bench.run("overlap, naive loop, " + std::to_string(queryCount) + " intervals", 1, [&]() {
+		for (const auto& q : queries)
+		{
+			Range rq(q);
+			for (const auto& r : ranges)
+				naiveHits += r.intersectsWith(rq);
+		}
+	});
+
+	bench.run("overlap, RangeIndex, " + std::to_string(queryCount) + " intervals", 1, [&]() {
+		for (const auto& q : queries)
+			indexHits += index.overlap(q).size();
+	});
+
+	bench.note("overlap hits, naive / index", std::to_string(naiveHits) + " / " + std::to_string(indexHits));
+	std::cout << bench.result() << std::endl;
+	return 0;
+}
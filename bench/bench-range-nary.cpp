@@ -0,0 +1,76 @@
+#include <iostream>
+#include <string>
+#include "../lib/mathsolver.h"
+#include "../lib/test/bench-common.h"
+
+using namespace MathSolver;
+
+// Returns the union of [period * k + offset, period * k + offset + width] for k = 0, ..., n - 1.
+Range makeRange(size_t n, double period, double offset, double width)
+{
+	Range r;
+	for (size_t k = 0; k < n; ++k)
+		r.data().push_back({ period * k + offset, period * k + offset + width, true, true });
+	return r;
+}
+
+int main(int argc, char** argv)
+{
+	size_t count = (argc > 1) ? std::stoul(argv[1]) : 1000;
+	for (size_t k : { 1, 10 })
+	{
+		// Range i covers [i + j * count, i + j * count + 0.5], disjoint from every other Range
+		std::vector<Range> ranges;
+		std::vector<const Range*> ptrs;
+		for (size_t i = 0; i < count; ++i)
+			ranges.push_back(makeRange(k, (double)count, (double)i, 0.5));
+		for (const auto& r : ranges)
+			ptrs.push_back(&r);
+
+		BenchModule bench(std::to_string(count) + "-way union of Ranges with " + std::to_string(k) + " interval(s)");
+		Range res;
+		bench.run("pairwise fold", 1, [&]() {
+			res = Range();
+			for (const auto& r : ranges)
+				res = res.disjoin(r);
+		});
+		bench.note("pairwise fold, intervals", std::to_string(res.data().size()));
+
+		bench.run("k-way merge", 1, [&]() { res = Range::disjoin(ptrs); });
+		bench.note("k-way merge, intervals", std::to_string(res.data().size()));
+
+		// The same Ranges widened to overlap, so every intersection is nonempty
+		for (auto& r : ranges)
+		{
+			for (auto& ival : r.data())
+				ival.upper = ival.upper.toDouble(MPFR_RNDN) + count - 1.0;
+		}
+
+		bench.run("intersection, pairwise fold", 1, [&]() {
+			res = ranges.front();
+			for (const auto& r : ranges)
+				res = res.conjoin(r);
+		});
+		bench.note("intersection, pairwise fold, intervals", std::to_string(res.data().size()));
+
+		bench.run("intersection, k-way merge", 1, [&]() { res = Range::conjoin(ptrs); });
+		bench.note("intersection, k-way merge, intervals", std::to_string(res.data().size()));
+
+		// Evaluated as an expression
+		std::string str = makeRange(1, 1.0, 0.0, 0.5).toString();
+		for (size_t i = 1; i < count; ++i)
+			str += " or " + makeRange(1, 1.0, (double)i, 0.5).toString();
+
+		gErrorManager.clear();  // the parser refuses input while errors are pending
+		ExprNode* expr = parseString(str);
+		flattenExpr(expr);
+		bench.run("evaluateExpr, 'or' of ranges", 1, [&]() { expr = evaluateExpr(expr); });
+		bench.note("evaluateExpr, intervals", (expr->type() == ExprNode::RANGE) ?
+			std::to_string(((RangeNode*)expr)->value().data().size()) : "not evaluated");
+		freeExpression(expr);
+
+		std::cout << bench.result() << std::endl;
+	}
+
+	return 0;
+}
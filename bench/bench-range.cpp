@@ -0,0 +1,67 @@
+#include <iostream>
+#include <malloc.h>
+#include <string>
+#include "../lib/mathsolver.h"
+#include "../lib/test/bench-common.h"
+
+using namespace MathSolver;
+
+// Returns the union of [period * k + offset, period * k + offset + width] for k = 0, ..., n - 1.
+Range makeRange(size_t n, const Float& period, const Float& offset, const Float& width)
+{
+	Range r;
+	Float lo = offset;
+	for (size_t k = 0; k < n; ++k, lo = lo + period)
+		r.data().push_back({ lo, lo + width, true, true });
+	return r;
+}
+
+// Returns the heap bytes per interval used by a Range built with makeRange.
+double bytesPerInterval(size_t n, const Float& period, const Float& offset, const Float& width)
+{
+	struct mallinfo2 before = mallinfo2();
+	Range r = makeRange(n, period, offset, width);
+	r.data().shrink_to_fit();
+	struct mallinfo2 after = mallinfo2();
+	return (double)((after.uordblks + after.hblkhd) - (before.uordblks + before.hblkhd)) / n;
+}
+
+int main(int argc, char** argv)
+{
+	size_t n = (argc > 1) ? std::stoul(argv[1]) : 100000;
+	BenchModule bench("Range with " + std::to_string(n) + " intervals");
+
+	Range a = makeRange(n, Float("2"), Float("0"), Float("1"));
+	Range b = makeRange(n, Float("2"), Float("0.5"), Float("1"));
+	Range c = makeRange(n, Float("2"), Float("1.25"), Float("0.5"));
+	Range res;
+
+	bench.note("sizeof(interval_t)", std::to_string(sizeof(interval_t)));
+	bench.note("heap bytes per interval, integer endpoints", std::to_string(bytesPerInterval(n, Float("2"), Float("0"), Float("1"))));
+	bench.note("heap bytes per interval, endpoints k + 0.1", std::to_string(bytesPerInterval(n, Float("2"), Float("0.1"), Float("1"))));
+
+	size_t hits = 0;
+	Float step("0.25");
+	bench.run("contains, " + std::to_string(n) + " points", 1, [&]() {
+		Float x("0.1");
+		for (size_t i = 0; i < n; ++i, x = x + step)
+			hits += a.contains(x);
+	});
+	bench.note("contains, hits", std::to_string(hits));
+
+	bench.run("conjoin, overlapping", 1, [&]() { res = a.conjoin(b); });
+	bench.note("conjoin, intervals", std::to_string(res.data().size()));
+
+	bench.run("disjoin, overlapping", 1, [&]() { res = a.disjoin(b); });
+	bench.note("disjoin, intervals", std::to_string(res.data().size()));
+
+	bench.run("subtract, overlapping", 1, [&]() { res = a.subtract(b); });
+	bench.note("subtract, intervals", std::to_string(res.data().size()));
+
+	bool inter = true;
+	bench.run("intersectsWith, disjoint", 1, [&]() { inter = a.intersectsWith(c); });
+	bench.note("intersectsWith, disjoint", inter ? "true" : "false");
+
+	std::cout << bench.result() << std::endl;
+	return 0;
+}
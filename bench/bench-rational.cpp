@@ -0,0 +1,73 @@
+#include <iostream>
+#include <string>
+#include "../lib/mathsolver.h"
+#include "../lib/test/bench-common.h"
+
+using namespace MathSolver;
+
+// Returns "1/1+1/2+...+1/n" with the given numerator.
+std::string harmonic(size_t n, const std::string& num)
+{
+	std::string str;
+	for (size_t i = 1; i <= n; ++i)
+	{
+		if (i != 1) str += "+";
+		str += num + "/" + std::to_string(i);
+	}
+
+	return str;
+}
+
+int main(int argc, char** argv)
+{
+	BenchModule bench("Harmonic sums");
+
+	for (size_t n : { 100, 1000 })
+	{
+		std::string label = "H(" + std::to_string(n) + ")";
+		ExprNode* exact = parseString(harmonic(n, "1"));
+		ExprNode* inexact = parseString(harmonic(n, "1.0"));
+		flattenExpr(exact);
+		flattenExpr(inexact);
+
+		// Printing is not timed: Integer::toString is quadratic in the number of digits
+		ExprNode* res = nullptr;
+		bench.run(label + ", evaluateExpr (Rational)", 10, [&]() {
+			freeExpression(res);
+			res = evaluateExpr(copyOf(exact));
+		});
+		bench.note(label + ", characters", std::to_string(toInfixString(res).size()));
+		freeExpression(res);
+		res = nullptr;
+
+		bench.run(label + ", evaluateExpr (Float)", 10, [&]() {
+			freeExpression(res);
+			res = evaluateExpr(copyOf(inexact));
+		});
+		bench.note(label + ", Float", toInfixString(res));
+		freeExpression(res);
+
+		// Sequential sums with lazy and eager reduction
+		bench.run(label + ", Rational +=, lazy gcd", 10, [&]() {
+			Rational sum;
+			for (size_t i = 1; i <= n; ++i)
+				sum += Rational(Integer(1), Integer((int)i));
+			sum.reduce();
+		});
+
+		bench.run(label + ", Rational +=, gcd per step", 10, [&]() {
+			Rational sum;
+			for (size_t i = 1; i <= n; ++i)
+			{
+				sum += Rational(Integer(1), Integer((int)i));
+				sum.reduce();
+			}
+		});
+
+		freeExpression(exact);
+		freeExpression(inexact);
+	}
+
+	std::cout << bench.result() << std::endl;
+	return 0;
+}
@@ -0,0 +1,65 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include "../lib/mathsolver.h"
+#include "../lib/test/bench-common.h"
+
+using namespace MathSolver;
+
+// Returns a random monomial c * x^i * y^j * z^k with up to three variables.
+ExprNode* randomTerm(std::mt19937& rng)
+{
+	const char* VARS[3] = { "x", "y", "z" };
+	ExprNode* mul = new OpNode("**");
+	mul->children().push_back(new IntNode((int)(rng() % 99 + 2), mul));
+	for (size_t i = 0; i < 3; ++i)
+	{
+		int n = rng() % 6;
+		if (n == 0)
+			continue;
+
+		ExprNode* pow = new OpNode("^", mul);
+		pow->children().push_back(new VarNode(VARS[i], pow));
+		pow->children().push_back(new IntNode(n + 1, pow));
+		mul->children().push_back(pow);
+	}
+
+	return mul;
+}
+
+// Returns a random polynomial with the given number of (possibly repeated) terms.
+ExprNode* randomPolynomial(size_t terms)
+{
+	std::mt19937 rng(terms);
+	ExprNode* add = new OpNode("+");
+	for (size_t i = 0; i < terms; ++i)
+	{
+		ExprNode* term = randomTerm(rng);
+		term->setParent(add);
+		add->children().push_back(term);
+	}
+
+	return add;
+}
+
+int main(int argc, char** argv)
+{
+	BenchModule bench("Polynomial reordering");
+
+	for (size_t terms : { 100, 1000, 5000 })
+	{
+		std::string label = std::to_string(terms) + " terms";
+		ExprNode* expr = randomPolynomial(terms);
+		size_t count = 10000 / terms;
+
+		bench.run(label + ", comparator sort", count, [&]() {
+			expr->children().sort([](ExprNode* lhs, ExprNode* rhs) { return monomialOrderCmp(lhs, rhs) > 0; });
+		});
+
+		bench.run(label + ", reorderPolynomial (keys)", count, [&]() { reorderPolynomial(expr); });
+		freeExpression(expr);
+	}
+
+	std::cout << bench.result() << std::endl;
+	return 0;
+}
@@ -0,0 +1,75 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../lib/mathsolver.h"
+#include "../lib/test/bench-common.h"
+
+using namespace MathSolver;
+
+// Returns a polynomial of the given degree with coefficients uniform in [-range, range].
+DensePoly randomPoly(std::mt19937& rng, size_t degree, int range)
+{
+	std::uniform_int_distribution<int> dist(-range, range);
+	std::vector<Integer> coeffs(degree + 1);
+	for (auto& c : coeffs)
+		c = Integer(dist(rng));
+	if (coeffs.back().isZero())
+		coeffs.back() = Integer(1);
+	return DensePoly(std::move(coeffs));
+}
+
+// Returns the Chebyshev polynomial T_n, which has n real roots clustered towards -1 and 1.
+DensePoly chebyshev(size_t n)
+{
+	DensePoly x({ Integer(0), Integer(1) });
+	DensePoly prev(Integer(1)), cur = x;
+	for (size_t i = 2; i <= n; ++i)
+	{
+		DensePoly next = DensePoly(Integer(2)) * x * cur - prev;
+		prev = cur;
+		cur = next;
+	}
+
+	return cur;
+}
+
+// Returns (x - 1)(x - 2)...(x - n).
+DensePoly wilkinson(size_t n)
+{
+	DensePoly p(Integer(1));
+	for (size_t i = 1; i <= n; ++i)
+		p *= DensePoly({ Integer(-(int)i), Integer(1) });
+	return p;
+}
+
+void benchRoots(BenchModule& bench, const std::string& name, const DensePoly& p)
+{
+	std::vector<RootInterval> roots;
+	bench.run(name + ", isolate", 1, [&]() { roots = isolateRealRoots(p); });
+
+	DensePoly sqf = squarefreePart(p);
+	bench.run(name + ", refine to 53 bits", 1, [&]() {
+		for (const auto& r : roots)
+			refineRoot(sqf, r, 53);
+	});
+
+	Range range;
+	bench.run(name + ", p(x) > 0", 1, [&]() { range = polynomialRange(p, ">"); });
+	bench.note(name + ", real roots / intervals of p(x) > 0", std::to_string(roots.size()) + " / " + std::to_string(range.data().size()));
+}
+
+int main(int argc, char** argv)
+{
+	std::mt19937 rng(0);
+	BenchModule bench("Real root isolation");
+
+	benchRoots(bench, "random, degree 50", randomPoly(rng, 50, 1000));
+	benchRoots(bench, "Chebyshev, degree 50", chebyshev(50));
+	benchRoots(bench, "Wilkinson, degree 50", wilkinson(50));
+	benchRoots(bench, "random, degree 500", randomPoly(rng, 500, 1000));
+	benchRoots(bench, "Chebyshev, degree 200", chebyshev(200));
+
+	std::cout << bench.result() << std::endl;
+	return 0;
+}
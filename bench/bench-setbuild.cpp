@@ -0,0 +1,78 @@
+#include <iostream>
+#include <string>
+#include "../lib/mathsolver.h"
+#include "../lib/test/bench-common.h"
+
+using namespace MathSolver;
+
+ExprNode* parse(const std::string& str)
+{
+	gErrorManager.clear();  // the parser refuses input while errors are pending
+	ExprNode* expr = parseString(str);
+	flattenExpr(expr);
+	return expr;
+}
+
+int main(int argc, char** argv)
+{
+	const std::string preds[] =
+	{
+		"sin(x) > x^2 - 1",
+		"cos(3*x) * exp(x/10) > 1/2",
+		"log(x^2 + 1) < sin(x) + 1"
+	};
+
+	interval_t domain = { -50.0, 50.0, false, false };
+	BisectionOptions opts;
+	opts.tolerance = 1e-9;
+	opts.threads = 1;
+
+	{
+		BenchModule bench("Set builder on (-50, 50), tolerance 1e-9: tree walk vs. compiled predicate");
+		for (const auto& pred : preds)
+		{
+			ExprNode* expr = parse(pred);
+			BisectionResult res;
+			bench.run(pred + ", tree walk", 1, [&]() { res = solveInequality(expr, domain, opts); });
+			bench.note(pred + ", tree walk, intervals", std::to_string(res.range.data().size()));
+			freeExpression(expr);
+
+			ExprNode* set = parse("{x | -50<x<50 and " + pred + "}");
+			bench.run(pred + ", compiled", 1, [&]() { set = evaluateSetBuilder(set, opts); });
+			bench.note(pred + ", compiled, intervals", (set->type() == ExprNode::RANGE) ?
+				std::to_string(((RangeNode*)set)->value().data().size()) : "not evaluated");
+			freeExpression(set);
+		}
+
+		std::cout << bench.result() << std::endl;
+	}
+
+	{
+		// Each set builder is bisected over its whole bound separately, or only where the
+		// other can still hold when compiled together
+		const std::string lhs = "{x | -50<x<50 and sin(x) > x^2 - 1}";
+		const std::string rhs = "{x | 0<x<10 and cos(3*x) * exp(x/10) > 1/2}";
+
+		BenchModule bench("Conjunction of set builders, tolerance 1e-9");
+		ExprNode* a = parse(lhs);
+		ExprNode* b = parse(rhs);
+		bench.run("separately", 1, [&]() {
+			a = evaluateSetBuilder(a, opts);
+			b = evaluateSetBuilder(b, opts);
+		});
+
+		if (a->type() == ExprNode::RANGE && b->type() == ExprNode::RANGE)
+			bench.note("separately, result", ((RangeNode*)a)->value().conjoin(((RangeNode*)b)->value()).toString());
+		freeExpression(a);
+		freeExpression(b);
+
+		ExprNode* both = parse(lhs + " and " + rhs);
+		bench.run("together", 1, [&]() { both = evaluateSetBuilder(both, opts); });
+		bench.note("together, result", toInfixString(both));
+		freeExpression(both);
+
+		std::cout << bench.result() << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,45 @@
+#include <iostream>
+#include <string>
+#include "../lib/mathsolver.h"
+#include "../lib/test/bench-common.h"
+
+using namespace MathSolver;
+
+// Returns the conjunction of 'count' cubic inequalities in x followed by 'last'.
+ExprNode* cubicConjunction(size_t count, const std::string& last)
+{
+	std::string str;
+	for (size_t i = 0; i < count; ++i)
+		str += "x^3-" + std::to_string(i + 2) + "*x+1>0 and ";
+	str += last;
+
+	gErrorManager.clear();  // the parser refuses input while errors are pending
+	ExprNode* expr = parseString(str);
+	flattenExpr(expr);
+	return expr;
+}
+
+int main(int argc, char** argv)
+{
+	size_t count = 200;
+	BenchModule bench("Conjunction of " + std::to_string(count) + " cubic inequalities");
+
+	for (const std::string last : { "1>2", "y>0" })
+	{
+		ExprNode* expr = cubicConjunction(count, last);
+		bench.run("last term " + last + ", every child first", 1, [&]() {
+			expr = evaluateExprLayer(expr, rewriteInequality, 0);
+			expr = evaluateExprLayer(expr, evaluateInequality, 0);
+		});
+		freeExpression(expr);
+
+		ShortCircuitStats stats;
+		expr = cubicConjunction(count, last);
+		bench.run("last term " + last + ", short circuit", 1, [&]() { expr = evaluateExpr(expr, &stats); });
+		bench.note("last term " + last + ", evaluated / skipped", std::to_string(stats.evaluated) + " / " + std::to_string(stats.skipped));
+		freeExpression(expr);
+	}
+
+	std::cout << bench.result() << std::endl;
+	return 0;
+}
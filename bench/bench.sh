@@ -0,0 +1,15 @@
+#!/bin/bash
+failed=0
+for file in $@
+do
+    echo "Benchmark:" $file
+    eval $file
+    if (( $? != 0 )); then
+        echo "Benchmark failed."
+        ((failed++))
+    fi
+done
+
+if (($failed != 0)); then
+    exit 1
+fi
@@ -0,0 +1,91 @@
+#include "../math/ball-math.h"
+#include "../math/float-math.h"
+#include "../math/integer-math.h"
+#include "adaptive.h"
+
+namespace MathSolver
+{
+
+// Returns the exact ball around an Integer.
+static Ball integerBall(const Integer& x, mpfr_prec_t prec)
+{
+    if (x.isUndef() || x.isInf())
+        return Ball::undef(prec);
+    return Ball(integerToFloat(x, 0), prec);
+}
+
+Ball evaluateBall(ExprNode* expr, mpfr_prec_t prec)
+{
+    if (expr->type() == ExprNode::INTEGER)      return integerBall(((IntNode*)expr)->value(), prec);
+    if (expr->type() == ExprNode::RATIONAL)     return Ball(rationalToFloat(((RationalNode*)expr)->value(), prec), prec, false);
+    if (expr->type() == ExprNode::FLOAT)        return Ball(((FloatNode*)expr)->value(), prec);
+    if (expr->type() == ExprNode::CONSTANT)     return constantBall(((ConstNode*)expr)->name(), prec);
+
+    if (expr->isOperator())
+    {
+        const std::string& name = ((OpNode*)expr)->name();
+        auto it = expr->children().begin();
+        if (name == "-*")   return -evaluateBall(*it, prec);
+        if (name == "!")
+        {
+            Ball n = evaluateBall(*it, prec);
+            if (!n.isExact() || !mpfr_integer_p(n.mid().data()) || n.mid().sign() ||
+                mpfr_cmp_si(n.mid().data(), MATHSOLVER_FACTORIAL_MAX) > 0)
+                return Ball::undef(prec);
+            return integerBall(fact((int)mpfr_get_si(n.mid().data(), MPFR_RNDN)), prec);
+        }
+
+        Ball acc = evaluateBall(*it, prec);
+        for (++it; it != expr->children().end(); ++it)
+        {
+            Ball x = evaluateBall(*it, prec);
+            if (name == "+")                        acc = acc + x;
+            else if (name == "-")                   acc = acc - x;
+            else if (name == "*" || name == "**")   acc = acc * x;
+            else if (name == "/")                   acc = acc / x;
+            else if (name == "^")                   acc = pow(acc, x);
+            else if (name == "%" || name == "mod")  acc = mod(acc, x);
+            else                                    return Ball::undef(prec);
+        }
+
+        return acc;
+    }
+
+    if (expr->type() == ExprNode::FUNCTION && expr->children().size() == 1)
+    {
+        const std::string& name = ((FuncNode*)expr)->name();
+        Ball x = evaluateBall(expr->children().front(), prec);
+        if (name == "exp")          return exp(x);
+        else if (name == "log")     return log(x);
+        else if (name == "sin")     return sin(x);
+        else if (name == "cos")     return cos(x);
+        else if (name == "tan")     return tan(x);
+    }
+
+    return Ball::undef(prec);
+}
+
+AdaptiveResult evaluateAdaptive(ExprNode* expr, size_t digits)
+{
+    // Ziv's strategy: retry at twice the precision until the enclosure is narrow enough
+    AdaptiveResult res = { Ball(), "", MATHSOLVER_ADAPTIVE_START_PREC, false };
+    for (mpfr_prec_t prec = MATHSOLVER_ADAPTIVE_START_PREC; prec <= MATHSOLVER_ADAPTIVE_MAX_PREC; prec *= 2)
+    {
+        res.value = evaluateBall(expr, prec);
+        res.precision = prec;
+        if (res.value.isUndef())    // no precision helps, ex: 1/0 or an unsupported function
+            return res;
+
+        if (res.value.roundsTo(digits, res.digits))
+        {
+            res.certified = true;
+            return res;
+        }
+    }
+
+    gErrorManager.log("Could not certify " + std::to_string(digits) + " digits of " + toInfixString(expr) +
+                      " at " + std::to_string(MATHSOLVER_ADAPTIVE_MAX_PREC) + " bits", ErrorManager::MESSAGE);
+    return res;
+}
+
+}
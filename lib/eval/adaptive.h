@@ -0,0 +1,42 @@
+#ifndef _MATHSOLVER_ADAPTIVE_H_
+#define _MATHSOLVER_ADAPTIVE_H_
+
+#include <string>
+#include "../common/base.h"
+#include "../expr/expr.h"
+#include "../types/ball.h"
+
+// First working precision in bits. Each failed attempt doubles it.
+#define MATHSOLVER_ADAPTIVE_START_PREC      64
+
+// Largest working precision in bits before the result is returned uncertified
+#define MATHSOLVER_ADAPTIVE_MAX_PREC        16384
+
+// Significant digits printed by Float::toString()
+#define MATHSOLVER_ADAPTIVE_DIGITS          16
+
+namespace MathSolver
+{
+
+// Result of an adaptive-precision evaluation.
+struct AdaptiveResult
+{
+    Ball value;                 // enclosure of the exact value
+    std::string digits;         // value rounded to the requested digits, if certified
+    mpfr_prec_t precision;      // working precision of the last evaluation
+    bool certified;             // true if every point of the enclosure rounds to 'digits'
+};
+
+// Evaluates a numerical arithmetic expression (see isArithmeticNode, no variables) in ball arithmetic
+// at the given working precision. Unsupported nodes give Ball::undef().
+Ball evaluateBall(ExprNode* expr, mpfr_prec_t prec);
+
+// Evaluates a numerical arithmetic expression in ball arithmetic, starting at a low working precision
+// and doubling it until the result is certified to the given number of significant digits or
+// MATHSOLVER_ADAPTIVE_MAX_PREC is reached. Returns uncertified at once if the result is undefined
+// (see Ball::undef). The expression is not modified.
+AdaptiveResult evaluateAdaptive(ExprNode* expr, size_t digits = MATHSOLVER_ADAPTIVE_DIGITS);
+
+}
+
+#endif
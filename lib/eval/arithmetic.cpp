@@ -13,6 +13,17 @@ namespace MathSolver
 //  Numerical arithmetic evaluators
 //
 
+ExprNode* numericConstant(ExprNode* op)
+{
+    const Float* val = constantValue(((ConstNode*)op)->name());
+    if (val == nullptr)
+        return op;
+
+    ExprNode* res = new FloatNode(*val, op->parent());
+    delete op;
+    return res;
+}
+
 ExprNode* numericExp(ExprNode* op)
 {
     if (op->children().size() != 1)     
@@ -21,8 +32,7 @@ ExprNode* numericExp(ExprNode* op)
         return op;
     }
 
-    Float v = exp((op->children().front()->type() == ExprNode::FLOAT) ? ((FloatNode*)op->children().front())->value() : 
-                                                                        Float(((IntNode*)op->children().front())->value().toString()));
+    Float v = exp(toFloat(op->children().front()));
     ExprNode* res = new FloatNode(v, op->parent());
     freeExpression(op);
     return res;
@@ -43,13 +53,22 @@ ExprNode* numericLog(ExprNode* op)
     }
 
     // TODO log(x, n)
-    Float v = log((op->children().front()->type() == ExprNode::FLOAT) ? ((FloatNode*)op->children().front())->value() : 
-                                                                        Float(((IntNode*)op->children().front())->value().toString()));
+    Float v = log(toFloat(op->children().front()));
     ExprNode* res = new FloatNode(v, op->parent());
     freeExpression(op);
     return res;
 }
 
+// Returns the value of a trigonometric function at x, or zero if the value is within the rounding
+// error of x, e.g. sin(pi) where pi is only known to the working precision.
+static Float snapTrig(const Float& v, const Float& x)
+{
+    if (mpfr_regular_p(v.data()) && mpfr_regular_p(x.data()) &&
+        mpfr_get_exp(v.data()) <= mpfr_get_exp(x.data()) - x.precision() + 2)
+        return Float("0");
+    return v;
+}
+
 ExprNode* numericSin(ExprNode* op)
 {
     if (op->children().size() != 1)     
@@ -58,8 +77,8 @@ ExprNode* numericSin(ExprNode* op)
         return op;
     }
 
-    Float v = sin((op->children().front()->type() == ExprNode::FLOAT) ? ((FloatNode*)op->children().front())->value() : 
-                                                                        Float(((IntNode*)op->children().front())->value().toString()));
+    Float x = toFloat(op->children().front());
+    Float v = snapTrig(sin(x), x);
     ExprNode* res = new FloatNode(v, op->parent());
     freeExpression(op);
     return res;
@@ -73,8 +92,8 @@ ExprNode* numericCos(ExprNode* op)
         return op;
     }
 
-    Float v = cos((op->children().front()->type() == ExprNode::FLOAT) ? ((FloatNode*)op->children().front())->value() : 
-                                                                        Float(((IntNode*)op->children().front())->value().toString()));
+    Float x = toFloat(op->children().front());
+    Float v = snapTrig(cos(x), x);
     ExprNode* res = new FloatNode(v, op->parent());
     freeExpression(op);
     return res;
@@ -88,8 +107,8 @@ ExprNode* numericTan(ExprNode* op)
         return op;
     }
 
-    Float v = tan((op->children().front()->type() == ExprNode::FLOAT) ? ((FloatNode*)op->children().front())->value() : 
-                                                                        Float(((IntNode*)op->children().front())->value().toString()));
+    Float x = toFloat(op->children().front());
+    Float v = snapTrig(tan(x), x);
     ExprNode* res = new FloatNode(v, op->parent());
     freeExpression(op);
     return res;
@@ -106,86 +125,61 @@ ExprNode* numericNeg(ExprNode* op)
 
     if (op->children().front()->type() == ExprNode::INTEGER)
         ((IntNode*)op->children().front())->setValue(-((IntNode*)op->children().front())->value());
+    else if (op->children().front()->type() == ExprNode::RATIONAL)
+        ((RationalNode*)op->children().front())->setValue(-((RationalNode*)op->children().front())->value());
     else
         ((FloatNode*)op->children().front())->setValue(-((FloatNode*)op->children().front())->value());
 
     return moveNode(op, op->children().front());
 }
 
-// Evaluates "(+ <num>...)"
-ExprNode* numericAdd(ExprNode* op)
+// Sums Rationals pairwise in a balanced tree so that the denominators of the partial sums stay small.
+// The operands are overwritten.
+Rational sumRationals(std::vector<Rational>& xs)
 {
-    ExprNode* res;
-    if (std::any_of(op->children().begin(), op->children().end(), [](ExprNode* x) { return x->type() == ExprNode::FLOAT; }))
+    if (xs.empty())
+        return Rational();
+
+    for (size_t step = 1; step < xs.size(); step *= 2)
     {
-        for (auto it = op->children().begin(); it != op->children().end(); ++it)
-        {
-            if ((*it)->type() == ExprNode::INTEGER)
-                it = replaceChild(op, new FloatNode(((IntNode*)*it)->value().toString()), it, true); // TODO: naive conversion
-        }
+        for (size_t i = 0; i + step < xs.size(); i += 2 * step)
+            xs[i] += xs[i + step];
+    }
 
-        auto it = op->children().begin();
-        while (it != op->children().end())
-        {
-            auto it2 = std::next(it);
-            bool match = false;
-            while (it2 != op->children().end())
-            {
-                if (((FloatNode*)*it)->value() == -((FloatNode*)*it2)->value())
-                {
-                    delete *it;
-                    delete *it2;
-                    op->children().erase(it2);
-                    it = op->children().erase(it);
-                    match = true;
-                    break;
-                }
-                else
-                {
-                    ++it2;
-                }
-            }
+    return xs.front();
+}
 
-            if (!match) ++it;
-        }
+// Evaluates "(+ <num>...)"
+ExprNode* numericAdd(ExprNode* op)
+{
+    // Integers and rationals are summed exactly. Any floats are then added to that sum with a single mpfr_sum,
+    // so the result does not depend on the order of the operands. An integer sum enters the mpfr_sum exactly,
+    // but a rational sum is rounded to a Float first, and cancellation against the floats can magnify that error.
+    Integer isum;
+    std::vector<Rational> rats;
+    std::vector<mpfr_ptr> floats;
+    for (auto e : op->children())
+    {
+        if (e->type() == ExprNode::INTEGER)         isum += ((IntNode*)e)->value();
+        else if (e->type() == ExprNode::RATIONAL)   rats.push_back(((RationalNode*)e)->value());
+        else                                        floats.push_back(((FloatNode*)e)->value().data());
+    }
 
-        res = new FloatNode();
-        for (auto e : op->children())
-            ((FloatNode*)res)->value() += ((FloatNode*)e)->value();
+    ExprNode* res;
+    if (floats.empty())
+    {
+        if (rats.empty())   res = new IntNode(isum, op->parent());
+        else                res = rationalNode(sumRationals(rats) + isum, op->parent());
     }
     else
     {
-        auto it = op->children().begin();
-        while (it != op->children().end())
-        {
-            auto it2 = std::next(it);
-            bool match = false;
-            while (it2 != op->children().end())
-            {
-                if (((IntNode*)*it)->value() == -((IntNode*)*it2)->value())
-                {
-                    delete *it;
-                    delete *it2;
-                    op->children().erase(it2);
-                    it = op->children().erase(it);
-                    match = true;
-                    break;
-                }
-                else
-                {
-                    ++it2;
-                }
-            }
-
-            if (!match) ++it;
-        }
-
-        res = new IntNode();
-        for (auto e : op->children())
-            ((IntNode*)res)->value() += ((IntNode*)e)->value();
+        Float exact = (rats.empty() ? integerToFloat(isum, 0) : rationalToFloat(sumRationals(rats) + isum));
+        Float sum;
+        floats.push_back(exact.data());
+        mpfr_sum(sum.data(), floats.data(), floats.size(), MATHSOLVER_FLOAT_DEFAULT_RND_MODE);
+        res = new FloatNode(std::move(sum), op->parent());
     }
-    
-    res->setParent(op->parent());
+
     freeExpression(op);
     return res;
 }
@@ -209,26 +203,61 @@ ExprNode* numericSub(ExprNode* op)
 // Evaluates "(* <num>...)" or "(** <num>...)"
 ExprNode* numericMul(ExprNode* op)
 {
-    ExprNode* res;
-    if (std::any_of(op->children().begin(), op->children().end(), [](ExprNode* x) { return x->type() == ExprNode::FLOAT; }))
+    // Operands are multiplied pairwise in a balanced tree, integers exactly and floats with rounding.
+    // Rationals contribute their numerator and denominator to separate integer products, which are
+    // reduced once at the end. The float operands are overwritten in place since the operator is
+    // freed afterwards.
+    std::vector<Integer> ints;
+    std::vector<Integer> dens;
+    std::vector<Float*> floats;
+    for (auto e : op->children())
     {
-        Float first = ((op->children().front()->type() == ExprNode::FLOAT) ? ((FloatNode*)op->children().front())->value() : 
-                                                                             Float(((IntNode*)op->children().front())->value().toString()));
-       res = new FloatNode(first, op->parent());
-        for (auto e = std::next(op->children().begin()); e != op->children().end(); ++e)
+        if (e->type() == ExprNode::INTEGER)
+        {
+            ints.push_back(((IntNode*)e)->value());
+        }
+        else if (e->type() == ExprNode::RATIONAL)
         {
-            if ((*e)->type() == ExprNode::FLOAT) ((FloatNode*)res)->value() *= ((FloatNode*)*e)->value();
-            else                                 ((FloatNode*)res)->value() *= Float(((IntNode*)*e)->value().toString()); // TODO: this conversion is naive
+            ints.push_back(((RationalNode*)e)->value().numerator());
+            dens.push_back(((RationalNode*)e)->value().denominator());
         }
+        else
+        {
+            floats.push_back(&((FloatNode*)e)->value());
+        }
+    }
+
+    Integer iprod;
+    if (std::all_of(ints.begin(), ints.end(), [](const Integer& x) { return !x.isUndef() && !x.isInf(); }))
+    {
+        iprod = product(ints.data(), ints.size());
     }
     else
     {
-        res = new IntNode(((IntNode*)op->children().front())->value(), op->parent());
-        for (auto e = std::next(op->children().begin()); e != op->children().end(); ++e)
-            ((IntNode*)res)->value() *= ((IntNode*)*e)->value();
+        iprod = Integer(1);
+        for (const auto& x : ints)
+            iprod *= x;
+    }
+
+    Rational rprod(iprod, product(dens.data(), dens.size()));
+    ExprNode* res;
+    if (floats.empty())
+    {
+        res = (dens.empty() ? new IntNode(iprod, op->parent()) : rationalNode(rprod, op->parent()));
+    }
+    else
+    {
+        Float fprod = (dens.empty() ? integerToFloat(iprod) : rationalToFloat(rprod));
+        floats.push_back(&fprod);
+        for (size_t step = 1; step < floats.size(); step *= 2)
+        {
+            for (size_t i = 0; i + step < floats.size(); i += 2 * step)
+                *floats[i] *= *floats[i + step];
+        }
+
+        res = new FloatNode(std::move(*floats.front()), op->parent());
     }
 
-    res->setParent(op->parent());
     freeExpression(op);
     return res;
 }
@@ -253,31 +282,20 @@ ExprNode* numericDiv(ExprNode* op)
         return ret;
     }
 
-    if (lhs->type() == ExprNode::INTEGER && rhs->type() == ExprNode::INTEGER) // <exact> / <exact>
+    ExprNode* res;
+    if (lhs->type() != ExprNode::FLOAT && rhs->type() != ExprNode::FLOAT) // <exact> / <exact>
     {   
-        Integer factor = gcd(((IntNode*)lhs)->value(), ((IntNode*)rhs)->value());
-        if (factor > Integer(1))
-        {
-            ((IntNode*)lhs)->value() /= factor;
-            ((IntNode*)rhs)->value() /= factor;
-        }
-
-        if (((IntNode*)rhs)->value() == Integer(1))
-        {
-            delete rhs;
-            return moveNode(op, lhs);
-        }
-
-        return op; // no exact numerical division: a/b --> a/b
+        res = rationalNode(toRational(lhs) / toRational(rhs), op->parent());
     }
     else
     {
-        Float n = ((lhs->type() == ExprNode::FLOAT) ? ((FloatNode*)lhs)->value() : Float(((IntNode*)lhs)->value().toString()));
-        Float d = ((rhs->type() == ExprNode::FLOAT) ? ((FloatNode*)rhs)->value() : Float(((IntNode*)rhs)->value().toString()));
-        ExprNode* res = new FloatNode(n / d, op->parent());
-        freeExpression(op);
-        return res;
+        Float n = toFloat(lhs);
+        Float d = toFloat(rhs);
+        res = new FloatNode(n / d, op->parent());
     }
+
+    freeExpression(op);
+    return res;
 }
 
 // Evaluates (% <num> <num>)
@@ -298,8 +316,8 @@ ExprNode* numericMod(ExprNode* op)
     }
     else
     {
-        Float n = ((lhs->type() == ExprNode::FLOAT) ? ((FloatNode*)lhs)->value() : Float(((IntNode*)lhs)->value().toString()));
-        Float d = ((rhs->type() == ExprNode::FLOAT) ? ((FloatNode*)rhs)->value() : Float(((IntNode*)rhs)->value().toString()));
+        Float n = toFloat(lhs);
+        Float d = toFloat(rhs);
         res = new FloatNode(mod(n, d), op->parent());
     }
     
@@ -318,14 +336,13 @@ ExprNode* numericPow(ExprNode* op)
 
     ExprNode* lhs = op->children().front();
     ExprNode* rhs = op->children().back();
-    if (lhs->type() == ExprNode::INTEGER && rhs->type() == ExprNode::INTEGER)
+    if (lhs->type() != ExprNode::FLOAT && rhs->type() == ExprNode::INTEGER)
     {
-        if (((IntNode*)rhs)->value().sign())  // (^ x -n)
+        if (lhs->type() == ExprNode::RATIONAL || ((IntNode*)rhs)->value().sign())  // (^ a/b n) or (^ x -n)
         {
-            ((OpNode*)op)->setName("/");
-            ((IntNode*)rhs)->setValue(pow(((IntNode*)lhs)->value(), -((IntNode*)rhs)->value()));
-            ((IntNode*)lhs)->setValue(Integer(1));
-            return op;                                 
+            ExprNode* res = rationalNode(pow(toRational(lhs), ((IntNode*)rhs)->value()), op->parent());
+            freeExpression(op);
+            return res;                               
         }
         else
         {
@@ -336,8 +353,8 @@ ExprNode* numericPow(ExprNode* op)
     }
     else
     {
-        Float x = ((lhs->type() == ExprNode::FLOAT) ? ((FloatNode*)lhs)->value() : Float(((IntNode*)lhs)->value().toString()));
-        Float y = ((rhs->type() == ExprNode::FLOAT) ? ((FloatNode*)rhs)->value() : Float(((IntNode*)rhs)->value().toString()));
+        Float x = toFloat(lhs);
+        Float y = toFloat(rhs);
         ExprNode* res = new FloatNode(pow(x, y), op->parent());
         freeExpression(op);
         return res;
@@ -353,7 +370,7 @@ ExprNode* numericFact(ExprNode* op)
         return op;
     }
 
-    if (op->children().front()->type() == ExprNode::FLOAT)
+    if (op->children().front()->type() != ExprNode::INTEGER)
     {
         gErrorManager.log("Factorial is defined for integers only. Try the gamma function.", ErrorManager::ERROR, __FILE__, __LINE__);
         return op;
@@ -443,6 +460,10 @@ ExprNode* symbolicTan(ExprNode* op)
 // Shared evaluator for symbolic + and -
 ExprNode* symbolicAddSub(ExprNode* op, const char* str)
 {
+    ExprNode* collected = collectPolynomial(op); // univariate integer polynomials: collect with a coefficient vector
+    if (collected != op)
+        return collected;
+
     auto i = op->children().begin();
     while (std::next(i) != op->children().end())
     {       
@@ -637,6 +658,10 @@ ExprNode* symbolicMul(ExprNode* op)
         return op;
     }
 
+    ExprNode* product = multiplyPolynomial(op); // univariate integer polynomials: multiply coefficient vectors
+    if (product != op)
+        return product;
+
     // reorder monomial
     if (isMonomial(op))    op = reorderMonomial(op);
 
@@ -685,8 +710,8 @@ ExprNode* symbolicMul(ExprNode* op)
             delete *it;
             it = op->children().erase(it);
         }
-        else if (((*it)->type() == ExprNode::INTEGER && ((IntNode*)*it)->value() == Integer(-1)) || // (* -1 a ...) ==> (-* (* a ...))
-                 ((*it)->type() == ExprNode::FLOAT && ((FloatNode*)*it)->value() == Float("-1.0")))
+        else if (((*it)->type() == ExprNode::INTEGER && ((IntNode*)*it)->value().isMinusOne()) || // (* -1 a ...) ==> (-* (* a ...))
+                 ((*it)->type() == ExprNode::FLOAT && ((FloatNode*)*it)->value().isMinusOne()))
         {
             if (op->children().size() == 2) // specific: (* -1 a) ==> (-* a)
             {
@@ -791,6 +816,48 @@ ExprNode* symbolicMul(ExprNode* op)
         }
     }
 
+    // (* a x (* b y)) with a Rational among the numbers a, b ==> (** c x y) with c = a*b, so exact
+    // fractions stay one leading coefficient and print one way, ex: (1/6)x
+    auto isRat = [](ExprNode* node) { return node->type() == ExprNode::RATIONAL; };
+    auto isProd = [](ExprNode* node) { return node->isOperator() &&
+        (((OpNode*)node)->name() == "*" || ((OpNode*)node)->name() == "**"); };
+    auto hasRat = [&](ExprNode* node) { return isRat(node) ||
+        (isProd(node) && std::any_of(node->children().begin(), node->children().end(), isRat)); };
+    if (op->children().size() > 1 && std::any_of(op->children().begin(), op->children().end(), hasRat))
+    {
+        ExprNode* coeff = new OpNode("*");
+        for (auto it = op->children().begin(); it != op->children().end(); )
+        {
+            if (isProd(*it))   // splice, then revisit the spliced factors
+            {
+                for (ExprNode* child : (*it)->children())
+                    child->setParent(op);
+                auto first = op->children().insert(it, (*it)->children().begin(), (*it)->children().end());
+                delete *it;
+                op->children().erase(it);
+                it = first;
+            }
+            else if ((*it)->isNumber())
+            {
+                coeff->children().push_back(*it);
+                (*it)->setParent(coeff);
+                it = op->children().erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        bool folded = (coeff->children().size() > 1);
+        ExprNode* num = (folded ? numericMul(coeff) : moveNode(coeff, coeff->children().front()));
+        num->setParent(op);
+        op->children().push_front(num);
+        ((OpNode*)op)->setName("**");
+        if (folded)
+            return symbolicMul(op);     // (* 1 x), (* 0 x), (* -1 x)
+    }
+
     if (op->children().size() == 1) // correct: (* x) => x
         return moveNode(op, op->children().front());
     return op;
@@ -1082,7 +1149,7 @@ ExprNode* symbolicDiv(OpNode* op)
         freeExpression(den);
         return moveNode(op, new IntNode(Integer(1)));
     } 
-    else if (op->children().back()->type() == ExprNode::INTEGER && ((IntNode*)op->children().back())->value() == Integer(1)) // (/ x 1) ==> x
+    else if (op->children().back()->type() == ExprNode::INTEGER && ((IntNode*)op->children().back())->value().isOne()) // (/ x 1) ==> x
     {
         delete op->children().back();
         op->children().clear();
@@ -1113,7 +1180,7 @@ ExprNode* symbolicMod(ExprNode* op)
     else if (op->children().front()->isOperator() && ((OpNode*)op->children().front())->name() == "^" && // (% (^ n x) n) ==> 0, where x ∈ N
              eqvExpr(op->children().front()->children().front(), op->children().back()) &&
              op->children().front()->children().back()->type() == ExprNode::INTEGER && 
-             ((IntNode*)op->children().front()->children().back())->value() > Integer(0))
+             ((IntNode*)op->children().front()->children().back())->value().compare(0) > 0)
     {
         ExprNode* res = new IntNode(0, op->parent());
         freeExpression(op);
@@ -1192,10 +1259,26 @@ ExprNode* symbolicPow(ExprNode* op)
 // Arithmetic evaluator
 //
 
+// Returns true if the expression containing the node has no variables. Ancestors may be detached from
+// their parents during evaluation, so the siblings along the path to the root are searched instead.
+bool inNumericalExpr(ExprNode* node)
+{
+    for (ExprNode* it = node; it->parent() != nullptr; it = it->parent())
+    {
+        for (auto e : it->parent()->children())
+        {
+            if (e != it && containsType(e, ExprNode::VARIABLE))
+                return false;
+        }
+    }
+
+    return true;
+}
+
 ExprNode* evaluateArithmetic(ExprNode* expr, bool firstPass)
 {
     if (expr->isNumber())                         return expr;
-    if (expr->type() == ExprNode::CONSTANT)       return expr;    // TODO: constant table
+    if (expr->type() == ExprNode::CONSTANT)       return (!firstPass && inNumericalExpr(expr)) ? numericConstant(expr) : expr;
     if (expr->type() == ExprNode::VARIABLE)       return expr;
     
     if (expr->type() == ExprNode::OPERATOR)
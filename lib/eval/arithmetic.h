@@ -11,6 +11,9 @@ namespace MathSolver
 // Numeric evaluators
 //
 
+// Replaces a named constant with its value.
+ExprNode* numericConstant(ExprNode* op);
+
 ExprNode* numericExp(ExprNode* op);
 ExprNode* numericLog(ExprNode* op);
 ExprNode* numericSin(ExprNode* op);
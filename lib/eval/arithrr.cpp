@@ -78,6 +78,7 @@ ExprNode* rewriteAddSub(ExprNode* op)
         {
             ((OpNode*)*it2)->setName("-");
             (*it2)->children().push_front(*it);
+            (*it)->setParent(*it2);
             it = op->children().erase(it);
             continue;
         }
@@ -0,0 +1,241 @@
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../expr/arithmetic.h"
+#include "../types/interval.h"
+#include "bisection.h"
+#include "enclosure.h"
+#include "inequality.h"
+
+namespace MathSolver
+{
+
+// Part of the domain waiting to be classified
+struct Box
+{
+    Float lower;
+    Float upper;
+};
+
+// Compares an enclosure of (lhs - rhs) against zero.
+static Verdict compareSign(const Interval& diff, const std::string& op)
+{
+    if (diff.isUndef())
+        return UNDECIDED;
+
+    int lo = mpfr_sgn(diff.lower().data());
+    int hi = mpfr_sgn(diff.upper().data());
+    if (op == ">")      return (lo > 0) ? SATISFIED : ((hi <= 0) ? VIOLATED : UNDECIDED);
+    if (op == ">=")     return (lo >= 0) ? SATISFIED : ((hi < 0) ? VIOLATED : UNDECIDED);
+    if (op == "<")      return (hi < 0) ? SATISFIED : ((lo >= 0) ? VIOLATED : UNDECIDED);
+    if (op == "<=")     return (hi <= 0) ? SATISFIED : ((lo > 0) ? VIOLATED : UNDECIDED);
+    if (op == "!=")     return (lo > 0 || hi < 0) ? SATISFIED : ((lo == 0 && hi == 0) ? VIOLATED : UNDECIDED);
+    return UNDECIDED;
+}
+
+// Classifies an inequality, or a chain (op a b c ...), over a box. Sets 'defined' to false if
+// any side could not be evaluated.
+static Verdict classify(ExprNode* expr, const IntervalBox& box, mpfr_prec_t prec, bool& defined)
+{
+    const std::string& op = ((OpNode*)expr)->name();
+    auto it = expr->children().begin();
+    Interval lhs = evaluateInterval(*it, box, prec);
+    Verdict res = SATISFIED;
+    defined = !lhs.isUndef();
+    for (++it; it != expr->children().end(); ++it)
+    {
+        Interval rhs = evaluateInterval(*it, box, prec);
+        Verdict v = compareSign(lhs - rhs, op);
+        defined &= !rhs.isUndef();
+        if (v == VIOLATED)  return VIOLATED;
+        if (v == UNDECIDED) res = UNDECIDED;
+        lhs = rhs;
+    }
+
+    return res;
+}
+
+BisectionResult bisectDomain(const interval_t& domain, const BoxClassifier& classify, bool inclusive, const BisectionOptions& opts)
+{
+    auto start = std::chrono::steady_clock::now();
+    BisectionResult res{ Range(), Range(), 0, 0.0, false };
+    if (domain.lower.isInf() || domain.upper.isInf() || domain.lower.isNaN() || domain.upper.isNaN())
+    {
+        gErrorManager.log("Expected a bounded domain: " + toString(domain), ErrorManager::ERROR, __FILE__, __LINE__);
+        return res;
+    }
+
+    mpfr_prec_t prec = opts.precision;
+    auto deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                std::chrono::duration<double>(opts.maxSeconds));
+
+    std::mutex lock;
+    std::condition_variable wake;
+    std::vector<Box> pending = { { domain.lower.toFloat(), domain.upper.toFloat() } };
+    std::vector<interval_t> inside, undecided;
+    size_t active = 0;
+    bool exhausted = false;
+
+    auto worker = [&]() {
+        std::unique_lock<std::mutex> guard(lock);
+        while (true)
+        {
+            wake.wait(guard, [&]() { return !pending.empty() || active == 0; });
+            if (pending.empty())    // every box classified
+                break;
+
+            Box b = std::move(pending.back());
+            pending.pop_back();
+            if (res.boxes >= opts.maxBoxes || std::chrono::steady_clock::now() > deadline)
+            {
+                exhausted = true;
+                undecided.push_back({ b.lower, b.upper, true, true });
+                continue;
+            }
+
+            ++res.boxes;
+            ++active;
+            guard.unlock();
+
+            bool defined;
+            Verdict v = classify(Interval(b.lower, b.upper, prec), defined);
+
+            Float mid, width;
+            bool split = false, leaf = false;
+            if (v == UNDECIDED)
+            {
+                mpfr_set_prec(mid.data(), prec);
+                mpfr_add(mid.data(), b.lower.data(), b.upper.data(), MPFR_RNDN);
+                mpfr_div_2ui(mid.data(), mid.data(), 1, MPFR_RNDN);
+                mpfr_sub(width.data(), b.upper.data(), b.lower.data(), MPFR_RNDU);
+
+                v = classify(Interval(mid, prec), defined);
+                bool midDefined = defined;
+                if (mpfr_get_d(width.data(), MPFR_RNDU) <= opts.tolerance ||
+                    mpfr_equal_p(mid.data(), b.lower.data()) || mpfr_equal_p(mid.data(), b.upper.data()))
+                {
+                    // Narrow enough: decide by the sign at the midpoint
+                    if (v == UNDECIDED)
+                        v = (midDefined && inclusive) ? SATISFIED : VIOLATED;
+                    leaf = true;
+                }
+                else
+                {
+                    // Undefined at both ends and the midpoint, e.g. log(x) for x < 0
+                    classify(Interval(b.lower, prec), defined);
+                    bool lowerDefined = defined;
+                    classify(Interval(b.upper, prec), defined);
+
+                    if (!midDefined && !lowerDefined && !defined)
+                    {
+                        v = VIOLATED;
+                    }
+                    else
+                    {
+                        v = UNDECIDED;
+                        split = true;
+                    }
+                }
+            }
+
+            // A leaf only stands for its midpoint, so exclude an endpoint that is a root or a pole,
+            // e.g. 0 in x^3 - x != 0 or 1/x > 1. A strict predicate only keeps a satisfied endpoint.
+            bool lowerClosed = true, upperClosed = true;
+            if (leaf && v == SATISFIED)
+            {
+                auto closed = [&](const Float& x) {
+                    bool defined;
+                    Verdict p = classify(Interval(x, prec), defined);
+                    return defined && (p == SATISFIED || (inclusive && p == UNDECIDED));
+                };
+
+                lowerClosed = closed(b.lower);
+                upperClosed = closed(b.upper);
+            }
+
+            guard.lock();
+            --active;
+            if (split)
+            {
+                pending.push_back({ mid, b.upper });
+                pending.push_back({ b.lower, mid });
+            }
+            else if (v == SATISFIED)
+            {
+                inside.push_back({ b.lower, b.upper, lowerClosed, upperClosed });
+            }
+
+            wake.notify_all();
+        }
+
+        wake.notify_all();
+        guard.unlock();
+        mpfr_free_cache2(MPFR_FREE_LOCAL_CACHE);  // constants such as pi cached by this thread
+    };
+
+    size_t threads = opts.threads ? opts.threads : std::max<size_t>(1, std::thread::hardware_concurrency());
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < threads; ++i)
+        workers.emplace_back(worker);
+
+    worker();
+    for (auto& t : workers)
+        t.join();
+
+    // Every endpoint inside the domain is within the tolerance of a boundary, whichever side of it
+    // the endpoint falls on. A strict predicate excludes the boundary and an inclusive one keeps it
+    // where the predicate is defined.
+    Range merged(std::move(inside));
+    auto boundary = [&](const Endpoint& x) {
+        bool defined;
+        classify(Interval(x.toFloat(), prec), defined);
+        return inclusive && defined;
+    };
+
+    for (auto& ival : merged.data())
+    {
+        if (ival.lower != domain.lower)     ival.lowerClosed = boundary(ival.lower);
+        if (ival.upper != domain.upper)     ival.upperClosed = boundary(ival.upper);
+    }
+
+    res.range = Range(std::move(merged.data())).conjoin(Range(domain));   // touching endpoints are merged
+    res.undecided = Range(std::move(undecided));
+    res.complete = !exhausted;
+    res.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return res;
+}
+
+BisectionResult solveInequality(ExprNode* expr, const interval_t& domain, const BisectionOptions& opts)
+{
+    if (!isInequalityNode(expr) || expr->children().size() < 2 ||
+        !std::all_of(expr->children().begin(), expr->children().end(), isArithmetic))
+    {
+        gErrorManager.log("Expected an inequality: " + toInfixString(expr), ErrorManager::ERROR, __FILE__, __LINE__);
+        return BisectionResult{ Range(), Range(), 0, 0.0, false };
+    }
+
+    std::list<std::string> vars = extractVariables(expr);
+    vars.sort();
+    vars.unique();
+    if (vars.size() != 1)
+    {
+        gErrorManager.log("Expected an inequality in one variable: " + toInfixString(expr), ErrorManager::ERROR, __FILE__, __LINE__);
+        return BisectionResult{ Range(), Range(), 0, 0.0, false };
+    }
+
+    const std::string& var = vars.front();
+    const std::string& op = ((OpNode*)expr)->name();
+    mpfr_prec_t prec = opts.precision;
+    auto classifier = [&](const Interval& x, bool& defined) {
+        IntervalBox box;
+        box[var] = x;
+        return classify(expr, box, prec, defined);
+    };
+
+    return bisectDomain(domain, classifier, (op == ">=" || op == "<="), opts);
+}
+
+}
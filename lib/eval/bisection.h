@@ -0,0 +1,74 @@
+#ifndef _MATHSOLVER_BISECTION_H_
+#define _MATHSOLVER_BISECTION_H_
+
+#include <stddef.h>
+#include <functional>
+#include "../common/base.h"
+#include "../expr/expr.h"
+#include "../types/interval.h"
+#include "../types/range.h"
+
+// Width of the domain at which an undecided box is classified by its midpoint
+#define MATHSOLVER_BISECT_TOLERANCE     1e-9
+
+// Largest number of boxes evaluated before giving up
+#define MATHSOLVER_BISECT_MAX_BOXES     (1 << 22)
+
+// Longest time in seconds spent before giving up
+#define MATHSOLVER_BISECT_MAX_SECONDS   10.0
+
+namespace MathSolver
+{
+
+// Tolerance and budget of a branch-and-bound solve.
+struct BisectionOptions
+{
+    double tolerance = MATHSOLVER_BISECT_TOLERANCE;     // boundaries are located to within this width
+    size_t maxBoxes = MATHSOLVER_BISECT_MAX_BOXES;      // step budget
+    double maxSeconds = MATHSOLVER_BISECT_MAX_SECONDS;  // time budget
+    size_t threads = 0;                                 // worker threads, or 0 for one per core
+    mpfr_prec_t precision = MATHSOLVER_FLOAT_DEFAULT_PREC;
+};
+
+// Solution set of a branch-and-bound solve.
+struct BisectionResult
+{
+    Range range;            // points that satisfy the inequality
+    Range undecided;        // boxes left unclassified when the budget ran out
+    size_t boxes;           // number of boxes evaluated
+    double seconds;         // wall time of the solve
+    bool complete;          // true if the solve finished within its budget
+};
+
+// Classification of a predicate over a box
+enum Verdict
+{
+    SATISFIED,      // true at every point
+    VIOLATED,       // false at every point
+    UNDECIDED
+};
+
+// Classifies a predicate in one variable over an interval of it. Sets 'defined' to false if some
+// part of the predicate could not be evaluated. Must be safe to call from several threads.
+using BoxClassifier = std::function<Verdict(const Interval& x, bool& defined)>;
+
+// Solves a predicate over a bounded domain by branch and bound. The domain is bisected and each
+// box is classified. Boxes that cannot be decided are split until narrower than the tolerance and
+// then classified at their midpoint, as satisfied if 'inclusive' and the midpoint is still
+// undecided. Subdivisions are shared across worker threads. Boxes on which the predicate appears
+// undefined at both ends and the midpoint are discarded. Endpoints of the solution inside the
+// domain are closed only if 'inclusive' and the predicate is defined there.
+BisectionResult bisectDomain(const interval_t& domain, const BoxClassifier& classify, bool inclusive, const BisectionOptions& opts = BisectionOptions());
+
+// Solves an inequality (see isInequalityNode) whose sides are arithmetic expressions in a single
+// variable, e.g. sin(x) > x^2 - 1, over a bounded domain. The domain is bisected and each box is
+// classified with interval evaluation (see evaluateInterval). Boxes that cannot be decided are split
+// until narrower than the tolerance and then classified by the sign at their midpoint, so every
+// boundary of the result is within the tolerance of a true boundary. Subdivisions are shared across
+// worker threads. Boxes on which the expression appears undefined at both ends and the midpoint are
+// discarded. The expression is not modified.
+BisectionResult solveInequality(ExprNode* expr, const interval_t& domain, const BisectionOptions& opts = BisectionOptions());
+
+}
+
+#endif
@@ -1,9 +1,370 @@
 #include <algorithm>
+#include <map>
+#include <numeric>
+#include <set>
+#include <unordered_map>
 #include "boolean.h"
 
 namespace MathSolver
 {
 
+//
+// Boolean engine
+//
+
+// Distinct operands of the connectives in an expression, keyed by their infix string, in order of
+// first appearance.
+struct Atoms
+{
+    std::vector<ExprNode*> nodes;
+    std::vector<size_t> counts;
+    std::unordered_map<std::string, size_t> index;
+};
+
+static void collectAtoms(ExprNode* expr, Atoms& atoms)
+{
+    if (expr->type() == ExprNode::BOOLEAN)
+        return;
+
+    if (isBooleanNode(expr))
+    {
+        for (auto e : expr->children())
+            collectAtoms(e, atoms);
+        return;
+    }
+
+    auto res = atoms.index.emplace(toInfixString(expr), atoms.nodes.size());
+    if (res.second)
+    {
+        atoms.nodes.push_back(expr);
+        atoms.counts.push_back(1);
+    }
+    else
+    {
+        ++atoms.counts[res.first->second];
+    }
+}
+
+static size_t atomIndex(ExprNode* expr, const Atoms& atoms)
+{
+    return atoms.index.at(toInfixString(expr));
+}
+
+// Returns the BDD level of each atom.
+static std::vector<size_t> atomLevels(const Atoms& atoms, BooleanOrder order)
+{
+    std::vector<size_t> byLevel(atoms.nodes.size());
+    std::iota(byLevel.begin(), byLevel.end(), 0);
+    if (order == BooleanOrder::FREQUENCY)
+    {
+        std::stable_sort(byLevel.begin(), byLevel.end(),
+                         [&](size_t a, size_t b) { return atoms.counts[a] > atoms.counts[b]; });
+    }
+
+    std::vector<size_t> levels(atoms.nodes.size());
+    for (size_t i = 0; i < byLevel.size(); ++i)
+        levels[byLevel[i]] = i;
+    return levels;
+}
+
+// Truth table of atom i: bit k is the value of atom i in assignment k.
+static const uint64_t TRUTH_TABLE_VARS[MATHSOLVER_TRUTH_TABLE_VARS] =
+{
+    0xAAAAAAAAAAAAAAAAull, 0xCCCCCCCCCCCCCCCCull, 0xF0F0F0F0F0F0F0F0ull,
+    0xFF00FF00FF00FF00ull, 0xFFFF0000FFFF0000ull, 0xFFFFFFFF00000000ull
+};
+
+static uint64_t truthTableMask(size_t varCount)
+{
+    return (varCount == MATHSOLVER_TRUTH_TABLE_VARS) ? ~0ull : ((1ull << (1u << varCount)) - 1);
+}
+
+static uint64_t truthTable(ExprNode* expr, const Atoms& atoms, uint64_t mask)
+{
+    if (expr->type() == ExprNode::BOOLEAN)
+        return ((BoolNode*)expr)->value() ? mask : 0;
+    if (!isBooleanNode(expr))
+        return TRUTH_TABLE_VARS[atomIndex(expr, atoms)] & mask;
+
+    const std::string& name = ((OpNode*)expr)->name();
+    if (name == "not")
+        return ~truthTable(expr->children().front(), atoms, mask) & mask;
+
+    auto it = expr->children().begin();
+    uint64_t accum = truthTable(*it, atoms, mask);
+    for (++it; it != expr->children().end(); ++it)
+    {
+        uint64_t t = truthTable(*it, atoms, mask);
+        if (name == "and")          accum &= t;
+        else if (name == "or")      accum |= t;
+        else /* name == "xor" */    accum ^= t;
+    }
+
+    return accum;
+}
+
+static Bdd::Ref buildBdd(ExprNode* expr, const Atoms& atoms, const std::vector<size_t>& levels, Bdd& bdd)
+{
+    if (expr->type() == ExprNode::BOOLEAN)
+        return ((BoolNode*)expr)->value() ? Bdd::ONE : Bdd::ZERO;
+    if (!isBooleanNode(expr))
+        return bdd.variable(levels[atomIndex(expr, atoms)]);
+
+    const std::string& name = ((OpNode*)expr)->name();
+    if (name == "not")
+        return bdd.negate(buildBdd(expr->children().front(), atoms, levels, bdd));
+
+    auto it = expr->children().begin();
+    Bdd::Ref accum = buildBdd(*it, atoms, levels, bdd);
+    for (++it; it != expr->children().end(); ++it)
+    {
+        Bdd::Ref f = buildBdd(*it, atoms, levels, bdd);
+        if (name == "and")          accum = bdd.conjoin(accum, f);
+        else if (name == "or")      accum = bdd.disjoin(accum, f);
+        else /* name == "xor" */    accum = bdd.exclusiveOr(accum, f);
+    }
+
+    return accum;
+}
+
+// Quine-McCluskey over a truth table: merges implicants (value, don't-care mask) differing in one
+// variable until only primes are left, then takes the essential primes and covers the remaining
+// minterms greedily.
+static std::vector<Bdd::Cube> minimizeTruthTable(uint64_t table, size_t varCount)
+{
+    using Implicant = std::pair<uint32_t, uint32_t>;
+    std::set<Implicant> current, primes;
+    for (uint32_t m = 0; m < (1u << varCount); ++m)
+    {
+        if (table & (1ull << m))
+            current.insert({ m, 0 });
+    }
+
+    while (!current.empty())
+    {
+        std::set<Implicant> next, used;
+        for (auto it = current.begin(); it != current.end(); ++it)
+        {
+            for (auto it2 = std::next(it); it2 != current.end(); ++it2)
+            {
+                uint32_t diff = it->first ^ it2->first;
+                if (it->second == it2->second && (diff & (diff - 1)) == 0)
+                {
+                    next.insert({ it->first & ~diff, it->second | diff });
+                    used.insert(*it);
+                    used.insert(*it2);
+                }
+            }
+        }
+
+        for (const auto& i : current)
+        {
+            if (used.find(i) == used.end())
+                primes.insert(i);
+        }
+
+        current = std::move(next);
+    }
+
+    std::vector<Implicant> list(primes.begin(), primes.end());
+    std::vector<uint64_t> covers(list.size(), 0);
+    for (size_t i = 0; i < list.size(); ++i)
+    {
+        for (uint32_t m = 0; m < (1u << varCount); ++m)
+        {
+            if ((m & ~list[i].second) == list[i].first)
+                covers[i] |= (1ull << m);
+        }
+    }
+
+    std::vector<Implicant> chosen;
+    uint64_t left = table;
+    for (uint32_t m = 0; m < (1u << varCount); ++m)
+    {
+        size_t count = 0, last = 0;
+        for (size_t i = 0; i < list.size(); ++i)
+        {
+            if (covers[i] & (1ull << m))
+            {
+                ++count;
+                last = i;
+            }
+        }
+
+        if (count == 1 && (left & (1ull << m)))     // essential
+        {
+            chosen.push_back(list[last]);
+            left &= ~covers[last];
+        }
+    }
+
+    while (left != 0)
+    {
+        size_t best = 0;
+        int bestCount = -1;
+        for (size_t i = 0; i < list.size(); ++i)
+        {
+            int count = __builtin_popcountll(covers[i] & left);
+            if (count > bestCount || (count == bestCount && __builtin_popcount(list[i].second) > __builtin_popcount(list[best].second)))
+            {
+                best = i;
+                bestCount = count;
+            }
+        }
+
+        chosen.push_back(list[best]);
+        left &= ~covers[best];
+    }
+
+    std::vector<Bdd::Cube> cubes;
+    for (const auto& i : chosen)
+    {
+        Bdd::Cube cube;
+        for (size_t v = 0; v < varCount; ++v)
+        {
+            if (!(i.second & (1u << v)))
+                cube.emplace_back(v, (i.first >> v) & 1);
+        }
+
+        cubes.push_back(std::move(cube));
+    }
+
+    return cubes;
+}
+
+// Converts a cover, with literals as atom indices, to an expression.
+static ExprNode* coverToExpr(std::vector<Bdd::Cube>& cubes, const Atoms& atoms, ExprNode* parent)
+{
+    if (cubes.empty())
+        return new BoolNode(false, parent);
+
+    for (auto& c : cubes)
+    {
+        if (c.empty())
+            return new BoolNode(true, parent);
+        std::sort(c.begin(), c.end());
+    }
+
+    std::sort(cubes.begin(), cubes.end(), [](const Bdd::Cube& a, const Bdd::Cube& b) {
+        return (a.size() != b.size()) ? a.size() < b.size() : a < b;
+    });
+
+    auto literal = [&](const std::pair<size_t, bool>& lit, ExprNode* parent) {
+        ExprNode* atom = copyOf(atoms.nodes[lit.first]);
+        if (lit.second)
+        {
+            atom->setParent(parent);
+            return atom;
+        }
+
+        ExprNode* neg = new OpNode("not", parent);
+        atom->setParent(neg);
+        neg->children().push_back(atom);
+        return neg;
+    };
+
+    auto product = [&](const Bdd::Cube& cube, ExprNode* parent) {
+        if (cube.size() == 1)
+            return literal(cube.front(), parent);
+
+        ExprNode* conj = new OpNode("and", parent);
+        for (const auto& lit : cube)
+            conj->children().push_back(literal(lit, conj));
+        return conj;
+    };
+
+    if (cubes.size() == 1)
+        return product(cubes.front(), parent);
+
+    ExprNode* disj = new OpNode("or", parent);
+    for (const auto& c : cubes)
+        disj->children().push_back(product(c, disj));
+    return disj;
+}
+
+bool isSatisfiable(ExprNode* expr, BooleanOrder order)
+{
+    Atoms atoms;
+    collectAtoms(expr, atoms);
+    if (atoms.nodes.size() <= MATHSOLVER_TRUTH_TABLE_VARS)
+        return truthTable(expr, atoms, truthTableMask(atoms.nodes.size())) != 0;
+
+    Bdd bdd(atoms.nodes.size());
+    return buildBdd(expr, atoms, atomLevels(atoms, order), bdd) != Bdd::ZERO;
+}
+
+bool isEquivalent(ExprNode* a, ExprNode* b, BooleanOrder order)
+{
+    Atoms atoms;
+    collectAtoms(a, atoms);
+    collectAtoms(b, atoms);
+    if (atoms.nodes.size() <= MATHSOLVER_TRUTH_TABLE_VARS)
+    {
+        uint64_t mask = truthTableMask(atoms.nodes.size());
+        return truthTable(a, atoms, mask) == truthTable(b, atoms, mask);
+    }
+
+    // Hash-consing makes equal functions the same node
+    Bdd bdd(atoms.nodes.size());
+    std::vector<size_t> levels = atomLevels(atoms, order);
+    return buildBdd(a, atoms, levels, bdd) == buildBdd(b, atoms, levels, bdd);
+}
+
+size_t bddSize(ExprNode* expr, BooleanOrder order)
+{
+    Atoms atoms;
+    collectAtoms(expr, atoms);
+    Bdd bdd(atoms.nodes.size());
+    return bdd.size(buildBdd(expr, atoms, atomLevels(atoms, order), bdd));
+}
+
+ExprNode* minimizeBoolean(ExprNode* expr, BooleanOrder order)
+{
+    Atoms atoms;
+    collectAtoms(expr, atoms);
+
+    size_t count = nodeCount(expr);
+    std::vector<Bdd::Cube> cubes;
+    if (atoms.nodes.size() <= MATHSOLVER_TRUTH_TABLE_VARS)
+    {
+        uint64_t table = truthTable(expr, atoms, truthTableMask(atoms.nodes.size()));
+        cubes = minimizeTruthTable(table, atoms.nodes.size());
+    }
+    else
+    {
+        Bdd bdd(atoms.nodes.size());
+        std::vector<size_t> levels = atomLevels(atoms, order);
+        Bdd::Ref f = buildBdd(expr, atoms, levels, bdd);
+        if (f == Bdd::ONE)
+            cubes.emplace_back();
+        else if (f != Bdd::ZERO && !bdd.cover(f, cubes, count))  // ex: parity of many atoms
+            return expr;
+
+        std::vector<size_t> atomAt(levels.size());
+        for (size_t i = 0; i < levels.size(); ++i)
+            atomAt[levels[i]] = i;
+        for (auto& c : cubes)
+        {
+            for (auto& lit : c)
+                lit.first = atomAt[lit.first];
+        }
+    }
+
+    ExprNode* res = coverToExpr(cubes, atoms, expr->parent());
+    if (res->type() != ExprNode::BOOLEAN && nodeCount(res) > count)
+    {
+        freeExpression(res);
+        return expr;
+    }
+
+    freeExpression(expr);
+    return res;
+}
+
+//
+// Evaluators
+//
+
 ExprNode* booleanNot(ExprNode* expr)
 {
     if (expr->children().size() != 1)     
@@ -58,6 +419,11 @@ ExprNode* evaluateBooleanExpr(ExprNode* expr, int data)
     if (expr->type() == ExprNode::BOOLEAN)  
         return expr;
 
+    auto pred = [](ExprNode* node) { return node->type() != ExprNode::BOOLEAN; };
+    if (isBooleanNode(expr) && !expr->children().empty() && 
+        std::any_of(expr->children().begin(), expr->children().end(), pred))
+        return minimizeBoolean(expr);    // ex: (and a (not a) b) ==> false
+
     if (expr->isOperator())
     {
         OpNode* op = (OpNode*)expr;
@@ -73,14 +439,16 @@ ExprNode* evaluateBooleanExpr(ExprNode* expr, int data)
 
 bool isBooleanExpr(ExprNode* expr)
 {
-    if (expr->isOperator() && 
-        (((OpNode*)expr)->name() == "not" || ((OpNode*)expr)->name() == "and" ||
-         ((OpNode*)expr)->name() == "or" || ((OpNode*)expr)->name() == "xor"))
-    {
+    if (isBooleanNode(expr))
         return std::all_of(expr->children().begin(), expr->children().end(), isBooleanExpr);
-    }
-
     return expr->type() == ExprNode::BOOLEAN;
 }
 
+bool isBooleanNode(ExprNode* expr)
+{
+    return (expr->isOperator() && 
+            (((OpNode*)expr)->name() == "not" || ((OpNode*)expr)->name() == "and" ||
+             ((OpNode*)expr)->name() == "or" || ((OpNode*)expr)->name() == "xor"));
+}
+
 }
\ No newline at end of file
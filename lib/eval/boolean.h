@@ -3,10 +3,25 @@
 
 #include "../common/base.h"
 #include "../expr/expr.h"
+#include "../types/bdd.h"
+
+// Expressions with at most this many distinct atoms are handled with a bit-packed truth table
+// (one bit per assignment in a 64-bit word) instead of a BDD.
+#define MATHSOLVER_TRUTH_TABLE_VARS     6
 
 namespace MathSolver
 {
 
+// Variable ordering heuristics for the BDD engine. Atoms are variables and any other operand of a
+// connective, such as an inequality. APPEARANCE orders them by first occurrence in a depth-first
+// walk, which keeps atoms of the same subexpression adjacent; FREQUENCY puts the atoms that
+// occur most often first.
+enum class BooleanOrder
+{
+    APPEARANCE,
+    FREQUENCY
+};
+
 ExprNode* booleanBinary(ExprNode* expr, const std::string& op);
 
 // Evaluators
@@ -21,6 +36,24 @@ ExprNode* evaluateBooleanExpr(ExprNode* expr, int data);
 // Returns true if the expression contains only boolean logic.
 bool isBooleanExpr(ExprNode* node);
 
+// Returns true if the node is a 'not', 'and', 'or' or 'xor' operator.
+bool isBooleanNode(ExprNode* node);
+
+// Returns true if some assignment of the atoms satisfies the expression.
+bool isSatisfiable(ExprNode* expr, BooleanOrder order = BooleanOrder::APPEARANCE);
+
+// Returns true if the expressions agree on every assignment of their atoms.
+bool isEquivalent(ExprNode* a, ExprNode* b, BooleanOrder order = BooleanOrder::APPEARANCE);
+
+// Returns the number of BDD nodes, including terminals, representing the expression under the
+// variable ordering.
+size_t bddSize(ExprNode* expr, BooleanOrder order = BooleanOrder::APPEARANCE);
+
+// Returns an equivalent sum of products with prime implicants (Quine-McCluskey on the truth
+// table, or an irredundant cover of the BDD), or a constant. The original expression is kept if
+// the cover is larger. Consumes the expression.
+ExprNode* minimizeBoolean(ExprNode* expr, BooleanOrder order = BooleanOrder::APPEARANCE);
+
 }
 
 #endif
\ No newline at end of file
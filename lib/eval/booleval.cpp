@@ -0,0 +1,204 @@
+#include <algorithm>
+#include <set>
+#include "boolean.h"
+#include "booleval.h"
+
+namespace MathSolver
+{
+
+// Collects the variables of a boolean expression. Returns false if the expression contains
+// anything other than connectives, variables and boolean constants.
+static bool booleanVariables(ExprNode* expr, std::set<std::string>& vars)
+{
+    if (expr->type() == ExprNode::BOOLEAN)
+        return true;
+
+    if (expr->type() == ExprNode::VARIABLE)
+    {
+        vars.insert(((VarNode*)expr)->name());
+        return true;
+    }
+
+    if (!isBooleanNode(expr) || expr->children().empty() ||
+        (((OpNode*)expr)->name() == "not" && expr->children().size() != 1))
+        return false;
+
+    for (auto e : expr->children())
+    {
+        if (!booleanVariables(e, vars))
+            return false;
+    }
+
+    return true;
+}
+
+//
+//  BoolProgram
+//
+
+BoolProgram::BoolProgram()
+{
+    mResult = emit(CONST, 0);
+}
+
+bool BoolProgram::lower(ExprNode* expr)
+{
+    std::set<std::string> vars;
+    if (!booleanVariables(expr, vars))
+        return false;
+
+    BoolProgram prog;
+    prog.mInstrs.clear();
+    prog.mRegs.clear();
+    prog.mVars.assign(vars.begin(), vars.end());
+    prog.mResult = prog.lowerNode(expr);
+
+    *this = std::move(prog);
+    return true;
+}
+
+void BoolProgram::evaluate(const std::vector<const uint64_t*>& columns, size_t rows, uint64_t* out) const
+{
+    if (columns.size() < mVars.size())
+    {
+        gErrorManager.log("Expected " + std::to_string(mVars.size()) + " columns, got " + std::to_string(columns.size()),
+                          ErrorManager::ERROR, __FILE__, __LINE__);
+        return;
+    }
+
+    // Inputs and constants are referenced in place, so only connectives need a tile of storage
+    const size_t TILE = MATHSOLVER_BOOL_TILE_WORDS;
+    static const std::vector<uint64_t> ZEROS(TILE, 0), ONES(TILE, ~0ull);
+
+    size_t words = (rows + 63) / 64;
+    std::vector<uint64_t> temps(mInstrs.size() * TILE);
+    std::vector<const uint64_t*> p(mInstrs.size());
+    for (size_t w = 0; w < words; w += TILE)
+    {
+        size_t n = std::min(TILE, words - w);
+        for (size_t i = 0; i < mInstrs.size(); ++i)
+        {
+            const Instr& in = mInstrs[i];
+            uint64_t* r = &temps[i * TILE];
+            switch (in.op)
+            {
+            case CONST:
+                p[i] = in.a ? ONES.data() : ZEROS.data();
+                continue;
+            case INPUT:
+                p[i] = columns[in.a] + w;
+                continue;
+            case NOT:
+                for (size_t j = 0; j < n; ++j)  r[j] = ~p[in.a][j];
+                break;
+            case AND:
+                for (size_t j = 0; j < n; ++j)  r[j] = p[in.a][j] & p[in.b][j];
+                break;
+            case OR:
+                for (size_t j = 0; j < n; ++j)  r[j] = p[in.a][j] | p[in.b][j];
+                break;
+            case XOR:
+                for (size_t j = 0; j < n; ++j)  r[j] = p[in.a][j] ^ p[in.b][j];
+                break;
+            }
+
+            p[i] = r;
+        }
+
+        std::copy(p[mResult], p[mResult] + n, out + w);
+    }
+
+    if (rows % 64 != 0)
+        out[words - 1] &= (1ull << (rows % 64)) - 1;
+}
+
+std::vector<uint64_t> BoolProgram::evaluate(const std::vector<const uint64_t*>& columns, size_t rows) const
+{
+    std::vector<uint64_t> out((rows + 63) / 64);
+    evaluate(columns, rows, out.data());
+    return out;
+}
+
+bool BoolProgram::evaluate(const std::vector<bool>& vals) const
+{
+    if (vals.size() < mVars.size())
+    {
+        gErrorManager.log("Expected " + std::to_string(mVars.size()) + " values, got " + std::to_string(vals.size()),
+                          ErrorManager::ERROR, __FILE__, __LINE__);
+        return false;
+    }
+
+    std::vector<bool> r(mInstrs.size());
+    for (size_t i = 0; i < mInstrs.size(); ++i)
+    {
+        const Instr& in = mInstrs[i];
+        switch (in.op)
+        {
+        case CONST: r[i] = in.a;                break;
+        case INPUT: r[i] = vals[in.a];          break;
+        case NOT:   r[i] = !r[in.a];            break;
+        case AND:   r[i] = r[in.a] && r[in.b];  break;
+        case OR:    r[i] = r[in.a] || r[in.b];  break;
+        case XOR:   r[i] = r[in.a] != r[in.b];  break;
+        }
+    }
+
+    return r[mResult];
+}
+
+size_t BoolProgram::emit(Opcode op, size_t a, size_t b)
+{
+    if (op == NOT)
+    {
+        if (mInstrs[a].op == CONST)     return emit(CONST, !mInstrs[a].a);
+        if (mInstrs[a].op == NOT)       return mInstrs[a].a;
+    }
+    else if (op == AND || op == OR || op == XOR)
+    {
+        if (a > b)  std::swap(a, b);    // commutative, so one key per pair
+        if (isConstant(a, op != AND))   return (op == XOR) ? emit(NOT, b) : a;    // (and false x), (or true x), (xor true x)
+        if (isConstant(b, op != AND))   return (op == XOR) ? emit(NOT, a) : b;
+        if (isConstant(a, op == AND))   return b;                                   // (and true x), (or false x), (xor false x)
+        if (isConstant(b, op == AND))   return a;
+        if (a == b)                     return (op == XOR) ? emit(CONST, 0) : a;
+    }
+
+    auto key = std::make_tuple(op, a, b);
+    auto it = mRegs.find(key);
+    if (it != mRegs.end())
+        return it->second;
+
+    mInstrs.push_back({ op, a, b });
+    mRegs.emplace(key, mInstrs.size() - 1);
+    return mInstrs.size() - 1;
+}
+
+size_t BoolProgram::lowerNode(ExprNode* expr)
+{
+    if (expr->type() == ExprNode::BOOLEAN)
+        return emit(CONST, ((BoolNode*)expr)->value());
+
+    if (expr->type() == ExprNode::VARIABLE)
+    {
+        const std::string& name = ((VarNode*)expr)->name();
+        return emit(INPUT, std::lower_bound(mVars.begin(), mVars.end(), name) - mVars.begin());
+    }
+
+    const std::string& name = ((OpNode*)expr)->name();
+    if (name == "not")
+        return emit(NOT, lowerNode(expr->children().front()));
+
+    Opcode op = (name == "and") ? AND : ((name == "or") ? OR : XOR);
+    auto it = expr->children().begin();
+    size_t reg = lowerNode(*it);
+    for (++it; it != expr->children().end(); ++it)
+        reg = emit(op, reg, lowerNode(*it));
+    return reg;
+}
+
+bool BoolProgram::isConstant(size_t reg, bool value) const
+{
+    return mInstrs[reg].op == CONST && mInstrs[reg].a == (size_t)value;
+}
+
+}
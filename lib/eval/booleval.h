@@ -0,0 +1,90 @@
+#ifndef _MATHSOLVER_BOOLEVAL_H_
+#define _MATHSOLVER_BOOLEVAL_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "../common/base.h"
+#include "../expr/expr.h"
+
+// Number of 64-bit words of each register evaluated by one pass over the instructions in batch
+// evaluation. Each instruction then runs as a tight loop over this many words.
+#define MATHSOLVER_BOOL_TILE_WORDS      32
+
+namespace MathSolver
+{
+
+// A boolean expression over variables lowered to a straight-line program for evaluation over many
+// assignments at once. Rows are packed into bitmaps, bit k % 64 of word k / 64 holding row k, so
+// every instruction evaluates 64 rows per word. Repeated subexpressions are computed once and
+// constants are folded.
+class BoolProgram
+{
+public:
+
+    enum Opcode
+    {
+        CONST,      // r = a ? ~0 : 0
+        INPUT,      // r = column[a]
+        NOT,        // r = ~r[a]
+        AND,        // r = r[a] & r[b]
+        OR,         // r = r[a] | r[b]
+        XOR         // r = r[a] ^ r[b]
+    };
+
+    struct Instr
+    {
+        Opcode op;
+        size_t a, b;
+    };
+
+public:
+
+    // Constructs the constant false.
+    BoolProgram();
+
+    // Lowers an expression of 'not', 'and', 'or' and 'xor' over variables and boolean constants.
+    // Returns false and leaves this program unchanged for any other expression.
+    bool lower(ExprNode* expr);
+
+    // Evaluates the first 'rows' rows. 'columns' holds a bitmap for each variable, in the order of
+    // variables(), of at least (rows + 63) / 64 words. Writes as many words to 'out'; bits past the
+    // last row are cleared.
+    void evaluate(const std::vector<const uint64_t*>& columns, size_t rows, uint64_t* out) const;
+    std::vector<uint64_t> evaluate(const std::vector<const uint64_t*>& columns, size_t rows) const;
+
+    // Evaluates a single assignment, given in the order of variables().
+    bool evaluate(const std::vector<bool>& vals) const;
+
+    // Returns the instructions.
+    inline const std::vector<Instr>& instructions() const { return mInstrs; }
+
+    // Returns the register holding the value of the expression.
+    inline size_t result() const { return mResult; }
+
+    // Returns the variables of the expression in sorted order.
+    inline const std::vector<std::string>& variables() const { return mVars; }
+
+private:
+
+    // Appends an instruction, or returns the register of an identical one. Folds constants.
+    size_t emit(Opcode op, size_t a = 0, size_t b = 0);
+
+    // Emits the expression and returns its register.
+    size_t lowerNode(ExprNode* expr);
+
+    // Returns true if the register holds the given constant.
+    bool isConstant(size_t reg, bool value) const;
+
+private:
+    std::vector<Instr> mInstrs;
+    std::vector<std::string> mVars;
+    std::map<std::tuple<Opcode, size_t, size_t>, size_t> mRegs;
+    size_t mResult;
+};
+
+}
+
+#endif
@@ -0,0 +1,78 @@
+#include "../math/float-math.h"
+#include "../math/integer-math.h"
+#include "../math/interval-math.h"
+#include "enclosure.h"
+
+namespace MathSolver
+{
+
+// Returns the smallest interval around an Integer.
+static Interval integerInterval(const Integer& x, mpfr_prec_t prec)
+{
+    if (x.isUndef() || x.isInf())
+        return Interval::undef(prec);
+    return Interval(integerToFloat(x, 0), prec);
+}
+
+Interval evaluateInterval(ExprNode* expr, const IntervalBox& box, mpfr_prec_t prec)
+{
+    if (expr->type() == ExprNode::INTEGER)      return integerInterval(((IntNode*)expr)->value(), prec);
+    if (expr->type() == ExprNode::FLOAT)        return Interval(((FloatNode*)expr)->value(), prec);
+    if (expr->type() == ExprNode::CONSTANT)     return constantInterval(((ConstNode*)expr)->name(), prec);
+    if (expr->type() == ExprNode::RATIONAL)
+    {
+        const Rational& q = ((RationalNode*)expr)->value();
+        return integerInterval(q.numerator(), prec) / integerInterval(q.denominator(), prec);
+    }
+
+    if (expr->type() == ExprNode::VARIABLE)
+    {
+        auto it = box.find(((VarNode*)expr)->name());
+        return (it != box.end()) ? it->second : Interval::undef(prec);
+    }
+
+    if (expr->isOperator())
+    {
+        const std::string& name = ((OpNode*)expr)->name();
+        auto it = expr->children().begin();
+        if (name == "-*")   return -evaluateInterval(*it, box, prec);
+        if (name == "!")
+        {
+            Interval n = evaluateInterval(*it, box, prec);
+            if (!n.isPoint() || !mpfr_integer_p(n.lower().data()) || mpfr_sgn(n.lower().data()) < 0 ||
+                mpfr_cmp_si(n.lower().data(), MATHSOLVER_FACTORIAL_MAX) > 0)
+                return Interval::undef(prec);
+            return integerInterval(fact((int)mpfr_get_si(n.lower().data(), MPFR_RNDN)), prec);
+        }
+
+        Interval acc = evaluateInterval(*it, box, prec);
+        for (++it; it != expr->children().end(); ++it)
+        {
+            Interval x = evaluateInterval(*it, box, prec);
+            if (name == "+")                        acc = acc + x;
+            else if (name == "-")                   acc = acc - x;
+            else if (name == "*" || name == "**")   acc = acc * x;
+            else if (name == "/")                   acc = acc / x;
+            else if (name == "^")                   acc = pow(acc, x);
+            else if (name == "%" || name == "mod")  acc = mod(acc, x);
+            else                                    return Interval::undef(prec);
+        }
+
+        return acc;
+    }
+
+    if (expr->type() == ExprNode::FUNCTION && expr->children().size() == 1)
+    {
+        const std::string& name = ((FuncNode*)expr)->name();
+        Interval x = evaluateInterval(expr->children().front(), box, prec);
+        if (name == "exp")          return exp(x);
+        else if (name == "log")     return log(x);
+        else if (name == "sin")     return sin(x);
+        else if (name == "cos")     return cos(x);
+        else if (name == "tan")     return tan(x);
+    }
+
+    return Interval::undef(prec);
+}
+
+}
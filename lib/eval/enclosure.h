@@ -0,0 +1,24 @@
+#ifndef _MATHSOLVER_ENCLOSURE_H_
+#define _MATHSOLVER_ENCLOSURE_H_
+
+#include <map>
+#include <string>
+#include "../common/base.h"
+#include "../expr/expr.h"
+#include "../types/interval.h"
+
+namespace MathSolver
+{
+
+// Assignment of an interval to each variable of an expression.
+using IntervalBox = std::map<std::string, Interval>;
+
+// Evaluates an arithmetic expression (see isArithmeticNode) in interval arithmetic, with each
+// variable ranging over its interval in the box. The result contains the value of the expression
+// at every point of the box. Unsupported nodes and unassigned variables give Interval::undef().
+// The expression is not modified.
+Interval evaluateInterval(ExprNode* expr, const IntervalBox& box, mpfr_prec_t prec = MATHSOLVER_FLOAT_DEFAULT_PREC);
+
+}
+
+#endif
@@ -11,6 +11,11 @@ namespace MathSolver
 {
 
 ExprNode* evaluateExpr(ExprNode* expr)
+{
+    return evaluateExpr(expr, nullptr);
+}
+
+ExprNode* evaluateExpr(ExprNode* expr, ShortCircuitStats* stats)
 { 
     if (expr == nullptr)        return expr;
     if (isUndef(expr))          return expr;
@@ -25,11 +30,37 @@ ExprNode* evaluateExpr(ExprNode* expr)
     if (isInequality(expr))     
     {
         expr = evaluateExprLayer(expr, rewriteInequality, 0);
-        return evaluateExprLayer(expr, evaluateInequality, 0);
+        auto leaf = [](ExprNode* node) { return evaluateExprLayer(node, evaluateInequality, 0); };
+        auto combine = [](ExprNode* node) { return evaluateInequality(node, 0); };
+        return evaluateShortCircuit(expr, leaf, combine, stats);
     }
 
-    if (isBooleanExpr(expr))    return evaluateExprLayer(expr, evaluateBooleanExpr, 0);
     if (isRangeExpr(expr))      return evaluateExprLayer(expr, evaluateRange, 0);
+
+    // Boolean logic over variables and inequalities: operands are evaluated only until the result is
+    // known, and what is left is minimized as a whole
+    if (expr->type() == ExprNode::BOOLEAN || isBooleanNode(expr))
+    {
+        auto leaf = [stats](ExprNode* node) {
+            node = evaluateExpr(node, stats);
+            if (node->type() != ExprNode::BOOLEAN && node->type() != ExprNode::VARIABLE &&
+                !isBooleanNode(node) && !isInequality(node))
+            {
+                gErrorManager.log("Expected a boolean expression: " + toInfixString(node),
+                                  ErrorManager::ERROR, __FILE__, __LINE__);
+            }
+
+            return node;
+        };
+        auto combine = [](ExprNode* node) {
+            if (isInequality(node))     return evaluateInequality(node, 0);
+            if (node->parent() != nullptr && isBooleanNode(node->parent()))
+                return node;    // simplified once with the whole expression
+            return evaluateBooleanExpr(node, 0);
+        };
+
+        return evaluateShortCircuit(expr, leaf, combine, stats);
+    }
     
     gErrorManager.log("Unrecognized expression: " + toInfixString(expr), ErrorManager::ERROR, __FILE__, __LINE__);
     return expr;
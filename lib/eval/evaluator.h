@@ -1,6 +1,9 @@
 #ifndef _MATHSOLVER_EVALUATOR_H_
 #define _MATHSOLVER_EVALUATOR_H_
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
 #include "../common/base.h"
 #include "../expr/expr.h"
 
@@ -24,10 +27,104 @@ ExprNode* evaluateExprLayer(ExprNode* expr, const Func& func, const Data& data)
     return func(expr, data);
 }
 
+// Number of subtrees handed to the leaf evaluator and number of subtrees freed without being
+// evaluated by 'evaluateShortCircuit'.
+struct ShortCircuitStats
+{
+    size_t evaluated = 0;
+    size_t skipped = 0;
+};
+
+// Short-circuiting evaluation layer for 'and', 'or', 'xor' and 'not'. Children are evaluated one at a
+// time, smallest subtree first, and the remaining children of an 'and' or 'or' are freed as soon as
+// one of them decides the result. Decided operands are dropped, any other subtree is evaluated by
+// 'leaf', and a connective whose result still depends on undecided operands is passed to 'combine'.
+template <typename Leaf, typename Combine>
+ExprNode* evaluateShortCircuit(ExprNode* expr, const Leaf& leaf, const Combine& combine, ShortCircuitStats* stats)
+{
+    if (expr->type() == ExprNode::BOOLEAN)
+        return expr;
+
+    std::string name = expr->isOperator() ? ((OpNode*)expr)->name() : "";
+    if (name != "and" && name != "or" && name != "xor" && name != "not")
+    {
+        if (stats)  ++stats->evaluated;
+        return leaf(expr);
+    }
+
+    if (expr->children().size() < ((name == "not") ? 1 : 2))   // arity errors are reported by 'combine'
+        return combine(expr);
+
+    std::vector<ExprNode*> children(expr->children().begin(), expr->children().end());
+    std::vector<size_t> cost(children.size()), order(children.size());
+    for (size_t i = 0; i < children.size(); ++i)
+        cost[i] = nodeCount(children[i]);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return cost[a] < cost[b]; });
+    expr->children().clear();
+
+    bool lazy = (name == "and" || name == "or");
+    bool decider = (name == "or");
+    bool parity = false;
+    for (size_t k = 0; k < order.size(); ++k)
+    {
+        ExprNode*& child = children[order[k]];
+        child = evaluateShortCircuit(child, leaf, combine, stats);
+        if (child->type() != ExprNode::BOOLEAN)
+            continue;
+
+        bool value = ((BoolNode*)child)->value();
+        if (lazy && value == decider)  // ex: (and ... false ...) ==> false
+        {
+            if (stats)  stats->skipped += order.size() - k - 1;
+            for (auto c : children)
+                freeExpression(c);
+
+            ExprNode* res = new BoolNode(decider, expr->parent());
+            freeExpression(expr);
+            return res;
+        }
+
+        parity = (parity != value);
+        freeExpression(child);
+        child = nullptr;
+    }
+
+    for (auto c : children)
+    {
+        if (c != nullptr)
+            expr->children().push_back(c);
+    }
+
+    if (expr->children().empty())   // every operand was decided
+    {
+        bool value = (name == "and") ? true : (name == "or") ? false : (name == "xor") ? parity : !parity;
+        ExprNode* res = new BoolNode(value, expr->parent());
+        freeExpression(expr);
+        return res;
+    }
+
+    if (name == "xor" && parity)
+        expr->children().push_back(new BoolNode(true, expr));
+    else if (lazy && expr->children().size() == 1)   // ex: (and true (x > 1)) ==> (x > 1)
+    {
+        // A surviving connective may have left its simplification to this one, so it is combined
+        // here instead, ex: (and true (or a (not (not b)))) ==> (or a b)
+        ExprNode* res = moveNode(expr, expr->children().front());
+        std::string op = res->isOperator() ? ((OpNode*)res)->name() : "";
+        return (op == "and" || op == "or" || op == "xor" || op == "not") ? combine(res) : res;
+    }
+
+    return combine(expr);
+}
 
 // Evaluates a mathematical expression and returns the result.
 ExprNode* evaluateExpr(ExprNode* expr);
 
+// Evaluates a mathematical expression and returns the result. Counts the subtrees evaluated and
+// skipped by short-circuiting connectives in 'stats'.
+ExprNode* evaluateExpr(ExprNode* expr, ShortCircuitStats* stats);
+
 }
 
 #endif
\ No newline at end of file
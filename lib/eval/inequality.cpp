@@ -1,9 +1,14 @@
 #include <algorithm>
+#include <map>
 #include "boolean.h"
 #include "evaluator.h"
 #include "inequality.h"
 #include "../types/range.h"
 #include "../expr/arithmetic.h"
+#include "../expr/polynomial.h"
+#include "../math/float-math.h"
+#include "../math/integer-math.h"
+#include "../math/poly-roots.h"
 
 namespace MathSolver
 {
@@ -54,6 +59,85 @@ Range extractRange(ExprNode* expr)
     return Range();
 }
 
+// Returns true if the expression is a bound on a single variable that 'extractRange' can read,
+// i.e. (op x a), (op a x), or (op a x b), and sets 'var' to that variable.
+static bool isRangeBound(ExprNode* expr, std::string& var)
+{
+    if (!isInequalityNode(expr))
+        return false;
+
+    const std::list<ExprNode*>& children = expr->children();
+    if (children.size() == 2)
+    {
+        ExprNode* lhs = children.front();
+        ExprNode* rhs = children.back();
+        if (lhs->type() == ExprNode::VARIABLE && rhs->isNumber())       var = ((VarNode*)lhs)->name();
+        else if (lhs->isNumber() && rhs->type() == ExprNode::VARIABLE)  var = ((VarNode*)rhs)->name();
+        else                                                            return false;
+        return true;
+    }
+    else if (children.size() == 3 && ((OpNode*)expr)->name() != "!=")
+    {
+        ExprNode* mid = *std::next(children.begin());
+        if (!children.front()->isNumber() || mid->type() != ExprNode::VARIABLE || !children.back()->isNumber())
+            return false;
+        var = ((VarNode*)mid)->name();
+        return true;
+    }
+
+    return false;
+}
+
+// Reads the Range of a simple bound (see isRangeBound), of an interval with mixed endpoints as
+// written by 'toExpression', i.e. (< (<= a x) b), or of a conjunction or disjunction of these on
+// a single variable. Returns false otherwise.
+static bool readRange(ExprNode* expr, std::string& var, Range& range)
+{
+    if (isRangeBound(expr, var))
+    {
+        range = extractRange(expr);
+        return true;
+    }
+
+    if (!expr->isOperator())
+        return false;
+
+    const std::string& name = ((OpNode*)expr)->name();
+    if (name == "and" || name == "or")
+    {
+        std::vector<Range> cranges(expr->children().size());
+        std::vector<const Range*> ptrs;
+        for (auto child : expr->children())
+        {
+            std::string cvar;
+            if (!readRange(child, cvar, cranges[ptrs.size()]) || (!ptrs.empty() && cvar != var))
+                return false;
+
+            ptrs.push_back(&cranges[ptrs.size()]);
+            var = cvar;
+        }
+
+        range = (name == "and") ? Range::conjoin(ptrs) : Range::disjoin(ptrs);
+        return !ptrs.empty();
+    }
+
+    if ((name == "<" || name == "<=") && expr->children().size() == 2 && expr->children().back()->isNumber())
+    {
+        ExprNode* inner = expr->children().front();
+        if (inner->isOperator() && inner->children().size() == 2 && inner->children().front()->isNumber() &&
+            inner->children().back()->type() == ExprNode::VARIABLE &&
+            (((OpNode*)inner)->name() == "<" || ((OpNode*)inner)->name() == "<="))
+        {
+            var = ((VarNode*)inner->children().back())->name();
+            range = Range(toFloat(inner->children().front()), toFloat(expr->children().back()),
+                          ((OpNode*)inner)->name() == "<=", name == "<=");
+            return true;
+        }
+    }
+
+    return false;
+}
+
 ExprNode* toExpression(const interval_t& ival, const std::string& var)
 {
     VarNode* vnode = new VarNode(var);
@@ -71,7 +155,7 @@ ExprNode* toExpression(const interval_t& ival, const std::string& var)
     else if (ival.lower == NEG_INFINITY)
     {
         ExprNode* op = new OpNode(((ival.upperClosed) ? "<=" : "<"));
-        ExprNode* bound = new FloatNode(ival.upper, op);
+        ExprNode* bound = new FloatNode(ival.upper.toFloat(), op);
         op->children().push_back(vnode);
         op->children().push_back(bound);
         vnode->setParent(op);
@@ -80,7 +164,7 @@ ExprNode* toExpression(const interval_t& ival, const std::string& var)
     else if (ival.upper == POS_INFINITY)
     {
         ExprNode* op = new OpNode(((ival.lowerClosed) ? ">=" : ">"));
-        ExprNode* bound = new FloatNode(ival.lower, op);
+        ExprNode* bound = new FloatNode(ival.lower.toFloat(), op);
         op->children().push_back(vnode);
         op->children().push_back(bound);
         vnode->setParent(op);
@@ -91,8 +175,8 @@ ExprNode* toExpression(const interval_t& ival, const std::string& var)
         if (ival.lowerClosed == ival.upperClosed)
         {
             ExprNode* op = new OpNode(((ival.lowerClosed) ? "<=" : "<"));
-            ExprNode* lbound = new FloatNode(ival.lower, op);
-            ExprNode* ubound = new FloatNode(ival.upper, op);
+            ExprNode* lbound = new FloatNode(ival.lower.toFloat(), op);
+            ExprNode* ubound = new FloatNode(ival.upper.toFloat(), op);
             op->children().push_back(lbound);
             op->children().push_back(vnode);
             op->children().push_back(ubound);
@@ -104,8 +188,8 @@ ExprNode* toExpression(const interval_t& ival, const std::string& var)
             ExprNode* upper = new OpNode(((ival.upperClosed) ? "<=" : "<"));
             ExprNode* lower = new OpNode(((ival.lowerClosed) ? "<=" : "<"), upper);
 
-            ExprNode* ubound = new FloatNode(ival.upper, upper);
-            ExprNode* lbound = new FloatNode(ival.lower, lower);
+            ExprNode* ubound = new FloatNode(ival.upper.toFloat(), upper);
+            ExprNode* lbound = new FloatNode(ival.lower.toFloat(), lower);
 
             vnode->setParent(lower);
             lower->children().push_back(lbound);
@@ -140,30 +224,180 @@ ExprNode* toExpression(const Range& range, const std::string& var)
     return node; 
 }
 
-bool compareNumbers(ExprNode* lhs, ExprNode* rhs, const std::string& op)
+// Returns the sign of f - x, or 2 if f is NaN. Exact: small integers are compared as machine
+// integers and larger ones through GMP, without rounding x to a Float.
+static int compareFloatInteger(const Float& f, const Integer& x)
 {
-    if (lhs->type() == ExprNode::INTEGER && rhs->type() == ExprNode::INTEGER)
+    if (f.isNaN() || x.isUndef())
+        return 2;
+
+    if (x.isInf())
+        return (mpfr_inf_p(f.data()) && (mpfr_sgn(f.data()) < 0) == x.sign()) ? 0 : (x.sign() ? 1 : -1);
+
+    int res;
+    if (highestNonZeroByte(x.data(), x.size()) <= 1)
     {
-        if (op == ">")   return ((IntNode*)lhs)->value() > ((IntNode*)rhs)->value();
-        if (op == "<")   return ((IntNode*)lhs)->value() < ((IntNode*)rhs)->value();
-        if (op == ">=")  return ((IntNode*)lhs)->value() >= ((IntNode*)rhs)->value();
-        if (op == "<=")  return ((IntNode*)lhs)->value() <= ((IntNode*)rhs)->value();
-        if (op == ">=")  return ((IntNode*)lhs)->value() >= ((IntNode*)rhs)->value();
-        if (op == "!=")  return ((IntNode*)lhs)->value() != ((IntNode*)rhs)->value();
+        long n = (long)x.data()[0];
+        res = mpfr_cmp_si(f.data(), x.sign() ? -n : n);
     }
     else
     {
-        Float f1 = toFloat(lhs);
-        Float f2 = toFloat(rhs);
-        if (op == ">")      return f1 > f2;
-        if (op == "<")      return f1 < f2;
-        if (op == ">=")     return f1 >= f2;
-        if (op == "<=")     return f1 <= f2;
-        if (op == "!=")     return f1 != f2;
+        mpz_t z;
+        mpz_init(z);
+        toMpz(x, z);
+        res = mpfr_cmp_z(f.data(), z);
+        mpz_clear(z);
     }
 
-    gErrorManager.log("Expected a comparator " + toInfixString(lhs) + op + toInfixString(rhs), ErrorManager::ERROR, __FILE__, __LINE__);
-    return false;
+    return (res > 0) - (res < 0);
+}
+
+int compareNumbers(ExprNode* lhs, ExprNode* rhs)
+{
+    ExprNode::Type lt = lhs->type(), rt = rhs->type();
+    if (lt == ExprNode::INTEGER && rt == ExprNode::INTEGER)
+    {
+        const Integer& a = ((IntNode*)lhs)->value();
+        const Integer& b = ((IntNode*)rhs)->value();
+        if (a.isUndef() || b.isUndef())
+            return 2;
+
+        int res = a.compare(b);
+        return (res > 0) - (res < 0);
+    }
+
+    if (lt == ExprNode::FLOAT && rt == ExprNode::FLOAT)
+    {
+        const Float& a = ((FloatNode*)lhs)->value();
+        const Float& b = ((FloatNode*)rhs)->value();
+        if (a.isNaN() || b.isNaN())
+            return 2;
+
+        int res = mpfr_cmp(a.data(), b.data());
+        return (res > 0) - (res < 0);
+    }
+
+    if (lt == ExprNode::FLOAT && rt == ExprNode::INTEGER)
+        return compareFloatInteger(((FloatNode*)lhs)->value(), ((IntNode*)rhs)->value());
+
+    if (lt == ExprNode::INTEGER && rt == ExprNode::FLOAT)
+    {
+        int res = compareFloatInteger(((FloatNode*)rhs)->value(), ((IntNode*)lhs)->value());
+        return (res == 2) ? 2 : -res;
+    }
+
+    if (lt != ExprNode::FLOAT && rt != ExprNode::FLOAT)   // exact, with at least one Rational
+    {
+        Rational a = toRational(lhs), b = toRational(rhs);
+        if (a.isUndef() || b.isUndef())
+            return 2;
+
+        int res = a.compare(b);
+        return (res > 0) - (res < 0);
+    }
+
+    Float a = toFloat(lhs), b = toFloat(rhs);
+    if (a.isNaN() || b.isNaN())
+        return 2;
+
+    int res = mpfr_cmp(a.data(), b.data());
+    return (res > 0) - (res < 0);
+}
+
+unsigned comparatorMask(const std::string& op)
+{
+    // Bit (sign + 1) accepts lhs - rhs with that sign. Unordered values satisfy nothing.
+    if (op == ">")      return 0x4;
+    if (op == "<")      return 0x1;
+    if (op == ">=")     return 0x6;
+    if (op == "<=")     return 0x3;
+    if (op == "!=")     return 0x5;
+    return 0;
+}
+
+bool compareNumbers(ExprNode* lhs, ExprNode* rhs, const std::string& op)
+{
+    unsigned mask = comparatorMask(op);
+    if (mask == 0)
+    {
+        gErrorManager.log("Expected a comparator " + toInfixString(lhs) + op + toInfixString(rhs), ErrorManager::ERROR, __FILE__, __LINE__);
+        return false;
+    }
+
+    return mask & (1u << (compareNumbers(lhs, rhs) + 1));
+}
+
+// Collects the operands and comparators of a chain of comparisons, either flat, (< a b c), or
+// nested, (< (<= a b) c), without copying. Returns false if the expression is not a chain.
+static bool chainOperands(ExprNode* expr, std::vector<ExprNode*>& operands, std::vector<unsigned>& masks)
+{
+    unsigned mask = expr->isOperator() ? comparatorMask(((OpNode*)expr)->name()) : 0;
+    if (mask == 0 || mask == comparatorMask("!=") || expr->children().size() < 2)
+        return false;
+
+    auto it = expr->children().begin();
+    if (!chainOperands(*it, operands, masks))
+        operands.push_back(*it);
+    for (++it; it != expr->children().end(); ++it)
+    {
+        operands.push_back(*it);
+        masks.push_back(mask);
+    }
+
+    return true;
+}
+
+ExprNode* inequalityChain(ExprNode* expr)
+{
+    std::vector<ExprNode*> operands;
+    std::vector<unsigned> masks;
+    if (!chainOperands(expr, operands, masks))
+        return expr;
+
+    // One sweep: compare adjacent numbers and find the symbolic operands
+    bool holds = true;
+    size_t symbolic = 0, last = 0;
+    for (size_t i = 0; holds && i < operands.size(); ++i)
+    {
+        if (!operands[i]->isNumber())
+        {
+            ++symbolic;
+            last = i;
+        }
+        else if (i + 1 < operands.size() && operands[i + 1]->isNumber())
+        {
+            holds = masks[i] & (1u << (compareNumbers(operands[i], operands[i + 1]) + 1));
+        }
+    }
+
+    if (!holds || symbolic == 0)
+    {
+        ExprNode* res = new BoolNode(holds, expr->parent());
+        freeExpression(expr);
+        return res;
+    }
+
+    // With one symbolic operand in a flat chain, only its neighbors bound it: (< 1 2 x 5 7) ==> (< 2 x 5)
+    if (symbolic == 1 && operands.size() > 3 && operands.size() == expr->children().size())
+    {
+        size_t first = (last == 0) ? 0 : last - 1;
+        size_t end = std::min(last + 2, operands.size());
+        auto it = expr->children().begin();
+        for (size_t i = 0; i < operands.size(); ++i)
+        {
+            if (i < first || i >= end)
+            {
+                freeExpression(*it);
+                it = expr->children().erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    return expr;
 }
 
 ExprNode* inequalityNotEq(ExprNode* op)
@@ -200,7 +434,7 @@ ExprNode* inequalityNotEq(ExprNode* op)
     }
 
     // TODO: any expression more complex will require a proper "theorem prover"
-    return op;
+    return inequalityPolynomial(op, "!=");
 }
 
 ExprNode* inequalityCompare(ExprNode* expr, const std::string& op)
@@ -211,68 +445,440 @@ ExprNode* inequalityCompare(ExprNode* expr, const std::string& op)
         return expr;
     }
 
-    bool isValid = true;
-    for (auto it = expr->children().begin(); it != std::prev(expr->children().end()); ++it)
+    expr = inequalityChain(expr);
+    if (expr->type() == ExprNode::BOOLEAN)
+        return expr;
+
+    return inequalityPolynomial(expr, op);
+}
+
+Range polynomialRange(const DensePoly& p, const std::string& op)
+{
+    auto holds = [&](int sign) {
+        if (op == ">")      return sign > 0;
+        if (op == "<")      return sign < 0;
+        if (op == ">=")     return sign >= 0;
+        if (op == "<=")     return sign <= 0;
+        if (op == "!=")     return sign != 0;
+        return false;
+    };
+
+    if (p.degree() < 1)
     {
-        auto it2 = std::next(it);
-        if ((*it)->isNumber() && (*it2)->isNumber() && !compareNumbers(*it, *it2, op))
-            isValid = false;
+        int sign = p.isZero() ? 0 : (p.data().front().sign() ? -1 : 1);
+        return holds(sign) ? Range(INTERVAL_REALS) : Range();
     }
-    
-    auto pred = [](ExprNode* node) { return node->isNumber(); };
-    if (std::all_of(expr->children().begin(), expr->children().end(), pred))
+
+    // The sign is constant between consecutive roots: read it from the leading coefficient on the
+    // unbounded pieces and at a rational point between the isolating intervals otherwise
+    DensePoly sqf = squarefreePart(p);
+    std::vector<RootInterval> roots = isolateRealRoots(p);
+    std::vector<Float> values;
+    for (const auto& r : roots)
+        values.push_back(refineRoot(sqf, r));
+
+    int lead = p.data().back().sign() ? -1 : 1;
+    std::vector<interval_t> ivals;
+    for (size_t i = 0; i <= roots.size(); ++i)
     {
-        ExprNode* node = new BoolNode(isValid, expr->parent());
-        freeExpression(expr);
-        return node;
+        int sign;
+        if (i == roots.size())
+        {
+            sign = lead;
+        }
+        else if (i == 0)
+        {
+            sign = (p.degree() % 2 == 0) ? lead : -lead;
+        }
+        else
+        {
+            const Rational& left = roots[i - 1].exact ? roots[i - 1].lower : roots[i - 1].upper;
+            const Rational& right = roots[i].lower;
+            sign = signAt(p, (left < right) ? (left + right) / Rational(Integer(2)) : left);
+        }
+
+        if (holds(sign))
+        {
+            Endpoint lower = (i == 0) ? Endpoint("-inf") : Endpoint(values[i - 1]);
+            Endpoint upper = (i == roots.size()) ? Endpoint("inf") : Endpoint(values[i]);
+            ivals.push_back({ lower, upper, false, false });
+        }
     }
 
-    if (!isValid)
+    if (holds(0))
     {
-        ExprNode* node = new BoolNode(false, expr->parent());
-        freeExpression(expr);
-        return node;
+        for (const auto& v : values)
+            ivals.push_back({ v, v, true, true });
     }
 
-    return expr;
+    return Range(std::move(ivals));
+}
+
+ExprNode* inequalityPolynomial(ExprNode* expr, const std::string& op)
+{
+    std::string var;
+    if (expr->children().size() != 2 || isRangeBound(expr, var))
+        return expr;
+
+    std::list<std::string> vars = extractVariables(expr);
+    vars.sort();
+    vars.unique();
+    if (vars.size() != 1)
+        return expr;
+
+    // Rational coefficients are cleared by multiplying both sides by the positive lcm of the denominators
+    DensePoly lhs, rhs;
+    Integer ld, rd;
+    if (!toDensePoly(expr->children().front(), vars.front(), lhs, ld) ||
+        !toDensePoly(expr->children().back(), vars.front(), rhs, rd))
+        return expr;
+
+    Integer l = (ld / gcd(ld, rd)) * rd;
+    lhs *= DensePoly(l / ld);
+    rhs *= DensePoly(l / rd);
+
+    ExprNode* res = toExpression(polynomialRange(lhs - rhs, op), vars.front());
+    res->setParent(expr->parent());
+    freeExpression(expr);
+    return res;
+}
+
+// Linear form sum coeffs[v] * v + constant.
+struct LinearForm
+{
+    std::map<std::string, Rational> coeffs;
+    Rational constant;
+};
+
+// Returns the exact value of a number.
+static Rational exactValue(ExprNode* expr)
+{
+    return (expr->type() == ExprNode::FLOAT) ? floatToRational(((FloatNode*)expr)->value()) : toRational(expr);
+}
+
+// Adds scale * expr to a linear form. Returns false if the expression is not linear.
+static bool addLinear(ExprNode* expr, const Rational& scale, LinearForm& form)
+{
+    if (expr->isNumber())
+    {
+        Rational value = exactValue(expr);
+        if (value.isUndef())
+            return false;
+
+        form.constant += scale * value;
+        return true;
+    }
+
+    if (expr->type() == ExprNode::VARIABLE)
+    {
+        form.coeffs[((VarNode*)expr)->name()] += scale;
+        return true;
+    }
+
+    if (!expr->isOperator())
+        return false;
+
+    const std::string& name = ((OpNode*)expr)->name();
+    if (name == "+" || name == "-")
+    {
+        for (auto it = expr->children().begin(); it != expr->children().end(); ++it)
+        {
+            bool negate = (name == "-" && it != expr->children().begin());
+            if (!addLinear(*it, negate ? -scale : scale, form))
+                return false;
+        }
+
+        return true;
+    }
+
+    if (name == "-*" && expr->children().size() == 1)
+        return addLinear(expr->children().front(), -scale, form);
+
+    if (name == "*" || name == "**")   // at most one factor is not a number
+    {
+        Rational product = scale;
+        ExprNode* term = nullptr;
+        for (auto e : expr->children())
+        {
+            if (e->isNumber())          product *= exactValue(e);
+            else if (term == nullptr)   term = e;
+            else                        return false;
+        }
+
+        if (product.isUndef())
+            return false;
+        if (term == nullptr)
+            form.constant += product;
+        return term == nullptr || addLinear(term, product, form);
+    }
+
+    if (name == "/" && expr->children().size() == 2 && expr->children().back()->isNumber())
+    {
+        Rational value = exactValue(expr->children().back());
+        if (value.isUndef() || value.isZero())
+            return false;
+        return addLinear(expr->children().front(), scale / value, form);
+    }
+
+    return false;
+}
+
+// Reads a linear inequality (? lhs rhs) as form < 0, or form <= 0 if not strict. Zero coefficients
+// are dropped. Returns false if the expression is not a linear inequality.
+static bool readLinear(ExprNode* lhs, ExprNode* rhs, const std::string& name, LinearForm& form, bool& strict)
+{
+    Rational one(Integer(1));
+    bool flip = (name == ">" || name == ">=");
+    if (!addLinear(lhs, flip ? -one : one, form) || !addLinear(rhs, flip ? one : -one, form))
+        return false;
+
+    for (auto it = form.coeffs.begin(); it != form.coeffs.end();)
+    {
+        if (it->second.isZero())    it = form.coeffs.erase(it);
+        else                        ++it;
+    }
+
+    strict = (name == ">" || name == "<");
+    return true;
+}
+
+// Reads an inequality, or each link of a chain (op a b c ...), as linear forms.
+static bool readLinear(ExprNode* expr, std::vector<LinearForm>& forms, std::vector<bool>& stricts)
+{
+    if (!isInequalityNode(expr) || expr->children().size() < 2)
+        return false;
+
+    const std::string& name = ((OpNode*)expr)->name();
+    if (name == "!=")
+        return false;
+
+    for (auto it = expr->children().begin(), it2 = std::next(it); it2 != expr->children().end(); ++it, ++it2)
+    {
+        LinearForm form;
+        bool strict;
+        if (!readLinear(*it, *it2, name, form, strict))
+            return false;
+
+        forms.push_back(std::move(form));
+        stricts.push_back(strict);
+    }
+
+    return true;
+}
+
+// Adds the form to a system over the variables in 'index'.
+static void addLinear(LinearSystem& system, const LinearForm& form, bool strict, const std::map<std::string, size_t>& index)
+{
+    std::vector<Rational> coeffs(index.size());
+    for (const auto& e : form.coeffs)
+        coeffs[index.at(e.first)] = e.second;
+    system.add(coeffs, -form.constant, strict);
+}
+
+bool toLinearSystem(ExprNode* expr, LinearSystem& system, std::vector<std::string>& vars)
+{
+    std::vector<ExprNode*> children;
+    if (expr->isOperator() && ((OpNode*)expr)->name() == "and")
+        children.assign(expr->children().begin(), expr->children().end());
+    else
+        children.push_back(expr);
+
+    std::vector<LinearForm> forms;
+    std::vector<bool> stricts;
+    std::map<std::string, size_t> index;
+    for (auto e : children)
+    {
+        if (!readLinear(e, forms, stricts))
+            return false;
+    }
+
+    for (const auto& form : forms)
+    {
+        for (const auto& e : form.coeffs)
+            index.emplace(e.first, 0);
+    }
+
+    vars.clear();
+    for (auto& e : index)
+    {
+        e.second = vars.size();
+        vars.push_back(e.first);
+    }
+
+    system = LinearSystem(vars.size());
+    for (size_t i = 0; i < forms.size(); ++i)
+        addLinear(system, forms[i], stricts[i], index);
+    return true;
+}
+
+Range linearRange(const LinearSystem& system, size_t var)
+{
+    LinearBound lower, upper;
+    if (!system.project(var, lower, upper))
+        return Range();
+
+    interval_t ival = INTERVAL_REALS;
+    if (!lower.infinite)
+    {
+        ival.lower = rationalToFloat(lower.value);
+        ival.lowerClosed = lower.closed;
+    }
+
+    if (!upper.infinite)
+    {
+        ival.upper = rationalToFloat(upper.value);
+        ival.upperClosed = upper.closed;
+    }
+
+    return Range(ival);
+}
+
+// Solves the linear inequalities of a conjunction together if some of them bound two or more
+// variables. Returns false if they have no common solution. Otherwise, small systems are reduced
+// by removing every inequality implied by the others.
+static bool linearConjunction(ExprNode* expr)
+{
+    std::vector<std::list<ExprNode*>::iterator> nodes;
+    std::vector<size_t> owners;     // node of each constraint: a chain a < x < b is two
+    std::vector<LinearForm> forms;
+    std::vector<bool> stricts;
+    std::map<std::string, size_t> index;
+    bool multivariate = false;
+    for (auto it = expr->children().begin(); it != expr->children().end(); ++it)
+    {
+        size_t count = forms.size();
+        if (!readLinear(*it, forms, stricts))
+        {
+            forms.resize(count);
+            stricts.resize(count);
+            continue;
+        }
+
+        for (size_t i = count; i < forms.size(); ++i)
+        {
+            multivariate |= (forms[i].coeffs.size() > 1);
+            for (const auto& e : forms[i].coeffs)
+                index.emplace(e.first, 0);
+            owners.push_back(nodes.size());
+        }
+
+        nodes.push_back(it);
+    }
+
+    if (!multivariate)  // univariate bounds are merged as Ranges
+        return true;
+
+    size_t var = 0;
+    for (auto& e : index)
+        e.second = var++;
+
+    LinearSystem system(index.size());
+    for (size_t i = 0; i < forms.size(); ++i)
+        addLinear(system, forms[i], stricts[i], index);
+
+    if (!system.feasible())
+        return false;
+
+    if (forms.size() <= MATHSOLVER_LINEAR_REDUCE_MAX)
+    {
+        // A node is dropped only if every one of its constraints is implied by the others
+        std::vector<bool> keep(nodes.size(), false);
+        for (size_t k : system.reduce())
+            keep[owners[k]] = true;
+
+        for (size_t i = 0; i < nodes.size(); ++i)
+        {
+            if (!keep[i])
+            {
+                freeExpression(*nodes[i]);
+                expr->children().erase(nodes[i]);
+            }
+        }
+    }
+
+    return true;
 }
 
 ExprNode* inequalityConnective(ExprNode* expr, const std::string& op)
 {
+    // Bounds on the same variable are folded into one range, kept at the position of the first
+    // bound, and converted back to an expression once every child has been seen.
+    struct Bucket
+    {
+        Range range;
+        std::list<ExprNode*>::iterator first;
+        bool merged;
+    };
+
+    // (and (and a b) c) ==> (and a b c), e.g. from an expanded chain
+    for (auto it = expr->children().begin(); it != expr->children().end();)
+    {
+        if ((*it)->isOperator() && ((OpNode*)*it)->name() == op && (op == "and" || op == "or"))
+        {
+            for (auto e : (*it)->children())
+                e->setParent(expr);
+            expr->children().splice(std::next(it), (*it)->children());
+            delete *it;
+            it = expr->children().erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    std::map<std::string, Bucket> buckets;
+    std::string var;
+    Range range;
     auto it = expr->children().begin();
     while (it != expr->children().end())
     {
-        auto it2 = std::next(it);
-        bool changed = false;
-        while (it2 != expr->children().end())
+        if (!readRange(*it, var, range))   // (and (x ? a) (x ? b) ...) where a,b are numbers
         {
-            std::list<std::string> lvars = extractVariables(*it);
-            std::list<std::string> rvars = extractVariables(*it2);
-            if (lvars.size() == 1 && rvars.size() == 1 && // (and (x ? a) (x ? b) ...) where a,b are numbers
-                lvars.front() == rvars.front())
-            {
-                Range lhs = extractRange(*it);
-                Range rhs = extractRange(*it2);
-                ExprNode* res;
-                
-                if (op == "and")        res = toExpression(lhs.conjoin(rhs), lvars.front());
-                else if (op == "or")    res = toExpression(lhs.disjoin(rhs), lvars.front());
-                res->setParent(expr);
-
-                freeExpression(*it2);
-                freeExpression(*it);
-                it = expr->children().erase(it);
-                it = expr->children().insert(it, res);
-                it2 = expr->children().erase(it2);   
-                changed = true;
-            }
-            else
-            {
-                ++it2;
-            }
+            ++it;
+            continue;
         }
 
-        if (!changed) ++it;
+        auto b = buckets.find(var);
+        if (b == buckets.end())
+        {
+            buckets.emplace(var, Bucket{ std::move(range), it, false });
+            ++it;
+        }
+        else
+        {
+            Bucket& bucket = b->second;
+            if (op == "and")        bucket.range = bucket.range.conjoin(range);
+            else if (op == "or")    bucket.range = bucket.range.disjoin(range);
+            bucket.merged = true;
+            freeExpression(*it);
+            it = expr->children().erase(it);
+        }
+    }
+
+    for (auto& e : buckets)
+    {
+        if (!e.second.merged)
+            continue;
+
+        if (op == "and" && e.second.range.data().empty())  // ex: (and (x > 5) (y > 0) (x < 2)) ==> false
+        {
+            ExprNode* res = new BoolNode(false, expr->parent());
+            freeExpression(expr);
+            return res;
+        }
+
+        ExprNode* res = toExpression(e.second.range, e.first);
+        res->setParent(expr);
+        freeExpression(*e.second.first);
+        *e.second.first = res;
+    }
+
+    if (op == "and" && !linearConjunction(expr))  // ex: (and (x + y < 3) (x > 2) (y > 1)) ==> false
+    {
+        ExprNode* res = new BoolNode(false, expr->parent());
+        freeExpression(expr);
+        return res;
     }
 
     if (expr->children().size() == 1) // ex: (and (x > a)) ==> x
@@ -3,6 +3,12 @@
 
 #include "../common/base.h"
 #include "../expr/expr.h"
+#include "../math/simplex.h"
+#include "../types/poly.h"
+
+// Conjunctions of at most this many linear inequalities in several variables are reduced to an
+// irredundant system when evaluated. Larger ones are only checked for feasibility.
+#define MATHSOLVER_LINEAR_REDUCE_MAX    32
 
 namespace MathSolver
 {
@@ -17,9 +23,39 @@ ExprNode* toExpression(const interval_t& ival, const std::string& var);
 // Converts a univariate Range to an expression.
 ExprNode* toExpression(const Range& range, const std::string& var);
 
+// Returns the sign of lhs - rhs for two numbers (-1, 0 or 1), or 2 if they are unordered. Integers
+// and Floats are compared exactly without conversion.
+int compareNumbers(ExprNode* lhs, ExprNode* rhs);
+
 // Returns true if the two numbers satisfy the given comparison.
 bool compareNumbers(ExprNode* lhs, ExprNode* rhs, const std::string& op);
 
+// Returns the signs of lhs - rhs accepted by a comparator as a bit mask: bit (sign + 1) for each
+// accepted sign. Returns 0 for anything else.
+unsigned comparatorMask(const std::string& op);
+
+// Evaluates the numeric part of a chain of comparisons, flat (< 1 2 3) or with mixed comparators
+// (< (<= 1 2) 3), in one sweep without copying. Returns a boolean if the chain is decided. A flat
+// chain with one symbolic operand is trimmed to its neighbors, otherwise the chain is unchanged.
+ExprNode* inequalityChain(ExprNode* expr);
+
+// Returns the set of real x where p(x) ? 0 for a comparator '?'. The real roots of p are isolated
+// exactly and the sign is read between them. Roots are rounded to the default Float precision.
+Range polynomialRange(const DensePoly& p, const std::string& op);
+
+// Solves (? lhs rhs) where both sides are polynomials in one variable with integer coefficients,
+// e.g. x^3 - 2x + 1 > 0, and returns the solution as bounds on the variable. Simple bounds such as
+// x > 1 and other inequalities are returned unchanged.
+ExprNode* inequalityPolynomial(ExprNode* expr, const std::string& op);
+
+// Reads a linear inequality or a conjunction of them, e.g. x + y < 3 and x - y > 1, into a system
+// over 'vars', the variables in sorted order. Returns false if some part is not linear.
+bool toLinearSystem(ExprNode* expr, LinearSystem& system, std::vector<std::string>& vars);
+
+// Returns the projection of a linear system onto one of its variables. Endpoints are rounded to
+// the default Float precision.
+Range linearRange(const LinearSystem& system, size_t var);
+
 // Comparator operators
 ExprNode* inequalityNotEq(ExprNode* expr);
 ExprNode* inequalityCompare(ExprNode* expr, const std::string& op);
@@ -1,9 +1,17 @@
+#include <algorithm>
 #include "inequality.h"
 #include "inequalityrr.h"
 
 namespace MathSolver
 {
 
+// Returns true if the expression is a number or a chain of comparisons between numbers.
+static bool isNumericChain(ExprNode* expr)
+{
+    return expr->isNumber() || (isInequalityNode(expr) &&
+           std::all_of(expr->children().begin(), expr->children().end(), isNumericChain));
+}
+
 ExprNode* rewriteInequalityCommon(ExprNode* op)
 {
     if (op->children().size() < 2)     
@@ -13,6 +21,15 @@ ExprNode* rewriteInequalityCommon(ExprNode* op)
         return op;
     }
 
+    // A numeric link of a longer chain (< (<= 1 2) 3) is evaluated with the rest of the chain
+    ExprNode* parent = op->parent();
+    if (parent && parent->isOperator() && comparatorMask(((OpNode*)parent)->name()) != 0 && isNumericChain(op))
+        return op;
+
+    op = inequalityChain(op);   // numeric comparisons are evaluated in one sweep
+    if (op->type() == ExprNode::BOOLEAN)
+        return op;
+
     if (op->children().size() == 2) 
     {      
         if (op->children().front()->isOperator() && ((OpNode*)op->children().front())->name() == "and")
@@ -3,10 +3,35 @@
 #include "evaluator.h"
 #include "inequality.h"
 #include "interval.h"
+#include "predicate.h"
 
 namespace MathSolver
 {
 
+// Returns true if the node is a child of an 'and' or 'or'. Set builders below it are compiled
+// together with the rest of the connective.
+static bool isConnectiveChild(ExprNode* op)
+{
+    ExprNode* parent = op->parent();
+    return parent != nullptr && parent->isOperator() &&
+           (((OpNode*)parent)->name() == "and" || ((OpNode*)parent)->name() == "or");
+}
+
+// Solves a set builder within the interactive budget.
+static ExprNode* setBuild(ExprNode* op)
+{
+    BisectionOptions opts;
+    opts.maxBoxes = MATHSOLVER_SETBUILD_MAX_BOXES;
+    opts.maxSeconds = MATHSOLVER_SETBUILD_MAX_SECONDS;
+    return isConnectiveChild(op) ? op : evaluateSetBuilder(op, opts);
+}
+
+// Returns true if every child is a Range.
+static bool isRangeList(ExprNode* op)
+{
+    return std::all_of(op->children().begin(), op->children().end(), [](ExprNode* node) { return node->type() == ExprNode::RANGE; });
+}
+
 ExprNode* rangeOr(ExprNode* op)
 {
     if (op->children().size() < 2)     
@@ -15,11 +40,14 @@ ExprNode* rangeOr(ExprNode* op)
         return op;
     }
 
-    Range accum = ((RangeNode*)op->children().front())->value();
-    for (auto itr = std::next(op->children().begin()); itr != op->children().end(); ++itr)
-        accum = accum.disjoin(((RangeNode*)*itr)->value());
-    
-    RangeNode* ret = new RangeNode(accum, op->parent());
+    if (!isRangeList(op))   // set builders, solved with one compiled predicate
+        return setBuild(op);
+
+    std::vector<const Range*> ranges;
+    for (auto e : op->children())
+        ranges.push_back(&((RangeNode*)e)->value());
+
+    RangeNode* ret = new RangeNode(Range::disjoin(ranges), op->parent());
     freeExpression(op);
     return ret;
 }
@@ -32,11 +60,14 @@ ExprNode* rangeAnd(ExprNode* op)
         return op;
     }
 
-    Range accum = ((RangeNode*)op->children().front())->value();
-    for (auto itr = std::next(op->children().begin()); itr != op->children().end(); ++itr)
-        accum = accum.conjoin(((RangeNode*)*itr)->value());
-    
-    RangeNode* ret = new RangeNode(accum, op->parent());
+    if (!isRangeList(op))   // set builders, solved with one compiled predicate
+        return setBuild(op);
+
+    std::vector<const Range*> ranges;
+    for (auto e : op->children())
+        ranges.push_back(&((RangeNode*)e)->value());
+
+    RangeNode* ret = new RangeNode(Range::conjoin(ranges), op->parent());
     freeExpression(op);
     return ret;
 }
@@ -65,7 +96,7 @@ ExprNode* rangeSetBuild(ExprNode* op)
         return node;
     }
 
-    return op;
+    return setBuild(op);
 }
 
 //
@@ -4,6 +4,11 @@
 #include "../common/base.h"
 #include "../expr/expr.h"
 
+// Budget for solving a set builder while evaluating an expression. The library-wide
+// bisection defaults are for batch use and would block an interactive session.
+#define MATHSOLVER_SETBUILD_MAX_SECONDS     0.25
+#define MATHSOLVER_SETBUILD_MAX_BOXES       (1 << 16)
+
 namespace MathSolver
 {
 
@@ -0,0 +1,418 @@
+#include <algorithm>
+#include <cstdlib>
+#include "polyeval.h"
+
+namespace MathSolver
+{
+
+using TermMap = std::map<std::string, unsigned int>;
+
+// Multiplies the coefficient and exponents by a monomial in standard form. Returns false
+// if the expression is not a monomial with number coefficients.
+bool monomialTerm(ExprNode* expr, Float& coeff, TermMap& exps)
+{
+    if (expr->isNumber())
+    {
+        coeff *= toFloat(expr);
+        return true;
+    }
+
+    if (expr->type() == ExprNode::VARIABLE)
+    {
+        ++exps[((VarNode*)expr)->name()];
+        return true;
+    }
+
+    if (!expr->isOperator())
+        return false;
+
+    const std::string& name = ((OpNode*)expr)->name();
+    if (name == "-*" && expr->children().size() == 1)
+    {
+        coeff = -coeff;
+        return monomialTerm(expr->children().front(), coeff, exps);
+    }
+
+    if (name == "/" && expr->children().size() == 2)
+    {
+        if (!expr->children().back()->isNumber() || !monomialTerm(expr->children().front(), coeff, exps))
+            return false;
+        coeff /= toFloat(expr->children().back());
+        return true;
+    }
+
+    if (name == "^" && expr->children().size() == 2)
+    {
+        ExprNode* base = expr->children().front();
+        ExprNode* exp = expr->children().back();
+        if (base->type() != ExprNode::VARIABLE || exp->type() != ExprNode::INTEGER || ((IntNode*)exp)->value().sign())
+            return false;
+        exps[((VarNode*)base)->name()] += ((IntNode*)exp)->value().toInt();
+        return true;
+    }
+
+    if (name == "*" || name == "**")
+    {
+        for (auto e : expr->children())
+        {
+            if (!monomialTerm(e, coeff, exps))
+                return false;
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+// Appends the terms of a polynomial in standard form. Returns false if the expression is not a
+// polynomial with number coefficients.
+bool polynomialTerms(ExprNode* expr, bool neg, std::vector<std::pair<TermMap, Float>>& terms)
+{
+    if (expr->isOperator() && (((OpNode*)expr)->name() == "+" || ((OpNode*)expr)->name() == "-"))
+    {
+        bool sub = (((OpNode*)expr)->name() == "-");
+        for (auto it = expr->children().begin(); it != expr->children().end(); ++it)
+        {
+            if (!polynomialTerms(*it, (sub && it != expr->children().begin()) ? !neg : neg, terms))
+                return false;
+        }
+
+        return true;
+    }
+
+    terms.emplace_back(TermMap(), Float(neg ? "-1" : "1"));
+    return monomialTerm(expr, terms.back().second, terms.back().first);
+}
+
+// Returns the number as an integer node if it is an integer, or a float node otherwise.
+ExprNode* numberNode(const Float& f)
+{
+    if (!mpfr_integer_p(f.data()))
+        return new FloatNode(f);
+
+    mpz_t z;
+    mpz_init(z);
+    mpfr_get_z(z, f.data(), MPFR_RNDN);
+    char* str = mpz_get_str(nullptr, 10, z);
+    ExprNode* node = new IntNode(Integer(std::string(str)));
+    free(str);
+    mpz_clear(z);
+    return node;
+}
+
+//
+//  PolyProgram
+//
+
+PolyProgram::PolyProgram()
+{
+    mForm = HORNER;
+    mExact = true;
+    mResult = constant(Float("0"));
+}
+
+bool PolyProgram::lower(ExprNode* expr, Form form)
+{
+    // The inexact flag records whether any coefficient is rounded. The caller's flags are kept.
+    mpfr_flags_t flags = mpfr_flags_save();
+    mpfr_clear_inexflag();
+
+    std::vector<std::pair<TermMap, Float>> parsed;
+    if (!polynomialTerms(expr, false, parsed))
+    {
+        mpfr_flags_restore(flags, MPFR_FLAGS_ALL);
+        return false;
+    }
+
+    PolyProgram prog;
+    prog.mInstrs.clear();
+    prog.mConsts.clear();
+    prog.mConstsD.clear();
+    prog.mConstRegs.clear();
+    prog.mForm = form;
+
+    for (const auto& t : parsed)
+    {
+        for (const auto& e : t.first)
+            prog.mVars.push_back(e.first);
+    }
+
+    std::sort(prog.mVars.begin(), prog.mVars.end());
+    prog.mVars.erase(std::unique(prog.mVars.begin(), prog.mVars.end()), prog.mVars.end());
+
+    // Collect like terms, highest order first
+    std::map<std::vector<unsigned int>, Float, std::greater<std::vector<unsigned int>>> collected;
+    for (const auto& t : parsed)
+    {
+        std::vector<unsigned int> exps(prog.mVars.size(), 0);
+        for (const auto& e : t.first)
+            exps[std::lower_bound(prog.mVars.begin(), prog.mVars.end(), e.first) - prog.mVars.begin()] = e.second;
+
+        auto it = collected.find(exps);
+        if (it == collected.end())  collected.emplace(std::move(exps), t.second);
+        else                        it->second += t.second;
+    }
+
+    std::vector<Term> terms;
+    for (auto& t : collected)
+    {
+        if (!t.second.isZero())
+            terms.emplace_back(t.first, std::move(t.second));
+    }
+
+    prog.mExact = !mpfr_inexflag_p();
+    mpfr_flags_restore(flags, MPFR_FLAGS_ALL);
+
+    if (terms.empty())  prog.mResult = prog.constant(Float("0"));
+    else                prog.mResult = prog.lowerTerms(terms.data(), terms.size(), 0);
+
+    *this = std::move(prog);
+    return true;
+}
+
+double PolyProgram::evaluate(const std::vector<double>& vals) const
+{
+    if (vals.size() < mVars.size())
+    {
+        gErrorManager.log("Expected " + std::to_string(mVars.size()) + " values, got " + std::to_string(vals.size()),
+                          ErrorManager::ERROR, __FILE__, __LINE__);
+        return 0.0;
+    }
+
+    std::vector<double> r(mInstrs.size());
+    for (size_t i = 0; i < mInstrs.size(); ++i)
+    {
+        const Instr& in = mInstrs[i];
+        switch (in.op)
+        {
+        case CONST: r[i] = mConstsD[in.a];                  break;
+        case VAR:   r[i] = vals[in.a];                      break;
+        case ADD:   r[i] = r[in.a] + r[in.b];               break;
+        case MUL:   r[i] = r[in.a] * r[in.b];               break;
+        case FMA:   r[i] = r[in.a] * r[in.b] + r[in.c];     break;
+        }
+    }
+
+    return r[mResult];
+}
+
+Float PolyProgram::evaluate(const std::vector<Float>& vals) const
+{
+    if (vals.size() < mVars.size())
+    {
+        gErrorManager.log("Expected " + std::to_string(mVars.size()) + " values, got " + std::to_string(vals.size()),
+                          ErrorManager::ERROR, __FILE__, __LINE__);
+        return Float("nan");
+    }
+
+    // Constants and variables are referenced in place, so only arithmetic results need storage
+    size_t temps = std::count_if(mInstrs.begin(), mInstrs.end(), [](const Instr& in) { return in.op != CONST && in.op != VAR; });
+    std::vector<Float> r(temps);
+    std::vector<mpfr_ptr> p(mInstrs.size());
+
+    for (size_t i = 0, t = 0; i < mInstrs.size(); ++i)
+    {
+        const Instr& in = mInstrs[i];
+        switch (in.op)
+        {
+        case CONST: p[i] = mConsts[in.a].data();   break;
+        case VAR:   p[i] = vals[in.a].data();      break;
+        case ADD:
+            p[i] = r[t++].data();
+            mpfr_add(p[i], p[in.a], p[in.b], MATHSOLVER_FLOAT_DEFAULT_RND_MODE);
+            break;
+        case MUL:
+            p[i] = r[t++].data();
+            mpfr_mul(p[i], p[in.a], p[in.b], MATHSOLVER_FLOAT_DEFAULT_RND_MODE);
+            break;
+        case FMA:
+            p[i] = r[t++].data();
+            mpfr_fma(p[i], p[in.a], p[in.b], p[in.c], MATHSOLVER_FLOAT_DEFAULT_RND_MODE);
+            break;
+        }
+    }
+
+    Float res;
+    mpfr_set(res.data(), p[mResult], MATHSOLVER_FLOAT_DEFAULT_RND_MODE);
+    return res;
+}
+
+ExprNode* PolyProgram::toExpr() const
+{
+    return toExpr(mResult);
+}
+
+size_t PolyProgram::emit(Opcode op, size_t a, size_t b, size_t c)
+{
+    mInstrs.push_back({ op, a, b, c });
+    return mInstrs.size() - 1;
+}
+
+size_t PolyProgram::constant(const Float& f)
+{
+    auto it = mConstRegs.find(f);
+    if (it != mConstRegs.end())
+        return it->second;
+
+    mConsts.push_back(f);
+    mConstsD.push_back(mpfr_get_d(f.data(), MATHSOLVER_FLOAT_DEFAULT_RND_MODE));
+    size_t reg = emit(CONST, mConsts.size() - 1);
+    if (!f.isNaN())     // NaN does not compare equal to itself
+        mConstRegs[f] = reg;
+    return reg;
+}
+
+size_t PolyProgram::power(size_t var, unsigned int n)
+{
+    auto it = mPowers.find({ var, n });
+    if (it != mPowers.end())
+        return it->second;
+
+    size_t reg;
+    if (n == 1)             reg = emit(VAR, var);
+    else if (n % 2 == 0)    reg = emit(MUL, power(var, n / 2), power(var, n / 2));  // x^2k = x^k * x^k
+    else                    reg = emit(MUL, power(var, n - 1), power(var, 1));      // x^(2k+1) = x^2k * x
+
+    mPowers[{ var, n }] = reg;
+    return reg;
+}
+
+size_t PolyProgram::mul(size_t a, size_t b)
+{
+    if (isConstant(a, 1))   return b;
+    if (isConstant(b, 1))   return a;
+    return emit(MUL, a, b);
+}
+
+size_t PolyProgram::fma(size_t a, size_t b, size_t c)
+{
+    if (isConstant(c, 0))   return mul(a, b);
+    if (isConstant(a, 1))   return emit(ADD, b, c);
+    if (isConstant(b, 1))   return emit(ADD, a, c);
+    return emit(FMA, a, b, c);
+}
+
+bool PolyProgram::isConstant(size_t reg, long n) const
+{
+    return mInstrs[reg].op == CONST && mConsts[mInstrs[reg].a].compare(n) == 0;
+}
+
+size_t PolyProgram::lowerTerms(const Term* terms, size_t count, size_t var)
+{
+    if (var == mVars.size())
+        return constant(terms[0].second);
+
+    // Group by the exponent of 'var'. The coefficient of each group is a polynomial in the later variables.
+    std::vector<size_t> coeffs;
+    std::vector<unsigned int> exps;
+    for (size_t i = 0, j = 0; i < count; i = j)
+    {
+        for (j = i + 1; j < count && terms[j].first[var] == terms[i].first[var]; ++j);
+        coeffs.push_back(lowerTerms(terms + i, j - i, var + 1));
+        exps.push_back(terms[i].first[var]);
+    }
+
+    if (mForm == ESTRIN && exps.front() + 1 >= MATHSOLVER_ESTRIN_THRESHOLD && 2 * coeffs.size() > exps.front() + 1)
+    {
+        std::vector<size_t> dense(exps.front() + 1, constant(Float("0")));
+        for (size_t i = 0; i < coeffs.size(); ++i)
+            dense[exps[i]] = coeffs[i];
+        return lowerEstrin(dense, var);
+    }
+
+    // c_n x^(n-m) ... + c_m, then multiply by x^m
+    size_t acc = coeffs.front();
+    for (size_t i = 1; i < coeffs.size(); ++i)
+        acc = fma(acc, power(var, exps[i - 1] - exps[i]), coeffs[i]);
+
+    if (exps.back() > 0)
+        acc = mul(acc, power(var, exps.back()));
+    return acc;
+}
+
+size_t PolyProgram::lowerEstrin(const std::vector<size_t>& coeffs, size_t var)
+{
+    // Pairs are combined with x, then x^2, x^4, ...: (c0 + c1 x) + (c2 + c3 x) x^2 + ...
+    std::vector<size_t> level(coeffs);
+    for (unsigned int step = 1; level.size() > 1; step *= 2)
+    {
+        std::vector<size_t> next;
+        size_t x = power(var, step);
+        for (size_t i = 0; i + 1 < level.size(); i += 2)
+            next.push_back(fma(level[i + 1], x, level[i]));
+        if (level.size() % 2 == 1)
+            next.push_back(level.back());
+        level = std::move(next);
+    }
+
+    return level.front();
+}
+
+ExprNode* PolyProgram::toExpr(size_t reg) const
+{
+    const Instr& in = mInstrs[reg];
+    if (in.op == CONST)
+        return numberNode(mConsts[in.a]);
+
+    if (in.op == VAR)
+        return new VarNode(mVars[in.a]);
+
+    for (const auto& e : mPowers)
+    {
+        if (e.second == reg)   // x^n
+        {
+            ExprNode* pow = new OpNode("^");
+            pow->children().push_back(new VarNode(mVars[e.first.first], pow));
+            pow->children().push_back(new IntNode(Integer((int)e.first.second), pow));
+            return pow;
+        }
+    }
+
+    if (in.op == MUL && isConstant(in.a, -1))
+        return binaryNode("-*", in.b, mInstrs.size());
+
+    if (in.op == FMA && isConstant(in.a, -1))     // -b + c ==> c - b
+        return binaryNode("-", in.c, in.b);
+
+    if (in.op == MUL)
+        return binaryNode("*", in.a, in.b);
+
+    ExprNode* lhs = (in.op == ADD) ? toExpr(in.a) : binaryNode("*", in.a, in.b);
+    ExprNode* add = new OpNode("+");
+    ExprNode* c;
+    size_t creg = (in.op == ADD) ? in.b : in.c;
+    if (mInstrs[creg].op == CONST && mConsts[mInstrs[creg].a].sign())  // a + -c ==> a - c
+    {
+        ((OpNode*)add)->setName("-");
+        c = numberNode(-mConsts[mInstrs[creg].a]);
+    }
+    else
+    {
+        c = toExpr(creg);
+    }
+
+    lhs->setParent(add);
+    c->setParent(add);
+    add->children().push_back(lhs);
+    add->children().push_back(c);
+    return add;
+}
+
+ExprNode* PolyProgram::binaryNode(const std::string& op, size_t a, size_t b) const
+{
+    ExprNode* node = new OpNode(op);
+    for (size_t r : { a, b })
+    {
+        if (r == mInstrs.size())    // unary
+            continue;
+
+        ExprNode* child = toExpr(r);
+        child->setParent(node);
+        node->children().push_back(child);
+    }
+
+    return node;
+}
+
+}
@@ -0,0 +1,119 @@
+#ifndef _MATHSOLVER_POLYEVAL_H_
+#define _MATHSOLVER_POLYEVAL_H_
+
+#include <map>
+#include <string>
+#include <vector>
+#include "../common/base.h"
+#include "../expr/expr.h"
+#include "../types/float.h"
+
+// Dense univariate runs with at least this many coefficients are lowered in Estrin form
+// when the program is built with PolyProgram::ESTRIN
+#define MATHSOLVER_ESTRIN_THRESHOLD     8
+
+namespace MathSolver
+{
+
+// A polynomial lowered to a straight-line program for repeated numeric evaluation. The polynomial
+// is written in nested Horner form, x(x(2x+3)+1)+4, with the leading variable outermost. Every
+// power of a variable and every distinct constant is computed once and shared between terms.
+class PolyProgram
+{
+public:
+
+    enum Form
+    {
+        HORNER,     // c0 + x(c1 + x(c2 + ...))
+        ESTRIN      // (c0 + c1 x) + x^2 (c2 + c3 x) + ... for dense runs of constants
+    };
+
+    enum Opcode
+    {
+        CONST,      // r = const[a]
+        VAR,        // r = var[a]
+        ADD,        // r = r[a] + r[b]
+        MUL,        // r = r[a] * r[b]
+        FMA         // r = r[a] * r[b] + r[c]
+    };
+
+    struct Instr
+    {
+        Opcode op;
+        size_t a, b, c;
+    };
+
+public:
+
+    // Constructs the zero polynomial.
+    PolyProgram();
+
+    // Lowers a polynomial in standard form (see isPolynomial) with number coefficients. Returns
+    // false and leaves this program unchanged if the expression is not such a polynomial.
+    bool lower(ExprNode* expr, Form form = HORNER);
+
+    // Evaluates the polynomial. The values are given in the order of variables().
+    double evaluate(const std::vector<double>& vals) const;
+    Float evaluate(const std::vector<Float>& vals) const;
+
+    // Returns the program as an expression in Horner or Estrin form. Shared powers are copied.
+    ExprNode* toExpr() const;
+
+    // Returns the instructions.
+    inline const std::vector<Instr>& instructions() const { return mInstrs; }
+
+    // Returns the constants referenced by CONST instructions.
+    inline const std::vector<Float>& constants() const { return mConsts; }
+
+    // Returns true if no coefficient was rounded while collecting like terms, so the program
+    // computes exactly the lowered polynomial.
+    inline bool exact() const { return mExact; }
+
+    // Returns the register holding the value of the polynomial.
+    inline size_t result() const { return mResult; }
+
+    // Returns the variables of the polynomial in sorted order.
+    inline const std::vector<std::string>& variables() const { return mVars; }
+
+private:
+
+    using Term = std::pair<std::vector<unsigned int>, Float>;
+
+    // Appends an instruction and returns its register.
+    size_t emit(Opcode op, size_t a = 0, size_t b = 0, size_t c = 0);
+
+    // Returns the register holding the constant or the variable power, emitting it if needed.
+    size_t constant(const Float& f);
+    size_t power(size_t var, unsigned int n);
+
+    // Emits r[a] * r[b] and r[a] * r[b] + r[c], skipping multiplication by one and addition of zero.
+    size_t mul(size_t a, size_t b);
+    size_t fma(size_t a, size_t b, size_t c);
+
+    // Returns true if the register holds the given constant.
+    bool isConstant(size_t reg, long n) const;
+
+    // Emits the terms, sorted from highest to lowest order, as a polynomial in the variables
+    // starting from 'var'. Returns the register of the result.
+    size_t lowerTerms(const Term* terms, size_t count, size_t var);
+    size_t lowerEstrin(const std::vector<size_t>& coeffs, size_t var);
+
+    // Returns the expression computed by a register. A register of instructions().size() is ignored.
+    ExprNode* toExpr(size_t reg) const;
+    ExprNode* binaryNode(const std::string& op, size_t a, size_t b) const;
+
+private:
+    std::vector<Instr> mInstrs;
+    std::vector<Float> mConsts;
+    std::vector<double> mConstsD;
+    std::vector<std::string> mVars;
+    std::map<Float, size_t> mConstRegs;
+    std::map<std::pair<size_t, unsigned int>, size_t> mPowers;
+    size_t mResult;
+    Form mForm;
+    bool mExact;
+};
+
+}
+
+#endif
@@ -0,0 +1,464 @@
+#include <algorithm>
+#include "../expr/polynomial.h"
+#include "../math/interval-math.h"
+#include "enclosure.h"
+#include "inequality.h"
+#include "polyeval.h"
+#include "predicate.h"
+
+namespace MathSolver
+{
+
+// Returns true if the node is a set builder { x | p(x) }.
+static bool isSetBuilder(ExprNode* expr)
+{
+    return expr->isSyntax() && ((SyntaxNode*)expr)->name() == "|" && expr->children().size() == 2 &&
+           expr->children().front()->type() == ExprNode::VARIABLE;
+}
+
+// Classifies the interval [x.lower, x.upper] against a Range.
+static Verdict rangeVerdict(const Range& range, const Interval& x)
+{
+    interval_t box{ Endpoint(x.lower()), Endpoint(x.upper()), true, true };
+    for (const auto& ival : range.data())
+    {
+        if (contains(ival, box))            return SATISFIED;
+        if (isIntersecting(ival, box))      return UNDECIDED;
+    }
+
+    return VIOLATED;
+}
+
+// Returns the values of x with the sign of x - bound accepted by a comparatorMask.
+static Range signRange(const Float& bound, unsigned mask)
+{
+    Range res;
+    if (mask & 0x1)     res = res.disjoin(Range("-inf", bound, false, false));
+    if (mask & 0x2)     res = res.disjoin(Range(bound, bound, true, true));
+    if (mask & 0x4)     res = res.disjoin(Range(bound, "inf", false, false));
+    return res;
+}
+
+//
+//  PredicateProgram
+//
+
+PredicateProgram::PredicateProgram(mpfr_prec_t prec)
+    : mPrec(prec)
+{
+    mResult = range(Range());
+}
+
+bool PredicateProgram::lower(ExprNode* expr)
+{
+    PredicateProgram prog(mPrec);
+    prog.mInstrs.clear();
+    prog.mRanges.clear();
+    prog.mRegs.clear();
+
+    size_t reg;
+    if (!prog.lowerConnective(expr, "", false, reg))
+        return false;
+
+    prog.mResult = reg;
+    *this = std::move(prog);
+    return true;
+}
+
+Verdict PredicateProgram::evaluate(const Interval& x, bool& defined) const
+{
+    std::vector<Interval> vals(mInstrs.size(), Interval(mPrec));
+    std::vector<Verdict> verdicts(mInstrs.size(), UNDECIDED);
+    defined = true;
+    for (size_t i = 0; i < mInstrs.size(); ++i)
+    {
+        const Instr& in = mInstrs[i];
+        switch (in.op)
+        {
+        case CONST:     vals[i] = mConsts[in.a];                    break;
+        case VAR:       vals[i] = x;                                break;
+        case NEG:       vals[i] = -vals[in.a];                      break;
+        case ADD:       vals[i] = vals[in.a] + vals[in.b];          break;
+        case SUB:       vals[i] = vals[in.a] - vals[in.b];          break;
+        case MUL:       vals[i] = vals[in.a] * vals[in.b];          break;
+        case DIV:       vals[i] = vals[in.a] / vals[in.b];          break;
+        case POW:       vals[i] = pow(vals[in.a], vals[in.b]);      break;
+        case MOD:       vals[i] = mod(vals[in.a], vals[in.b]);      break;
+        case EXP:       vals[i] = exp(vals[in.a]);                  break;
+        case LOG:       vals[i] = log(vals[in.a]);                  break;
+        case SIN:       vals[i] = sin(vals[in.a]);                  break;
+        case COS:       vals[i] = cos(vals[in.a]);                  break;
+        case TAN:       vals[i] = tan(vals[in.a]);                  break;
+        case RANGE:     verdicts[i] = rangeVerdict(mRanges[in.a], x);   break;
+
+        case COMPARE:
+        {
+            Interval diff = vals[in.a] - vals[in.b];
+            if (diff.isUndef())
+            {
+                defined = false;
+                break;
+            }
+
+            // The difference takes every sign between those of its endpoints
+            bool all = true, any = false;
+            for (int s = mpfr_sgn(diff.lower().data()); s <= mpfr_sgn(diff.upper().data()); ++s)
+            {
+                bool accepted = in.c & (1u << (s + 1));
+                all &= accepted;
+                any |= accepted;
+            }
+
+            verdicts[i] = all ? SATISFIED : (any ? UNDECIDED : VIOLATED);
+            break;
+        }
+
+        case NOT:
+            verdicts[i] = (verdicts[in.a] == UNDECIDED) ? UNDECIDED : ((verdicts[in.a] == SATISFIED) ? VIOLATED : SATISFIED);
+            break;
+
+        case AND:
+        case OR:
+        {
+            Verdict decides = (in.op == AND) ? VIOLATED : SATISFIED;
+            Verdict a = verdicts[in.a], b = verdicts[in.b];
+            verdicts[i] = (a == decides || b == decides) ? decides : ((a == UNDECIDED || b == UNDECIDED) ? UNDECIDED : a);
+            break;
+        }
+        }
+    }
+
+    return verdicts[mResult];
+}
+
+void PredicateProgram::bounds(Range& surely, Range& possibly) const
+{
+    std::vector<Range> lower(mInstrs.size()), upper(mInstrs.size());
+    for (size_t i = 0; i < mInstrs.size(); ++i)
+    {
+        const Instr& in = mInstrs[i];
+        switch (in.op)
+        {
+        case RANGE:
+            lower[i] = mRanges[in.a];
+            upper[i] = mRanges[in.a];
+            break;
+
+        case COMPARE:
+            upper[i] = Range(INTERVAL_REALS);
+            break;
+
+        case NOT:
+            lower[i] = upper[in.a].complement();
+            upper[i] = lower[in.a].complement();
+            break;
+
+        case AND:
+            lower[i] = lower[in.a].conjoin(lower[in.b]);
+            upper[i] = upper[in.a].conjoin(upper[in.b]);
+            break;
+
+        case OR:
+            lower[i] = lower[in.a].disjoin(lower[in.b]);
+            upper[i] = upper[in.a].disjoin(upper[in.b]);
+            break;
+
+        default:    // arithmetic
+            break;
+        }
+    }
+
+    surely = std::move(lower[mResult]);
+    possibly = std::move(upper[mResult]);
+}
+
+size_t PredicateProgram::emit(Opcode op, size_t a, size_t b, size_t c)
+{
+    auto key = std::make_tuple(op, a, b, c);
+    auto it = mRegs.find(key);
+    if (it != mRegs.end())
+        return it->second;
+
+    mInstrs.push_back({ op, a, b, c });
+    mRegs.emplace(key, mInstrs.size() - 1);
+    return mInstrs.size() - 1;
+}
+
+size_t PredicateProgram::range(Range&& r)
+{
+    mRanges.push_back(std::move(r));
+    return emit(RANGE, mRanges.size() - 1);
+}
+
+size_t PredicateProgram::constant(const std::string& key, const Interval& c)
+{
+    auto it = mConstRegs.find(key);
+    if (it != mConstRegs.end())
+        return it->second;
+
+    mConsts.push_back(c);
+    size_t reg = emit(CONST, mConsts.size() - 1);
+    mConstRegs.emplace(key, reg);
+    return reg;
+}
+
+bool PredicateProgram::lowerConnective(ExprNode* expr, const std::string& var, bool predicate, size_t& reg)
+{
+    if (!predicate && expr->type() == ExprNode::RANGE)
+    {
+        reg = range(Range(((RangeNode*)expr)->value()));
+        return true;
+    }
+
+    if (!predicate && isSetBuilder(expr))
+        return lowerPredicate(expr->children().back(), ((VarNode*)expr->children().front())->name(), reg);
+
+    if (!expr->isOperator() || expr->children().empty())
+        return false;
+
+    const std::string& name = ((OpNode*)expr)->name();
+    if (name != "and" && name != "or" && !(name == "not" && expr->children().size() == 1))
+        return false;
+
+    bool first = true;
+    for (auto e : expr->children())
+    {
+        size_t child;
+        if (!(predicate ? lowerPredicate(e, var, child) : lowerConnective(e, var, false, child)))
+            return false;
+
+        if (name == "not")      reg = emit(NOT, child);
+        else if (first)         reg = child;
+        else                    reg = emit((name == "and") ? AND : OR, reg, child);
+        first = false;
+    }
+
+    return true;
+}
+
+bool PredicateProgram::lowerPredicate(ExprNode* expr, const std::string& var, size_t& reg)
+{
+    if (expr->type() == ExprNode::BOOLEAN)
+    {
+        reg = range(((BoolNode*)expr)->value() ? Range(INTERVAL_REALS) : Range());
+        return true;
+    }
+
+    if (!isInequalityNode(expr))
+        return lowerConnective(expr, var, true, reg);
+
+    // A chain (< a b c) is the conjunction of its links. In a nested chain (< (< a b) c), the
+    // inner chain is one more link and its last operand is the first operand here.
+    const std::string& op = ((OpNode*)expr)->name();
+    if (expr->children().size() < 2)
+        return false;
+
+    ExprNode* lhs = expr->children().front();
+    bool nested = op != "!=" && isInequalityNode(lhs) && ((OpNode*)lhs)->name() != "!=";
+    if (nested && !lowerPredicate(lhs, var, reg))
+        return false;
+
+    for (auto it = std::next(expr->children().begin()); it != expr->children().end(); ++it)
+    {
+        size_t link;
+        ExprNode* left = (nested && lhs == expr->children().front()) ? lhs->children().back() : lhs;
+        if (!lowerCompare(left, *it, op, var, link))
+            return false;
+
+        reg = (nested || it != std::next(expr->children().begin())) ? emit(AND, reg, link) : link;
+        lhs = *it;
+    }
+
+    return true;
+}
+
+bool PredicateProgram::lowerCompare(ExprNode* lhs, ExprNode* rhs, const std::string& op, const std::string& var, size_t& reg)
+{
+    DensePoly p, q;
+    if (op != "!=" && toDensePoly(lhs, var, p) && toDensePoly(rhs, var, q))
+    {
+        reg = range(polynomialRange(p - q, op));
+        return true;
+    }
+
+    // A bound on the variable by a number that is not an integer, e.g. an evaluated (-* 2)
+    unsigned mask = comparatorMask(op);
+    bool left = lhs->type() == ExprNode::VARIABLE && ((VarNode*)lhs)->name() == var && rhs->isNumber();
+    if (left || (rhs->type() == ExprNode::VARIABLE && ((VarNode*)rhs)->name() == var && lhs->isNumber()))
+    {
+        if (!left)      mask = (mask & 0x2) | ((mask & 0x1) << 2) | ((mask & 0x4) >> 2);
+        reg = range(signRange(toFloat(left ? rhs : lhs), mask));
+        return true;
+    }
+
+    size_t a, b;
+    if (!lowerArithmetic(lhs, var, a) || !lowerArithmetic(rhs, var, b))
+        return false;
+
+    reg = emit(COMPARE, a, b, comparatorMask(op));
+    return true;
+}
+
+bool PredicateProgram::lowerArithmetic(ExprNode* expr, const std::string& var, size_t& reg)
+{
+    if (extractVariables(expr).empty())
+    {
+        std::string key = toInfixString(expr);
+        auto it = mConstRegs.find(key);
+        if (it != mConstRegs.end())
+        {
+            reg = it->second;
+            return true;
+        }
+
+        Interval c = evaluateInterval(expr, IntervalBox(), mPrec);
+        if (c.isUndef())
+            return false;
+
+        reg = constant(key, c);
+        return true;
+    }
+
+    if (expr->type() == ExprNode::VARIABLE)
+    {
+        reg = emit(VAR);
+        return ((VarNode*)expr)->name() == var;
+    }
+
+    if (lowerPolynomial(expr, var, reg))
+        return true;
+
+    if (expr->type() == ExprNode::FUNCTION && expr->children().size() == 1)
+    {
+        const std::string& name = ((FuncNode*)expr)->name();
+        Opcode op;
+        if (name == "exp")          op = EXP;
+        else if (name == "log")     op = LOG;
+        else if (name == "sin")     op = SIN;
+        else if (name == "cos")     op = COS;
+        else if (name == "tan")     op = TAN;
+        else                        return false;
+
+        size_t arg;
+        if (!lowerArithmetic(expr->children().front(), var, arg))
+            return false;
+        reg = emit(op, arg);
+        return true;
+    }
+
+    if (!expr->isOperator() || expr->children().empty())
+        return false;
+
+    const std::string& name = ((OpNode*)expr)->name();
+    auto it = expr->children().begin();
+    if (!lowerArithmetic(*it, var, reg))
+        return false;
+
+    if (name == "-*")
+    {
+        reg = emit(NEG, reg);
+        return expr->children().size() == 1;
+    }
+
+    Opcode op;
+    if (name == "+")                        op = ADD;
+    else if (name == "-")                   op = SUB;
+    else if (name == "*" || name == "**")   op = MUL;
+    else if (name == "/")                   op = DIV;
+    else if (name == "^")                   op = POW;
+    else if (name == "%" || name == "mod")  op = MOD;
+    else                                    return false;
+
+    for (++it; it != expr->children().end(); ++it)
+    {
+        size_t rhs;
+        if (!lowerArithmetic(*it, var, rhs))
+            return false;
+        reg = emit(op, reg, rhs);
+    }
+
+    return true;
+}
+
+bool PredicateProgram::lowerPolynomial(ExprNode* expr, const std::string& var, size_t& reg)
+{
+    // Rounded coefficients would make the enclosures unsound
+    PolyProgram poly;
+    if (!expr->isOperator() || !poly.lower(expr) || !poly.exact() ||
+        poly.variables().size() != 1 || poly.variables().front() != var)
+        return false;
+
+    std::vector<size_t> regs(poly.instructions().size());
+    for (size_t i = 0; i < regs.size(); ++i)
+    {
+        const PolyProgram::Instr& in = poly.instructions()[i];
+        switch (in.op)
+        {
+        case PolyProgram::CONST:
+        {
+            const Float& c = poly.constants()[in.a];
+            mConsts.push_back(Interval(c, mPrec));
+            regs[i] = emit(CONST, mConsts.size() - 1);
+            break;
+        }
+
+        case PolyProgram::VAR:  regs[i] = emit(VAR);                            break;
+        case PolyProgram::ADD:  regs[i] = emit(ADD, regs[in.a], regs[in.b]);    break;
+        case PolyProgram::FMA:  regs[i] = emit(ADD, emit(MUL, regs[in.a], regs[in.b]), regs[in.c]);  break;
+
+        case PolyProgram::MUL:  // x * x as x^2 keeps even powers nonnegative
+            if (in.a == in.b)   regs[i] = emit(POW, regs[in.a], constant("2", Interval(Float("2"), mPrec)));
+            else                regs[i] = emit(MUL, regs[in.a], regs[in.b]);
+            break;
+        }
+    }
+
+    reg = regs[poly.result()];
+    return true;
+}
+
+//
+//  Set builder evaluation
+//
+
+ExprNode* evaluateSetBuilder(ExprNode* expr, const BisectionOptions& opts)
+{
+    PredicateProgram prog(opts.precision);
+    if (!prog.lower(expr))
+        return expr;
+
+    // Only the part of the line not decided by the exact Range tests is bisected
+    Range surely, possibly;
+    prog.bounds(surely, possibly);
+    Range undecided = possibly.subtract(surely);
+    for (const auto& ival : undecided.data())
+    {
+        if (ival.lower.isInf() || ival.upper.isInf())
+            return expr;
+    }
+
+    // Boundaries found by bisection are kept only if every comparison accepts equality
+    bool inclusive = std::none_of(prog.instructions().begin(), prog.instructions().end(), [](const PredicateProgram::Instr& i) {
+        return i.op == PredicateProgram::NOT || (i.op == PredicateProgram::COMPARE && !(i.c & 0x2));
+    });
+
+    // The budget is shared by every undecided interval
+    Range res = surely;
+    BisectionOptions left = opts;
+    auto classify = [&prog](const Interval& x, bool& defined) { return prog.evaluate(x, defined); };
+    for (const auto& ival : undecided.data())
+    {
+        BisectionResult part = bisectDomain(ival, classify, inclusive, left);
+        if (!part.complete)
+            return expr;
+        res = res.disjoin(part.range);
+        left.maxBoxes -= part.boxes;
+        left.maxSeconds -= part.seconds;
+    }
+
+    ExprNode* node = new RangeNode(res, expr->parent());
+    freeExpression(expr);
+    return node;
+}
+
+}
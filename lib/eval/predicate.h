@@ -0,0 +1,124 @@
+#ifndef _MATHSOLVER_PREDICATE_H_
+#define _MATHSOLVER_PREDICATE_H_
+
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "../common/base.h"
+#include "../expr/expr.h"
+#include "../types/interval.h"
+#include "../types/range.h"
+#include "bisection.h"
+
+namespace MathSolver
+{
+
+// The predicate of a set builder, or an 'and' / 'or' of set builders and Ranges, lowered to a
+// straight-line program over one variable for classifying intervals of it. Comparisons between
+// polynomials with integer coefficients are solved exactly once and become Range tests. Other
+// comparisons are evaluated in interval arithmetic, with polynomial parts in Horner form (see
+// PolyProgram). Repeated subexpressions are computed once.
+class PredicateProgram
+{
+public:
+
+    enum Opcode
+    {
+        CONST,      // x = consts[a]
+        VAR,        // x = the variable
+        NEG,        // x = -x[a]
+        ADD,        // x = x[a] + x[b]
+        SUB,        // x = x[a] - x[b]
+        MUL,        // x = x[a] * x[b]
+        DIV,        // x = x[a] / x[b]
+        POW,        // x = x[a] ^ x[b]
+        MOD,        // x = x[a] mod x[b]
+        EXP,        // x = exp(x[a])
+        LOG,        // x = log(x[a])
+        SIN,        // x = sin(x[a])
+        COS,        // x = cos(x[a])
+        TAN,        // x = tan(x[a])
+        RANGE,      // v = the variable is in ranges[a]
+        COMPARE,    // v = the sign of x[a] - x[b] is accepted by comparatorMask c
+        NOT,        // v = not v[a]
+        AND,        // v = v[a] and v[b]
+        OR          // v = v[a] or v[b]
+    };
+
+    struct Instr
+    {
+        Opcode op;
+        size_t a, b, c;
+    };
+
+public:
+
+    // Constructs the predicate false.
+    PredicateProgram(mpfr_prec_t prec = MATHSOLVER_FLOAT_DEFAULT_PREC);
+
+    // Lowers a set builder { x | p(x) }, a Range, or an 'and' / 'or' of these. Returns false and
+    // leaves this program unchanged for anything else, e.g. a predicate in a second variable.
+    bool lower(ExprNode* expr);
+
+    // Classifies the predicate over an interval of the variable. Sets 'defined' to false if some
+    // comparison could not be evaluated. Safe to call from several threads.
+    Verdict evaluate(const Interval& x, bool& defined) const;
+
+    // Bounds the solution set using only the Range tests: every point of 'surely' satisfies the
+    // predicate and every point satisfying it is in 'possibly'.
+    void bounds(Range& surely, Range& possibly) const;
+
+    // Returns the instructions.
+    inline const std::vector<Instr>& instructions() const { return mInstrs; }
+
+    // Returns the register holding the predicate.
+    inline size_t result() const { return mResult; }
+
+private:
+
+    // Appends an instruction, or returns the register of an identical one.
+    size_t emit(Opcode op, size_t a = 0, size_t b = 0, size_t c = 0);
+
+    // Emits a Range test.
+    size_t range(Range&& r);
+
+    // Emits a constant, or returns the register of the constant with the same key.
+    size_t constant(const std::string& key, const Interval& c);
+
+    // Emits the predicate of a set builder in 'var'. Returns false if it cannot be lowered.
+    bool lowerPredicate(ExprNode* expr, const std::string& var, size_t& reg);
+
+    // Emits a comparison (? lhs rhs) between arithmetic expressions in 'var'.
+    bool lowerCompare(ExprNode* lhs, ExprNode* rhs, const std::string& op, const std::string& var, size_t& reg);
+
+    // Emits an arithmetic expression in 'var'.
+    bool lowerArithmetic(ExprNode* expr, const std::string& var, size_t& reg);
+
+    // Emits a polynomial in 'var' with exact number coefficients from its PolyProgram. Returns
+    // false if it is not such a polynomial.
+    bool lowerPolynomial(ExprNode* expr, const std::string& var, size_t& reg);
+
+    // Emits 'and' / 'or' / 'not' over the predicates or Ranges of a connective.
+    bool lowerConnective(ExprNode* expr, const std::string& var, bool predicate, size_t& reg);
+
+private:
+    std::vector<Instr> mInstrs;
+    std::vector<Interval> mConsts;
+    std::vector<Range> mRanges;
+    std::map<std::tuple<Opcode, size_t, size_t, size_t>, size_t> mRegs;
+    std::map<std::string, size_t> mConstRegs;
+    size_t mResult;
+    mpfr_prec_t mPrec;
+};
+
+// Evaluates a set builder, or an 'and' / 'or' of set builders and Ranges, into a Range. Parts of
+// the line decided by exact Range tests are taken as they are; the rest is solved by branch and
+// bound with the compiled predicate (see bisectDomain). Returns the expression unchanged if it
+// cannot be compiled, if the undecided part is unbounded, or if the budget, shared by every
+// undecided interval, runs out.
+ExprNode* evaluateSetBuilder(ExprNode* expr, const BisectionOptions& opts = BisectionOptions());
+
+}
+
+#endif
@@ -20,6 +20,11 @@ bool isArithmeticNode(ExprNode* node)
                 op->name() == "^" || op->name() == "!");
     }
 
+    else if (node->type() == ExprNode::CONSTANT)
+    {
+        return isConstant(((ConstNode*)node)->name());
+    }
+
     return node->isNumber() || node->type() == ExprNode::VARIABLE;
 }
 
@@ -1,4 +1,6 @@
+#include <functional>
 #include <list>
+#include <ostream>
 #include <string>
 #include "../types/integer.h"
 #include "expr.h"
@@ -10,7 +12,7 @@ const size_t FLATTENABLE_OP_COUNT = 11;
 const std::string FLATTENABLE_OPS[FLATTENABLE_OP_COUNT] = 
 { 
 	"+", "-", "*", "**",
-	">", "<", ">=", "<=", "!="
+	">", "<", ">=", "<=", "!=",
 	"and", "or"
 };
 
@@ -24,12 +26,18 @@ ExprNode* copyOf(ExprNode* expr)
 	else if (expr->type() == ExprNode::CONSTANT) 	cp = new ConstNode(((ConstNode*)expr)->name(), expr->parent());
 	else if (expr->type() == ExprNode::INTEGER) 	cp = new IntNode(((IntNode*)expr)->value(), expr->parent());
 	else if (expr->type() == ExprNode::FLOAT)		cp = new FloatNode(((FloatNode*)expr)->value(), expr->parent());
+	else if (expr->type() == ExprNode::RATIONAL)	cp = new RationalNode(((RationalNode*)expr)->value(), expr->parent());
 	else if (expr->type() == ExprNode::RANGE)		cp = new RangeNode(((RangeNode*)expr)->value(), expr->parent());
 	else if (expr->type() == ExprNode::BOOLEAN)		cp = new BoolNode(((BoolNode*)expr)->value(), expr->parent());
 	else 		gErrorManager.log("Should not have executed here", ErrorManager::FATAL, __FILE__, __LINE__);
 
 	for (ExprNode* child : expr->children())
-		cp->children().push_back(copyOf(child));
+	{
+		ExprNode* c = copyOf(child);
+		c->setParent(cp);
+		cp->children().push_back(c);
+	}
+
 	return cp;
 }
 
@@ -39,6 +47,7 @@ bool eqvExpr(ExprNode* a, ExprNode* b)
 	{
 		if (a->type() == ExprNode::INTEGER) 	return ((IntNode*)a)->value() == ((IntNode*)b)->value();
 		if (a->type() == ExprNode::FLOAT) 		return ((FloatNode*)a)->value() == ((FloatNode*)b)->value();
+		if (a->type() == ExprNode::RATIONAL) 	return ((RationalNode*)a)->value() == ((RationalNode*)b)->value();
 		if (a->type() == ExprNode::CONSTANT) 	return ((ConstNode*)a)->name() == ((ConstNode*)b)->name();
 		if (a->type() == ExprNode::VARIABLE) 	return ((VarNode*)a)->name() == ((VarNode*)b)->name();
 
@@ -77,6 +86,47 @@ std::list<std::string> extractVariables(ExprNode* expr)
 	return ret;
 }
 
+// Mixes a value into a running hash.
+static inline size_t hashCombine(size_t seed, size_t value)
+{
+	return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+}
+
+// Returns a hash of the value of an Integer.
+static size_t hashInteger(const Integer& val)
+{
+	size_t hash = 0;
+	size_t len = highestNonZeroByte(val.data(), val.size());	// ignore leading zeros
+	for (size_t i = 0; i < len; ++i)
+		hash = hashCombine(hash, val.data()[i]);
+	return hashCombine(hash, (len != 0 && val.sign()));
+}
+
+size_t hashExpr(ExprNode* expr)
+{
+	size_t hash = std::hash<int>()((int)expr->type());
+	if (expr->type() == ExprNode::INTEGER)
+		return hashCombine(hash, hashInteger(((IntNode*)expr)->value()));
+
+	if (expr->type() == ExprNode::RATIONAL)
+	{
+		const Rational& val = ((RationalNode*)expr)->value();
+		return hashCombine(hashCombine(hash, hashInteger(val.numerator())), hashInteger(val.denominator()));
+	}
+
+	if (expr->type() == ExprNode::FLOAT)
+		return hashCombine(hash, std::hash<double>()(mpfr_get_d(((FloatNode*)expr)->value().data(), MPFR_RNDN)));
+
+	if (expr->type() == ExprNode::OPERATOR)			hash = hashCombine(hash, std::hash<std::string>()(((OpNode*)expr)->name()));
+	else if (expr->type() == ExprNode::FUNCTION)	hash = hashCombine(hash, std::hash<std::string>()(((FuncNode*)expr)->name()));
+	else if (expr->type() == ExprNode::VARIABLE)	hash = hashCombine(hash, std::hash<std::string>()(((VarNode*)expr)->name()));
+	else if (expr->type() == ExprNode::CONSTANT)	hash = hashCombine(hash, std::hash<std::string>()(((ConstNode*)expr)->name()));
+
+	for (auto e : expr->children())
+		hash = hashCombine(hash, hashExpr(e));
+	return hash;
+}
+
 void flattenExpr(ExprNode* expr)
 {
 	if (expr == nullptr)	// no expression
@@ -134,24 +184,51 @@ void freeExpression(ExprNode* expr)
 	}
 }
 
-std::string toInfixString(ExprNode* expr)
+//
+//	Printers
+//
+
+// Output sinks shared by the printers below. Each writes directly into the destination
+// so that no partial results are built up the tree.
+static inline void put(std::string& buf, const std::string& str) 	{ buf.append(str); }
+static inline void put(std::string& buf, const char* str) 			{ buf.append(str); }
+static inline void put(std::ostream& out, const std::string& str) 	{ out << str; }
+static inline void put(std::ostream& out, const char* str) 		{ out << str; }
+
+// Writes the string representation of a single node. Named nodes are written without a copy.
+template <typename Out>
+void writeNode(Out& out, ExprNode* expr)
+{
+	if (expr->type() == ExprNode::VARIABLE) 		put(out, ((VarNode*)expr)->name());
+	else if (expr->type() == ExprNode::CONSTANT) 	put(out, ((ConstNode*)expr)->name());
+	else if (expr->type() == ExprNode::OPERATOR) 	put(out, ((OpNode*)expr)->name());
+	else if (expr->type() == ExprNode::FUNCTION) 	put(out, ((FuncNode*)expr)->name());
+	else if (expr->type() == ExprNode::SYNTAX) 		put(out, ((SyntaxNode*)expr)->name());
+	else 											put(out, expr->toString());
+}
+
+template <typename Out>
+void writeInfix(Out& out, ExprNode* expr)
 {
 	if (expr == nullptr)
 	{
-		return "<null>";
+		put(out, "<null>");
 	}
 	else if (expr->type() == ExprNode::FUNCTION)
 	{
-		FuncNode* func = (FuncNode*)expr;
-		std::string sub = func->name() + "(";
+		put(out, ((FuncNode*)expr)->name());
+		put(out, "(");
 		if (!expr->children().empty())
 		{
-			sub += toInfixString(expr->children().front());
+			writeInfix(out, expr->children().front());
 			for (auto it = std::next(expr->children().begin()); it != expr->children().end(); ++it)
-				sub += (", " + toInfixString(*it));
+			{
+				put(out, ", ");
+				writeInfix(out, *it);
+			}
 		}
 
-		return sub + ")";
+		put(out, ")");
 	}
 	else if (expr->isOperator())
 	{
@@ -159,76 +236,149 @@ std::string toInfixString(ExprNode* expr)
 		if (op->name() == "!")
 		{
 			if (op->children().front()->isOperator() && ((OpNode*)op->children().front())->name() == "!")
-				return "(" + toInfixString(op->children().front()) + ")!";
+			{
+				put(out, "(");
+				writeInfix(out, op->children().front());
+				put(out, ")!");
+			}
 			else
-				return toInfixString(op->children().front()) + "!";
+			{
+				writeInfix(out, op->children().front());
+				put(out, "!");
+			}
 		}
 		else if (op->name() == "^")
 		{
-			return toInfixString(op->children().front()) + "^" + toInfixString(op->children().back());		
+			writeInfix(out, op->children().front());
+			put(out, "^");
+			writeInfix(out, op->children().back());		
 		}
 		else if (op->name() == "mod")
 		{
-			return toInfixString(op->children().front()) + " " + op->name() + " " + toInfixString(op->children().back());
+			writeInfix(out, op->children().front());
+			put(out, " mod ");
+			writeInfix(out, op->children().back());
 		}
 		else if (op->name() == "-*" && op->children().size() == 1)
 		{
-			return "-" + toInfixString(op->children().front());
+			put(out, "-");
+			writeInfix(out, op->children().front());
 		}
-		else if (op->name() == "or" || op->name() == "and")
+		else if (op->name() == "not")
 		{
-			std::string sub = toInfixString(op->children().front());
-			for (auto it = std::next(op->children().begin()); it != op->children().end(); ++it)
-				sub += (" " + op->name() + " " + toInfixString(*it));
-			if (op->parent() != nullptr && !op->parent()->isSyntax() && op->parent()->prec() < op->prec())
-				return "(" + sub + ")";
-			else
-				return sub;
+			put(out, "not ");
+			writeInfix(out, op->children().front());
 		}
 		else
 		{
-			std::string sub = toInfixString(op->children().front());
-			std::string printOp = (op->name() == "**") ? "" : ((op->name() == "-*") ? "-" : op->name());
+			bool connective = (op->name() == "or" || op->name() == "and" || op->name() == "xor");
+			bool bracket = (op->parent() != nullptr && !op->parent()->isSyntax() && op->parent()->prec() < op->prec());
+			if (connective && op->parent() != nullptr && op->parent()->isOperator() &&		// connectives share a precedence: (a or b) and c
+				((OpNode*)op->parent())->name() != op->name() && op->parent()->prec() == op->prec())
+				bracket = true;
+			const char* printOp = (op->name() == "**") ? "" : ((op->name() == "-*") ? "-" : op->name().c_str());
+
+			if (bracket) 	put(out, "(");
+			writeInfix(out, op->children().front());
 			for (auto it = std::next(op->children().begin()); it != op->children().end(); ++it)
-				sub += (printOp + toInfixString(*it));
-			if (op->parent() != nullptr && !op->parent()->isSyntax() && op->parent()->prec() < op->prec())
-				return "(" + sub + ")";
-			else
-				return sub;
+			{
+				if (connective) 
+				{
+					put(out, " ");
+					put(out, printOp);
+					put(out, " ");
+				}
+				else
+				{
+					put(out, printOp);
+				}
+
+				writeInfix(out, *it);
+			}
+			if (bracket) 	put(out, ")");
 		}
-		
 	}
-	else if (expr->isSyntax())
+	else if (expr->isSyntax() && ((SyntaxNode*)expr)->name() == "|")
 	{
-		SyntaxNode* syntax = (SyntaxNode*)expr;
-		if (syntax->name() == "|")
-		{
-			return "{ " + toInfixString(expr->children().front()) + " " + syntax->name() + " " + toInfixString(expr->children().back()) + " }";
-		}
+		put(out, "{ ");
+		writeInfix(out, expr->children().front());
+		put(out, " | ");
+		writeInfix(out, expr->children().back());
+		put(out, " }");
+	}
+	else if (expr->type() == ExprNode::RATIONAL && expr->parent() != nullptr && expr->parent()->isOperator() &&
+			 (expr->parent()->prec() < expr->prec() ||		// bracketed like a quotient: (1/2)^x, 1/(1/2), (1/2)*x
+			  ((OpNode*)expr->parent())->name() == "*" ||
+			  (((OpNode*)expr->parent())->name() == "/" && expr != expr->parent()->children().front())))
+	{
+		put(out, "(");
+		writeNode(out, expr);
+		put(out, ")");
+	}
+	else
+	{
+		writeNode(out, expr);
 	}
-
-	return expr->toString();
 }
 
-std::string toPrefixString(ExprNode* expr)
+template <typename Out>
+void writePrefix(Out& out, ExprNode* expr)
 {
 	if (expr == nullptr)
 	{
-		return "<null>";
+		put(out, "<null>");
 	}
 	else if (!expr->children().empty())
 	{
-		std::string sub = "(" + expr->toString();
+		put(out, "(");
+		writeNode(out, expr);
 		for (auto e : expr->children())
-			sub += (" " + toPrefixString(e));
-		return sub + ")";
+		{
+			put(out, " ");
+			writePrefix(out, e);
+		}
+		put(out, ")");
 	}
 	else
 	{
-		return expr->toString();
+		writeNode(out, expr);
 	}
 }
 
+void appendInfix(std::string& buf, ExprNode* expr)
+{
+	writeInfix(buf, expr);
+}
+
+void appendPrefix(std::string& buf, ExprNode* expr)
+{
+	writePrefix(buf, expr);
+}
+
+void printInfix(std::ostream& out, ExprNode* expr)
+{
+	writeInfix(out, expr);
+}
+
+void printPrefix(std::ostream& out, ExprNode* expr)
+{
+	writePrefix(out, expr);
+}
+
+std::string toInfixString(ExprNode* expr)
+{
+	std::string buf;
+	writeInfix(buf, expr);
+	return buf;
+}
+
+std::string toPrefixString(ExprNode* expr)
+{
+	std::string buf;
+	writePrefix(buf, expr);
+	return buf;
+}
+
 size_t nodeCount(ExprNode* expr)
 {
 	size_t c = 1;
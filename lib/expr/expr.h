@@ -1,6 +1,7 @@
 #ifndef _MATHSOLVER_EXPRESSION_H_
 #define _MATHSOLVER_EXPRESSION_H_
 
+#include <ostream>
 #include "../common/base.h"
 #include "../expr/node.h"
 
@@ -41,6 +42,10 @@ bool eqvExpr(ExprNode* a, ExprNode* b);
 // Returns a list of variable names in an expression
 std::list<std::string> extractVariables(ExprNode* expr);
 
+// Returns a structural hash of the expression. Expressions that are equivalent under eqvExpr()
+// have the same hash.
+size_t hashExpr(ExprNode* expr);
+
 // Takes an expression node and recursively simplifes certain operators with interior nodes of the
 // same operator into a single operator with many operands. e.g. (+ (+ a (+ b c)) d) ==> (+ a b c d)
 void flattenExpr(ExprNode* expr);
@@ -57,6 +62,18 @@ inline bool isNumerical(ExprNode* expr)
 // Returns the number of nodes in the expression tree.
 size_t nodeCount(ExprNode* expr);
 
+// Appends an expression tree in infix notation to the end of a buffer. Assumes the tree is valid.
+void appendInfix(std::string& buf, ExprNode* expr);
+
+// Appends an expression tree in prefix notation to the end of a buffer. Assumes the tree is valid.
+void appendPrefix(std::string& buf, ExprNode* expr);
+
+// Writes an expression tree in infix notation to an output stream. Assumes the tree is valid.
+void printInfix(std::ostream& out, ExprNode* expr);
+
+// Writes an expression tree in prefix notation to an output stream. Assumes the tree is valid.
+void printPrefix(std::ostream& out, ExprNode* expr);
+
 // Returns an expression tree as a string in infix notation. Assumes the tree is valid.
 std::string toInfixString(ExprNode* expr);
 
@@ -1,4 +1,5 @@
 #include "node.h"
+#include "../math/float-math.h"
 
 namespace MathSolver
 {
@@ -70,6 +71,13 @@ FloatNode::FloatNode(Float&& data, ExprNode* parent)
     mPrec = 0;
 }
 
+RationalNode::RationalNode(const Rational& data, ExprNode* parent)
+{
+    mData = data;
+    mParent = parent;
+    mPrec = opPrec("/");
+}
+
 RangeNode::RangeNode(const Range& data, ExprNode* parent)
 {
     mData = data;
@@ -94,13 +102,14 @@ BoolNode::BoolNode(bool data, ExprNode* parent)
 bool isZeroNode(ExprNode* expr)
 {
     return ((expr->type() == ExprNode::INTEGER && ((IntNode*)expr)->value().isZero()) || 
-            (expr->type() == ExprNode::FLOAT && ((FloatNode*)expr)->value().isZero()));
+            (expr->type() == ExprNode::FLOAT && ((FloatNode*)expr)->value().isZero()) ||
+            (expr->type() == ExprNode::RATIONAL && ((RationalNode*)expr)->value().isZero()));
 }
 
 bool isIdentityNode(ExprNode* expr)
 {
-    return ((expr->type() == ExprNode::INTEGER && ((IntNode*)expr)->value() == Integer(1)) || 
-            (expr->type() == ExprNode::FLOAT && ((FloatNode*)expr)->value() == Float("1.0")));
+    return ((expr->type() == ExprNode::INTEGER && ((IntNode*)expr)->value().isOne()) || 
+            (expr->type() == ExprNode::FLOAT && ((FloatNode*)expr)->value().isOne()));
 }
 
 Float toFloat(ExprNode* node)
@@ -112,7 +121,26 @@ Float toFloat(ExprNode* node)
         return Float();
     }
 
-    return (node->type() == ExprNode::INTEGER) ? Float(((IntNode*)node)->value().toString()) : ((FloatNode*)node)->value();    
+    if (node->type() == ExprNode::INTEGER)      return integerToFloat(((IntNode*)node)->value());
+    if (node->type() == ExprNode::RATIONAL)     return rationalToFloat(((RationalNode*)node)->value());
+    return ((FloatNode*)node)->value();
+}
+
+Rational toRational(ExprNode* node)
+{
+    if (node->type() == ExprNode::INTEGER)      return Rational(((IntNode*)node)->value());
+    if (node->type() == ExprNode::RATIONAL)     return ((RationalNode*)node)->value();
+
+    gErrorManager.log("Only exact numerical nodes can be converted into a Rational: " + node->toString(),
+                      ErrorManager::ERROR, __FILE__, __LINE__);
+    return Rational(Integer(0), Integer(0));
+}
+
+ExprNode* rationalNode(const Rational& value, ExprNode* parent)
+{
+    if (value.isUndef())        return new ConstNode("undef", parent);
+    else if (value.isInteger()) return new IntNode(value.numerator(), parent);
+    else                        return new RationalNode(value, parent);
 }
 
 const char* OPERATOR_CHARS = "+-*/%^!=><|";
@@ -6,6 +6,7 @@
 #include "../common/base.h"
 #include "../types/float.h"
 #include "../types/integer.h"
+#include "../types/rational.h"
 #include "../types/range.h"
 
 namespace MathSolver
@@ -24,6 +25,7 @@ public:
         CONSTANT,
         INTEGER,
         FLOAT,
+        RATIONAL,
         RANGE,
         SYNTAX,
         BOOLEAN
@@ -38,7 +40,7 @@ public:
     inline std::list<ExprNode*>& children() { return mChildren; }
     inline const std::list<ExprNode*>& children() const { return mChildren; }
 
-    // Returns true if this node is a number (i.e. Integer or Float type).
+    // Returns true if this node is a number (i.e. Integer, Float, or Rational type).
     virtual bool isNumber() const = 0;
 
     // Returns true if this node is an operator (i.e. not a value).
@@ -259,6 +261,32 @@ private:
     Float mData;
 };
 
+// Rational node. Has the precedence of division so that it is bracketed like a quotient.
+class RationalNode : public ExprNode
+{
+public:
+
+    RationalNode(const Rational& data = Rational(), ExprNode* parent = nullptr);
+    ~RationalNode() {}
+
+    inline Rational& value() { return mData; }
+    inline const Rational& value() const { return mData; }
+
+    inline bool isNumber() const { return true; }
+    inline bool isOperator() const { return false; }
+    inline bool isSyntax() const { return false; }
+    inline bool isValue() const { return true; }
+
+    inline void setValue(const Rational& r) { mData = r; }
+
+    inline std::string toString() const { return mData.toString(); }
+
+    inline Type type() const { return RATIONAL; }
+
+private:
+    Rational mData;
+};
+
 // Range node
 class RangeNode : public ExprNode
 {
@@ -325,6 +353,13 @@ bool isIdentityNode(ExprNode* expr);
 // Returns the floating-point value of this node. Must be a number or an error will be generated.
 Float toFloat(ExprNode* node);
 
+// Returns the exact value of this node. Must be an Integer or Rational or an error will be generated.
+Rational toRational(ExprNode* node);
+
+// Returns a new Integer node if the value is an integer, an 'undef' node if the value is undefined,
+// or a Rational node otherwise.
+ExprNode* rationalNode(const Rational& value, ExprNode* parent = nullptr);
+
 //
 // Parsing (TODO: move to parsing?)
 //
@@ -36,8 +36,9 @@ void expandTokens(std::list<ExprNode*>& tokens)
         {
             ((OpNode*)*it)->setName("-*");
         }
-        else if (next != tokens.end() && ((*it)->isOperator() || ((*it)->isSyntax() && ((SyntaxNode*)*it)->name() == "(")) &&
-                (*next)->isOperator() && ((OpNode*)*next)->name() == "-")
+        else if (next != tokens.end() && (*next)->isOperator() && ((OpNode*)*next)->name() == "-" &&     // negative after an operator, '(', '|' or ','
+                ((*it)->isOperator() || ((*it)->isSyntax() && (isOpeningBracket(((SyntaxNode*)*it)->name()) ||
+                 ((SyntaxNode*)*it)->name() == "|" || ((SyntaxNode*)*it)->name() == ","))))
         {
             ((OpNode*)*next)->setName("-*");
         }
@@ -180,6 +181,9 @@ ExprNode* parseTokensR(std::list<ExprNode*>::iterator begin, std::list<ExprNode*
         }
         else if (bracketLevel == 0) // find lowest precision when not within the bracket
         {
+            if (it != begin && (*it)->isOperator() && ((OpNode*)*it)->name() == "not")
+                continue;   // prefix, binds tighter than the connectives: a and not b ==> (and a (not b))
+
             if ((*it)->prec() > opPrec("^"))
             {
                 if((*it)->prec() > (*split)->prec())
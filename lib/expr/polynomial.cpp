@@ -1,5 +1,9 @@
 #include <algorithm>
+#include <climits>
+#include <vector>
 #include "polynomial.h"
+#include "../math/integer-math.h"
+#include "../math/poly-math.h"
 
 namespace MathSolver
 {
@@ -144,9 +148,6 @@ int monomialBasisCmp(ExprNode* lhs, ExprNode* rhs)
     return 0;
 }
 
-bool monomialBasisGt(ExprNode* lhs, ExprNode* rhs) { return (monomialBasisCmp(lhs, rhs) > 0); }
-// bool monomialBasisLt(ExprNode* lhs, ExprNode* rhs) { return (monomialBasisCmp(lhs, rhs) > 0); } 
-
 int monomialOrderCmp(ExprNode* lhs, ExprNode* rhs)
 {
     if (lhs->isOperator() && ((OpNode*)lhs)->name() == "-*")    return monomialBasisCmp(lhs->children().front(), rhs);
@@ -219,13 +220,229 @@ int monomialOrderCmp(ExprNode* lhs, ExprNode* rhs)
     return 0;
 }
 
-bool monomialOrderGt(ExprNode* lhs, ExprNode* rhs) { return (monomialOrderCmp(lhs, rhs) > 0); }
-bool monomialOrderLt(ExprNode* lhs, ExprNode* rhs) { return (monomialOrderCmp(lhs, rhs) > 0); }
 
 //
 //  End comparators
 //
 
+//
+//  Sort keys: the comparators above, evaluated on data extracted once per term
+//
+
+// Returns the exponent of a (^ x n) node as monomialBasisOrder() would, or 0 if n is not an integer.
+int powExponent(ExprNode* expr)
+{
+    ExprNode* ex = expr->children().back();
+    return (ex->type() == ExprNode::INTEGER) ? ((IntNode*)ex)->value().toInt() : 0;
+}
+
+// Ordering data of a monomial basis (see monomialBasisCmp).
+// monomialOrder() of a node, computed on first use. The comparators only ask for the order of
+// terms that are monomials, so computing it up front would reject the other terms.
+struct LazyOrder
+{
+    ExprNode* node;
+    mutable int value;
+    mutable bool known;
+
+    int get() const
+    {
+        if (!known)
+        {
+            value = monomialOrder(node);
+            known = true;
+        }
+
+        return value;
+    }
+};
+
+struct BasisKey
+{
+    int rank;           // leaves: variable < other < constant < number. Otherwise -1
+    LazyOrder order;    // monomialOrder() of (^ x n)
+    bool pow;
+};
+
+// Ordering data of a subexpression used to match like terms: its first operand and the hash
+// of that operand, and the order it contributes.
+struct FactorKey
+{
+    ExprNode* front;
+    size_t hash;
+    int order;
+};
+
+// Ordering data of a monomial (see monomialOrderCmp).
+struct MonomialKey
+{
+    ExprNode* node;
+    BasisKey basis;                     // key of the node
+    BasisKey inner;                     // key of x for (-* x)
+    std::vector<FactorKey> factors;     // non-value children with operands (for x^n vs. a*x^m)
+    std::vector<FactorKey> likeTerms;   // children of the form x^n (for a*x^n vs. b*x^m)
+    ExprNode* base;                     // x for (^ x n)
+    size_t baseHash;
+    int baseOrder;                      // n for (^ x n)
+    LazyOrder order;                    // monomialOrder()
+    bool neg;
+    bool leaf;
+    bool var;
+};
+
+BasisKey basisKey(ExprNode* expr)
+{
+    BasisKey key = { -1, { expr, 0, false }, false };
+    if (expr->children().empty())
+    {
+        if (expr->type() == ExprNode::VARIABLE)         key.rank = 0;
+        else if (expr->isNumber())                      key.rank = 3;
+        else if (expr->type() == ExprNode::CONSTANT)    key.rank = 2;
+        else                                            key.rank = 1;
+    }
+    else if (expr->isOperator() && ((OpNode*)expr)->name() == "^")
+    {
+        key.pow = true;
+    }
+
+    return key;
+}
+
+MonomialKey monomialKey(ExprNode* expr)
+{
+    MonomialKey key;
+    key.node = expr;
+    key.basis = basisKey(expr);
+    key.neg = (expr->isOperator() && ((OpNode*)expr)->name() == "-*");
+    key.leaf = expr->children().empty();
+    key.var = (expr->type() == ExprNode::VARIABLE);
+    key.base = nullptr;
+    key.baseHash = 0;
+    key.baseOrder = 0;
+    key.order = { expr, 0, false };
+
+    if (key.neg)
+    {
+        key.inner = basisKey(expr->children().front());
+        return key;     // compared by basis only
+    }
+
+    if (key.leaf)
+        return key;
+
+    if (key.basis.pow)
+    {
+        key.base = expr->children().front();
+        key.baseHash = hashExpr(key.base);
+        key.baseOrder = powExponent(expr);
+    }
+
+    for (auto e : expr->children())
+    {
+        if (e->isValue() || e->children().empty())
+            continue;
+
+        FactorKey factor = { e->children().front(), hashExpr(e->children().front()), (e->isOperator() ? powExponent(e) : 0) };
+        key.factors.push_back(factor);
+        if (isMonomialBasis(e))
+            key.likeTerms.push_back(factor);
+    }
+
+    return key;
+}
+
+// Returns true if two subexpressions are equivalent, rejecting by hash first.
+inline bool eqvHashed(ExprNode* lhs, size_t lhash, ExprNode* rhs, size_t rhash)
+{
+    return lhash == rhash && eqvExpr(lhs, rhs);
+}
+
+// Same as monomialBasisCmp().
+int basisKeyCmp(const BasisKey& lhs, const BasisKey& rhs)
+{
+    if (lhs.rank >= 0 && rhs.rank >= 0)     return (lhs.rank > rhs.rank) - (lhs.rank < rhs.rank);
+    if (lhs.pow && rhs.pow)                 return (lhs.order.get() > rhs.order.get()) - (lhs.order.get() < rhs.order.get());
+    return 0;
+}
+
+// Same as monomialOrderCmp().
+int monomialKeyCmp(const MonomialKey& lhs, const MonomialKey& rhs)
+{
+    if (lhs.neg)    return basisKeyCmp(lhs.inner, rhs.basis);
+    if (rhs.neg)    return basisKeyCmp(lhs.basis, rhs.inner);
+
+    if (lhs.leaf && rhs.leaf)   return (lhs.var && !rhs.var) - (!lhs.var && rhs.var);
+    if (lhs.leaf)               return -1;
+    if (rhs.leaf)               return 1;
+    int lo = lhs.order.get(), ro = rhs.order.get();
+    if (lo != ro)               return (lo > ro) ? 1 : -1;
+
+    if (lhs.basis.pow && rhs.basis.pow && eqvHashed(lhs.base, lhs.baseHash, rhs.base, rhs.baseHash))
+    {
+        lo = lhs.baseOrder;
+        ro = rhs.baseOrder;
+    }
+    else if (lhs.basis.pow)
+    {
+        for (const auto& f : rhs.factors)
+        {
+            if (eqvHashed(lhs.base, lhs.baseHash, f.front, f.hash))
+            {
+                lo = lhs.baseOrder;
+                ro = f.order;
+                break;
+            }
+        }
+    }
+    else if (rhs.basis.pow)
+    {
+        for (const auto& f : lhs.factors)
+        {
+            if (eqvHashed(f.front, f.hash, rhs.base, rhs.baseHash))
+            {
+                lo = f.order;
+                ro = rhs.baseOrder;
+                break;
+            }
+        }
+    }
+    else
+    {
+        lo = ro = 0;
+        for (const auto& i : lhs.likeTerms)  // compare order of like terms
+        {
+            for (const auto& j : rhs.likeTerms)
+            {
+                if (eqvHashed(i.front, i.hash, j.front, j.hash))
+                {
+                    lo += i.order;
+                    ro += j.order;
+                }
+            }
+        }
+    }
+
+    return (lo > ro) - (lo < ro);
+}
+
+// Sorts the children of an expression by precomputed keys. Uses the same stable list sort as sorting
+// the children directly, so the resulting order is identical.
+template <typename Key, typename KeyFunc, typename Comp>
+void sortByKey(ExprNode* expr, KeyFunc keyFunc, Comp comp)
+{
+    if (expr->children().size() < 2)
+        return;
+
+    std::list<std::pair<Key, ExprNode*>> keys;
+    for (auto e : expr->children())
+        keys.emplace_back(keyFunc(e), e);
+
+    keys.sort([&](const std::pair<Key, ExprNode*>& lhs, const std::pair<Key, ExprNode*>& rhs) { return comp(lhs.first, rhs.first); });
+    auto it = expr->children().begin();
+    for (const auto& k : keys)
+        *it++ = k.second;
+}
+
 ExprNode* reorderMonomial(ExprNode* expr)
 {
 #ifdef MATHSOLVER_DEBUG
@@ -236,7 +453,7 @@ ExprNode* reorderMonomial(ExprNode* expr)
     }
 #endif
 
-    expr->children().sort(monomialBasisGt);
+    sortByKey<BasisKey>(expr, basisKey, [](const BasisKey& lhs, const BasisKey& rhs) { return basisKeyCmp(lhs, rhs) > 0; });
     return expr;
 }
 
@@ -253,14 +470,517 @@ ExprNode* reorderPolynomial(ExprNode* expr, bool down)
     for (auto e : expr->children())
     {
         if (expr->isOperator() && (((OpNode*)expr)->name() == "*" || ((OpNode*)expr)->name() == "**"))
-            e->children().sort(monomialBasisGt);
+            sortByKey<BasisKey>(e, basisKey, [](const BasisKey& lhs, const BasisKey& rhs) { return basisKeyCmp(lhs, rhs) > 0; });
     }
 
     if (!expr->isOperator() || (((OpNode*)expr)->name() != "+" && ((OpNode*)expr)->name() != "-")) // single term
         return expr;
     
-    expr->children().sort((down ? monomialOrderGt : monomialOrderLt));
+    if (down)   sortByKey<MonomialKey>(expr, monomialKey, [](const MonomialKey& lhs, const MonomialKey& rhs) { return monomialKeyCmp(lhs, rhs) > 0; });
+    else        sortByKey<MonomialKey>(expr, monomialKey, [](const MonomialKey& lhs, const MonomialKey& rhs) { return monomialKeyCmp(lhs, rhs) < 0; });
     return expr;
 }
 
-}
\ No newline at end of file
+//
+//  Native polynomials
+//
+
+// Returns the exponent of (^ x n) if n is a non-negative integer that fits in an int, or -1 otherwise.
+int polyExponent(ExprNode* ex)
+{
+    if (ex->type() != ExprNode::INTEGER)
+        return -1;
+
+    const Integer& n = ((IntNode*)ex)->value();
+    if (n.sign() || n.compare(INT_MAX) > 0)
+        return -1;
+    return n.toInt();
+}
+
+bool toDensePoly(ExprNode* expr, const std::string& var, DensePoly& poly)
+{
+    if (expr->type() == ExprNode::INTEGER)
+    {
+        poly = DensePoly(((IntNode*)expr)->value());
+        return true;
+    }
+
+    if (expr->type() == ExprNode::VARIABLE)
+    {
+        if (((VarNode*)expr)->name() != var)
+            return false;
+        poly = DensePoly::monomial(Integer(1), 1);
+        return true;
+    }
+
+    if (!expr->isOperator() || expr->children().empty())
+        return false;
+
+    const std::string& name = ((OpNode*)expr)->name();
+    if (name == "+" || name == "-")
+    {
+        if (!toDensePoly(expr->children().front(), var, poly))
+            return false;
+
+        DensePoly term;
+        for (auto it = std::next(expr->children().begin()); it != expr->children().end(); ++it)
+        {
+            if (!toDensePoly(*it, var, term))
+                return false;
+            if (name == "+")    poly += term;
+            else                poly -= term;
+        }
+
+        return true;
+    }
+
+    if (name == "-*")
+    {
+        if (!toDensePoly(expr->children().front(), var, poly))
+            return false;
+        poly = -poly;
+        return true;
+    }
+
+    if (name == "*" || name == "**")
+    {
+        poly = DensePoly(Integer(1));
+        DensePoly term;
+        for (auto e : expr->children())
+        {
+            if (!toDensePoly(e, var, term) || poly.degree() + term.degree() > MATHSOLVER_DENSE_POLY_MAX_DEGREE)
+                return false;
+            poly = mul(poly, term);
+        }
+
+        return true;
+    }
+
+    if (name == "^" && expr->children().size() == 2)
+    {
+        int n = polyExponent(expr->children().back());
+        if (n < 0 || !toDensePoly(expr->children().front(), var, poly) ||
+            (int64_t)poly.degree() * n > MATHSOLVER_DENSE_POLY_MAX_DEGREE)
+            return false;
+        poly = pow(poly, n);
+        return true;
+    }
+
+    return false;
+}
+
+bool toDensePoly(ExprNode* expr, const std::string& var, DensePoly& poly, Integer& denom)
+{
+    if (expr->type() == ExprNode::RATIONAL)
+    {
+        const Rational& r = ((RationalNode*)expr)->value();
+        if (r.isUndef())
+            return false;
+        poly = DensePoly(r.numerator());
+        denom = r.denominator();
+        return true;
+    }
+
+    if (!expr->isOperator() || expr->children().empty())
+    {
+        denom = Integer(1);
+        return toDensePoly(expr, var, poly);
+    }
+
+    const std::string& name = ((OpNode*)expr)->name();
+    if (name == "+" || name == "-")     // p/a + q/b = (p(l/a) + q(l/b))/l for l = lcm(a, b)
+    {
+        if (!toDensePoly(expr->children().front(), var, poly, denom))
+            return false;
+
+        DensePoly term;
+        Integer d;
+        for (auto it = std::next(expr->children().begin()); it != expr->children().end(); ++it)
+        {
+            if (!toDensePoly(*it, var, term, d))
+                return false;
+
+            Integer l = (denom / gcd(denom, d)) * d;
+            poly *= DensePoly(l / denom);
+            term *= DensePoly(l / d);
+            if (name == "+")    poly += term;
+            else                poly -= term;
+            denom = l;
+        }
+
+        return true;
+    }
+
+    if (name == "-*")
+    {
+        if (!toDensePoly(expr->children().front(), var, poly, denom))
+            return false;
+        poly = -poly;
+        return true;
+    }
+
+    if (name == "*" || name == "**")
+    {
+        poly = DensePoly(Integer(1));
+        denom = Integer(1);
+        DensePoly term;
+        Integer d;
+        for (auto e : expr->children())
+        {
+            if (!toDensePoly(e, var, term, d) || poly.degree() + term.degree() > MATHSOLVER_DENSE_POLY_MAX_DEGREE)
+                return false;
+            poly = mul(poly, term);
+            denom *= d;
+        }
+
+        return true;
+    }
+
+    if (name == "/" && expr->children().size() == 2)   // division by a nonzero constant
+    {
+        DensePoly div;
+        Integer d;
+        if (!toDensePoly(expr->children().front(), var, poly, denom) ||
+            !toDensePoly(expr->children().back(), var, div, d) || div.degree() != 0 || div.coeff(0).isZero())
+            return false;
+
+        // (p/a) / (c/d) = pd / ac, with the sign of c moved to the numerator
+        Integer c = div.coeff(0);
+        poly *= DensePoly(c.sign() ? -d : d);
+        denom *= (c.sign() ? -c : c);
+        return true;
+    }
+
+    if (name == "^" && expr->children().size() == 2)
+    {
+        int n = polyExponent(expr->children().back());
+        if (n < 0 || !toDensePoly(expr->children().front(), var, poly, denom) ||
+            (int64_t)poly.degree() * n > MATHSOLVER_DENSE_POLY_MAX_DEGREE)
+            return false;
+        poly = pow(poly, n);
+        denom = pow(denom, Integer(n));
+        return true;
+    }
+
+    return false;
+}
+
+// Fast path for a product of integers and powers of variables. Accumulates the exponents and coefficient
+// directly rather than multiplying single-term polynomials.
+bool toSparseMonomial(ExprNode* expr, const std::vector<std::string>& vars, SparsePoly& poly)
+{
+    std::vector<unsigned int> exps(vars.size(), 0);
+    Integer coeff(1);
+    poly = SparsePoly(vars);
+
+    for (auto e : expr->children())
+    {
+        ExprNode* base = e;
+        int n = 1;
+        if (e->isOperator() && ((OpNode*)e)->name() == "^" && e->children().size() == 2)
+        {
+            base = e->children().front();
+            n = polyExponent(e->children().back());
+        }
+
+        if (e->type() == ExprNode::INTEGER)
+        {
+            coeff *= ((IntNode*)e)->value();
+        }
+        else if (base->type() == ExprNode::VARIABLE && n >= 0)
+        {
+            size_t i = std::lower_bound(vars.begin(), vars.end(), ((VarNode*)base)->name()) - vars.begin();
+            if ((uint64_t)exps[i] + n > poly.maxExponent())
+                return false;
+            exps[i] += n;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    poly.addTerm(poly.pack(exps), coeff);
+    return true;
+}
+
+// Recursive helper for toSparsePoly(). Every leaf is created over the same list of variables.
+bool toSparsePoly(ExprNode* expr, const std::vector<std::string>& vars, SparsePoly& poly)
+{
+    if (expr->type() == ExprNode::INTEGER)
+    {
+        poly = SparsePoly(vars);
+        poly.addTerm(0, ((IntNode*)expr)->value());
+        return true;
+    }
+
+    if (expr->type() == ExprNode::VARIABLE)
+    {
+        std::vector<unsigned int> exps(vars.size(), 0);
+        exps[std::lower_bound(vars.begin(), vars.end(), ((VarNode*)expr)->name()) - vars.begin()] = 1;
+        poly = SparsePoly(vars);
+        poly.addTerm(poly.pack(exps), Integer(1));
+        return true;
+    }
+
+    if (!expr->isOperator() || expr->children().empty())
+        return false;
+
+    const std::string& name = ((OpNode*)expr)->name();
+    if (name == "+" || name == "-")
+    {
+        if (!toSparsePoly(expr->children().front(), vars, poly))
+            return false;
+
+        SparsePoly term;
+        for (auto it = std::next(expr->children().begin()); it != expr->children().end(); ++it)
+        {
+            if (!toSparsePoly(*it, vars, term))
+                return false;
+            if (name == "+")    poly += term;
+            else                poly -= term;
+        }
+
+        return true;
+    }
+
+    if (name == "-*")
+    {
+        if (!toSparsePoly(expr->children().front(), vars, poly))
+            return false;
+        poly = -poly;
+        return true;
+    }
+
+    if (name == "*" || name == "**")
+    {
+        if (toSparseMonomial(expr, vars, poly))
+            return true;
+
+        poly = SparsePoly(vars);
+        poly.addTerm(0, Integer(1));
+
+        SparsePoly term;
+        for (auto e : expr->children())
+        {
+            if (!toSparsePoly(e, vars, term) || !poly.canMultiply(term))
+                return false;
+            poly *= term;
+        }
+
+        return true;
+    }
+
+    if (name == "^" && expr->children().size() == 2)
+    {
+        int n = polyExponent(expr->children().back());
+        if (n < 0 || !toSparsePoly(expr->children().front(), vars, poly) || !poly.canPow(n))
+            return false;
+        poly = poly.pow(n);
+        return true;
+    }
+
+    return false;
+}
+
+bool toSparsePoly(ExprNode* expr, SparsePoly& poly)
+{
+    std::list<std::string> names = extractVariables(expr);
+    std::vector<std::string> vars(names.begin(), names.end());
+    std::sort(vars.begin(), vars.end());
+    vars.erase(std::unique(vars.begin(), vars.end()), vars.end());
+
+    if (vars.size() > MATHSOLVER_SPARSE_POLY_MAX_VARS)
+        return false;
+    return toSparsePoly(expr, vars, poly);
+}
+
+// Returns the term |c| * x1^n1 * x2^n2 ... for a list of variables and exponents.
+ExprNode* polyTerm(const Integer& c, const std::vector<std::string>& vars, const std::vector<unsigned int>& exps)
+{
+    Integer mag = (c.sign() ? -c : c);
+    ExprNode* mul = new OpNode("**");
+    if (!mag.isOne())
+        mul->children().push_back(new IntNode(mag, mul));
+
+    for (size_t i = 0; i < vars.size(); ++i)
+    {
+        if (exps[i] == 1)
+        {
+            mul->children().push_back(new VarNode(vars[i], mul));
+        }
+        else if (exps[i] > 1)
+        {
+            ExprNode* pow = new OpNode("^", mul);
+            pow->children().push_back(new VarNode(vars[i], pow));
+            pow->children().push_back(new IntNode(Integer((int)exps[i]), pow));
+            mul->children().push_back(pow);
+        }
+    }
+
+    if (mul->children().empty())        // constant term of 1
+    {
+        delete mul;
+        return new IntNode(mag);
+    }
+
+    if (mul->children().size() == 1)   // (** x) ==> x
+    {
+        ExprNode* term = mul->children().front();
+        delete mul;
+        term->setParent(nullptr);
+        return term;
+    }
+
+    return mul;
+}
+
+// Returns the sum of terms with the given coefficients as (+ (- (-* a) b) c ...), flattened.
+ExprNode* polySum(const std::list<std::pair<Integer, ExprNode*>>& terms, ExprNode* parent)
+{
+    if (terms.empty())
+        return new IntNode(0, parent);
+
+    ExprNode* sum = terms.front().second;
+    if (sum->type() == ExprNode::INTEGER && terms.front().first.sign())     // leading negative term: -c, -cx or -x
+    {
+        ((IntNode*)sum)->setValue(-((IntNode*)sum)->value());
+    }
+    else if (sum->isOperator() && sum->children().front()->type() == ExprNode::INTEGER && terms.front().first.sign())
+    {
+        IntNode* coeff = (IntNode*)sum->children().front();
+        coeff->setValue(-coeff->value());
+    }
+    else if (terms.front().first.sign())
+    {
+        ExprNode* neg = new OpNode("-*");
+        neg->children().push_back(sum);
+        sum->setParent(neg);
+        sum = neg;
+    }
+
+    for (auto it = std::next(terms.begin()); it != terms.end(); ++it)
+    {
+        ExprNode* op = new OpNode((it->first.sign() ? "-" : "+"));
+        op->children().push_back(sum);
+        op->children().push_back(it->second);
+        sum->setParent(op);
+        it->second->setParent(op);
+        sum = op;
+    }
+
+    flattenExpr(sum);
+    sum->setParent(parent);
+    return sum;
+}
+
+ExprNode* fromDensePoly(const DensePoly& poly, const std::string& var, ExprNode* parent)
+{
+    std::list<std::pair<Integer, ExprNode*>> terms;
+    std::vector<std::string> vars = { var };
+    for (int i = poly.degree(); i >= 0; --i)
+    {
+        if (!poly.coeff(i).isZero())
+            terms.emplace_back(poly.coeff(i), polyTerm(poly.coeff(i), vars, { (unsigned int)i }));
+    }
+
+    return polySum(terms, parent);
+}
+
+ExprNode* fromSparsePoly(const SparsePoly& poly, ExprNode* parent)
+{
+    std::vector<std::pair<unsigned int, SparsePoly::key_type>> order;  // (total degree, key)
+    order.reserve(poly.size());
+    for (const auto& term : poly.terms())
+        order.emplace_back(poly.totalDegree(term.first), term.first);
+    std::sort(order.begin(), order.end(), std::greater<std::pair<unsigned int, SparsePoly::key_type>>());
+
+    std::list<std::pair<Integer, ExprNode*>> terms;
+    for (const auto& term : order)
+    {
+        const Integer& c = poly.terms().at(term.second);
+        terms.emplace_back(c, polyTerm(c, poly.variables(), poly.unpack(term.second)));
+    }
+
+    return polySum(terms, parent);
+}
+
+// Returns the single variable in the expression, or an empty string if there is not exactly one.
+std::string singleVariable(ExprNode* expr)
+{
+    std::list<std::string> vars = extractVariables(expr);
+    if (vars.empty() || std::any_of(vars.begin(), vars.end(), [&](const std::string& var) { return var != vars.front(); }))
+        return "";
+    return vars.front();
+}
+
+ExprNode* collectPolynomial(ExprNode* expr)
+{
+    if (!expr->isOperator() || (((OpNode*)expr)->name() != "+" && ((OpNode*)expr)->name() != "-"))
+        return expr;
+
+    for (auto e : expr->children())     // only collect sums of monomials
+    {
+        if (containsOnce(e, [](ExprNode* node) { return node->isOperator() && (((OpNode*)node)->name() == "+" || ((OpNode*)node)->name() == "-"); }))
+            return expr;
+    }
+
+    std::string var = singleVariable(expr);
+    DensePoly poly;
+    if (var.empty() || !toDensePoly(expr, var, poly))
+        return expr;
+
+    ExprNode* res = fromDensePoly(poly, var);
+    for (auto e : expr->children()) freeExpression(e);
+    expr->children().clear();
+    return moveNode(expr, res);
+}
+
+ExprNode* multiplyPolynomial(ExprNode* expr)
+{
+    if (!expr->isOperator() || (((OpNode*)expr)->name() != "*" && ((OpNode*)expr)->name() != "**"))
+        return expr;
+
+    bool sum = false;   // products of monomials are left to the symbolic evaluator
+    size_t factors = 0; // a scalar times a sum, e.g. 2(x+1), is left factored
+    for (auto e : expr->children())
+    {
+        if (!isPolynomialEqv(e))
+            return expr;
+        if (e->isOperator() && (((OpNode*)e)->name() == "+" || ((OpNode*)e)->name() == "-"))
+            sum = true;
+        if (!extractVariables(e).empty())
+            ++factors;
+    }
+
+    std::string var = singleVariable(expr);
+    if (!sum || factors < 2 || var.empty())
+        return expr;
+
+    DensePoly poly(Integer(1)), term;
+    for (auto e : expr->children())
+    {
+        if (!toDensePoly(e, var, term) || poly.degree() + term.degree() > MATHSOLVER_DENSE_POLY_MAX_DEGREE)
+            return expr;
+        poly = mul(poly, term);
+    }
+
+    ExprNode* res = fromDensePoly(poly, var);
+    for (auto e : expr->children()) freeExpression(e);
+    expr->children().clear();
+    return moveNode(expr, res);
+}
+
+ExprNode* expandPolynomial(ExprNode* expr)
+{
+    SparsePoly poly;
+    if (!toSparsePoly(expr, poly))
+        return expr;
+
+    ExprNode* res = fromSparsePoly(poly);
+    for (auto e : expr->children()) freeExpression(e);
+    expr->children().clear();
+    return moveNode(expr, res);
+}
+
+}
@@ -3,6 +3,7 @@
 
 #include "../common/base.h"
 #include "../expr/expr.h"
+#include "../types/poly.h"
 
 namespace MathSolver
 {
@@ -28,6 +29,14 @@ bool isPolynomial(ExprNode* expr);
 // Returns the order of the monomial.
 int monomialOrder(ExprNode* expr);
 
+// Compares two monomial bases. Numbers come before constants and variables, and x^n before x^m if n > m.
+// Returns a positive value if lhs comes first, negative if rhs comes first, or zero otherwise.
+int monomialBasisCmp(ExprNode* lhs, ExprNode* rhs);
+
+// Compares two monomials by order. Returns a positive value if lhs has a higher order, negative
+// if rhs has a higher order, or zero otherwise.
+int monomialOrderCmp(ExprNode* lhs, ExprNode* rhs);
+
 // Returns the monomial in standard form. Constants and numbers appear first followed by monomial basis from
 // highest to lowest order.
 ExprNode* reorderMonomial(ExprNode* expr);
@@ -36,6 +45,42 @@ ExprNode* reorderMonomial(ExprNode* expr);
 // Settings down to false reverses this order.
 ExprNode* reorderPolynomial(ExprNode* expr, bool down = true);
 
+//
+// Native polynomials
+//
+
+// Converts a polynomial in a single variable with integer coefficients into a dense polynomial.
+// Products and powers are expanded. Returns false if the expression is not such a polynomial.
+bool toDensePoly(ExprNode* expr, const std::string& var, DensePoly& poly);
+
+// Converts a polynomial in a single variable with rational coefficients into a dense polynomial
+// over a common denominator, so the expression equals poly / denom with denom positive. Division
+// by a nonzero constant is allowed. Returns false if the expression is not such a polynomial.
+bool toDensePoly(ExprNode* expr, const std::string& var, DensePoly& poly, Integer& denom);
+
+// Converts a polynomial with integer coefficients into a sparse polynomial over the variables in
+// the expression. Products and powers are expanded. Returns false if the expression is not such a polynomial.
+bool toSparsePoly(ExprNode* expr, SparsePoly& poly);
+
+// Returns the dense polynomial as an expression in standard form, highest order terms first.
+ExprNode* fromDensePoly(const DensePoly& poly, const std::string& var, ExprNode* parent = nullptr);
+
+// Returns the sparse polynomial as an expression in standard form, highest total degree first.
+ExprNode* fromSparsePoly(const SparsePoly& poly, ExprNode* parent = nullptr);
+
+// Collects like terms of a sum of integer monomials in a single variable, e.g. x^2+2x+x^2 ==> 2x^2+2x.
+// Returns the expression unchanged otherwise.
+ExprNode* collectPolynomial(ExprNode* expr);
+
+// Multiplies a product of at least two non-constant polynomials in a single variable with integer
+// coefficients, at least one of which is a sum, e.g. (x+1)(x-1) ==> x^2-1. Returns the expression
+// unchanged otherwise, so a scalar times a sum, e.g. 2(x+1), stays factored.
+ExprNode* multiplyPolynomial(ExprNode* expr);
+
+// Expands products and powers of a polynomial with integer coefficients and collects like terms,
+// e.g. (x+y)^2 ==> x^2+2xy+y^2. Returns the expression unchanged if it is not such a polynomial.
+ExprNode* expandPolynomial(ExprNode* expr);
+
 }
 
 
@@ -0,0 +1,119 @@
+#include <climits>
+#include "ball-math.h"
+#include "float-math.h"
+
+namespace MathSolver
+{
+
+// Returns the result for an argument outside the domain of a function. More precision cannot move
+// an undefined or exact argument, but it may narrow an inexact one into the domain.
+static Ball outsideDomain(const Ball& x)
+{
+    return (x.isUndef() || x.isExact()) ? Ball::undef(x.precision()) : Ball::unbounded(x.precision());
+}
+
+Ball exp(const Ball& x)
+{
+    // |e^(a + s) - e^a| <= e^a (e^r - 1) for |s| <= r
+    if (!x.isFinite())
+        return outsideDomain(x);
+
+    Ball res(x.precision());
+    Float ea = Ball::zeroRadius();
+    int t = mpfr_exp(res.mid().data(), x.mid().data(), MPFR_RNDN);
+    mpfr_exp(ea.data(), x.mid().data(), MPFR_RNDU);
+    mpfr_expm1(res.rad().data(), x.rad().data(), MPFR_RNDU);
+    mpfr_mul(res.rad().data(), res.rad().data(), ea.data(), MPFR_RNDU);
+    res.addError(t);
+    return res;
+}
+
+Ball log(const Ball& x)
+{
+    // |ln(a + s) - ln a| <= r / (a - r) for |s| <= r < a
+    Float lo = Ball::zeroRadius();
+    mpfr_sub(lo.data(), x.mid().data(), x.rad().data(), MPFR_RNDD);
+    if (!x.isFinite() || mpfr_sgn(lo.data()) <= 0)
+        return outsideDomain(x);
+
+    Ball res(x.precision());
+    int t = mpfr_log(res.mid().data(), x.mid().data(), MPFR_RNDN);
+    mpfr_div(res.rad().data(), x.rad().data(), lo.data(), MPFR_RNDU);
+    res.addError(t);
+    return res;
+}
+
+// Shared implementation of sine and cosine, which are 1-Lipschitz.
+template <typename Func>
+Ball lipschitz1(const Func& f, const Ball& x)
+{
+    if (!x.isFinite())
+        return outsideDomain(x);
+
+    Ball res(x.precision());
+    int t = f(res.mid().data(), x.mid().data(), MPFR_RNDN);
+    mpfr_min(res.rad().data(), x.rad().data(), Float("2").data(), MPFR_RNDU);
+    res.addError(t);
+    return res;
+}
+
+Ball sin(const Ball& x)
+{
+    return lipschitz1(mpfr_sin, x);
+}
+
+Ball cos(const Ball& x)
+{
+    return lipschitz1(mpfr_cos, x);
+}
+
+Ball tan(const Ball& x)
+{
+    return sin(x) / cos(x);
+}
+
+Ball pow(const Ball& b, long n)
+{
+    if (n < 0)
+        return Ball(Float("1"), b.precision()) / pow(b, -n);
+
+    Ball res(Float("1"), b.precision());
+    Ball base(b);
+    for (; n > 0; n >>= 1)  // square and multiply
+    {
+        if (n & 0x1)    res = res * base;
+        if (n > 1)      base = base * base;
+    }
+
+    return res;
+}
+
+Ball pow(const Ball& b, const Ball& x)
+{
+    if (x.isExact() && mpfr_integer_p(x.mid().data()) && mpfr_fits_slong_p(x.mid().data(), MPFR_RNDN))
+        return pow(b, mpfr_get_si(x.mid().data(), MPFR_RNDN));
+    if (b.isExact() && b.mid().isZero() && !x.containsZero() && !x.mid().sign())   // 0^x = 0 for x > 0
+        return Ball(x.precision());
+    return exp(x * log(b));
+}
+
+Ball mod(const Ball& x, const Ball& n)
+{
+    Ball q = x / n;
+    Float lo = q.lower(), hi = q.upper();
+    mpfr_trunc(lo.data(), lo.data());
+    mpfr_trunc(hi.data(), hi.data());
+    if (!q.isFinite() || mpfr_cmp(lo.data(), hi.data()) != 0)
+        return outsideDomain(q);
+    return x - n * Ball(lo, x.precision());
+}
+
+Ball constantBall(const std::string& name, mpfr_prec_t prec)
+{
+    const Float* c = constantValue(name, prec);
+    if (c == nullptr)
+        return Ball::undef(prec);
+    return Ball(*c, prec, false);   // correctly rounded at 'prec'
+}
+
+}
@@ -0,0 +1,29 @@
+#ifndef _MATHSOLVER_BALL_MATH_H_
+#define _MATHSOLVER_BALL_MATH_H_
+
+#include <string>
+#include "../types/ball.h"
+#include "../common/base.h"
+
+namespace MathSolver
+{
+
+// Elementary functions on balls. Each result contains the function applied to every point of the
+// argument. Exact arguments outside the domain (e.g. log 0) give Ball::undef(), and inexact ones
+// reaching outside it (e.g. log of a ball containing zero) give Ball::unbounded().
+
+Ball exp(const Ball& x);                // e^x
+Ball log(const Ball& x);                // ln x
+Ball sin(const Ball& x);                // sine
+Ball cos(const Ball& x);                // cosine
+Ball tan(const Ball& x);                // tangent
+Ball pow(const Ball& b, long n);        // b^n
+Ball pow(const Ball& b, const Ball& x); // b^x, exact integer powers are computed by repeated squaring
+Ball mod(const Ball& x, const Ball& n); // x mod n with the sign of x, undefined if x/n straddles an integer
+
+// Returns the ball around a named constant (see constantValue) at the given precision.
+Ball constantBall(const std::string& name, mpfr_prec_t prec);
+
+}
+
+#endif
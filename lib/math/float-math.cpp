@@ -1,7 +1,118 @@
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <mpfr.h>
 #include "float-math.h"
+#include "integer-math.h"
 
 namespace MathSolver
 {
 
-}
\ No newline at end of file
+Float integerToFloat(const Integer& x, mpfr_prec_t prec)
+{
+    Float res;
+    if (x.isUndef())
+    {
+        mpfr_set_nan(res.data());
+        return res;
+    }
+
+    if (x.isInf())
+    {
+        mpfr_set_inf(res.data(), x.sign() ? -1 : 1);
+        return res;
+    }
+
+    size_t len = highestNonZeroByte(x.data(), x.size());
+    mpz_t z;
+    mpz_init(z);
+    toMpz(x, z);
+
+    if (prec == 0)
+        mpfr_set_prec(res.data(), std::max((mpfr_prec_t)(32 * len), (mpfr_prec_t)MPFR_PREC_MIN));
+    else if (prec != res.precision())
+        mpfr_set_prec(res.data(), prec);
+
+    mpfr_set_z(res.data(), z, MATHSOLVER_FLOAT_DEFAULT_RND_MODE);
+    mpz_clear(z);
+    return res;
+}
+
+Float rationalToFloat(const Rational& x, mpfr_prec_t prec)
+{
+    Float res;
+    if (prec != res.precision())
+        mpfr_set_prec(res.data(), prec);
+
+    if (x.isUndef())
+    {
+        mpfr_set_nan(res.data());
+        return res;
+    }
+
+    mpq_t q;
+    mpq_init(q);
+    toMpz(x.numerator(), mpq_numref(q));
+    toMpz(x.denominator(), mpq_denref(q));
+    mpfr_set_q(res.data(), q, MATHSOLVER_FLOAT_DEFAULT_RND_MODE);
+    mpq_clear(q);
+    return res;
+}
+
+Rational floatToRational(const Float& x)
+{
+    if (!mpfr_number_p(x.data()))
+        return Rational(Integer(0), Integer(0));
+    if (mpfr_zero_p(x.data()))  // the exponent of zero is the minimum exponent
+        return Rational();
+
+    // x = m * 2^e for an integer mantissa m
+    mpz_t m;
+    mpz_init(m);
+    mpfr_exp_t e = mpfr_get_z_2exp(m, x.data());
+
+    mpz_t p;
+    mpz_init_set_ui(p, 1);
+    if (e < 0)  mpz_mul_2exp(p, p, -e);
+    else        mpz_mul_2exp(m, m, e);
+
+    Rational res(fromMpz(m), fromMpz(p));
+    mpz_clear(m);
+    mpz_clear(p);
+    return res;
+}
+
+// Computes a constant. Returns false if the name is unknown.
+bool computeConstant(const std::string& name, Float& res)
+{
+    mpfr_ptr r = res.data();
+    if (name == "pi")               mpfr_const_pi(r, MATHSOLVER_FLOAT_DEFAULT_RND_MODE);
+    else if (name == "log2")        mpfr_const_log2(r, MATHSOLVER_FLOAT_DEFAULT_RND_MODE);
+    else if (name == "euler")       mpfr_const_euler(r, MATHSOLVER_FLOAT_DEFAULT_RND_MODE);
+    else if (name == "catalan")     mpfr_const_catalan(r, MATHSOLVER_FLOAT_DEFAULT_RND_MODE);
+    else if (name == "e")           mpfr_exp(r, Float("1").data(), MATHSOLVER_FLOAT_DEFAULT_RND_MODE);
+    else                            return false;
+
+    return true;
+}
+
+const Float* constantValue(const std::string& name, mpfr_prec_t prec)
+{
+    static std::mutex lock;
+    static std::map<std::pair<std::string, mpfr_prec_t>, std::unique_ptr<Float>> table;
+
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = table.find({ name, prec });
+    if (it != table.end())
+        return it->second.get();
+
+    std::unique_ptr<Float> val(new Float());
+    mpfr_set_prec(val->data(), prec);
+    if (!computeConstant(name, *val))
+        return nullptr;
+
+    return (table[{ name, prec }] = std::move(val)).get();
+}
+
+}
@@ -2,6 +2,8 @@
 #define _MATHSOLVER_FLOAT_MATH_H_
 
 #include "../types/float.h"
+#include "../types/integer.h"
+#include "../types/rational.h"
 #include "../common/base.h"
 
 namespace MathSolver
@@ -63,6 +65,25 @@ inline Float acos(const Float& x) { return float1ary(mpfr_acos, x); }   // arcco
 inline Float atan(const Float& x) { return float1ary(mpfr_atan, x); }   // arctangent
 inline Float atan2(const Float& x, const Float& y) { return float2ary(mpfr_atan2, x, y); }   // arctan (y, x)
 
+// Conversion
+
+// Returns the Integer as a Float rounded to the given precision in bits. A precision of zero
+// keeps every bit of the Integer.
+Float integerToFloat(const Integer& x, mpfr_prec_t prec = MATHSOLVER_FLOAT_DEFAULT_PREC);
+
+// Returns the Rational as a Float correctly rounded to the given precision in bits.
+Float rationalToFloat(const Rational& x, mpfr_prec_t prec = MATHSOLVER_FLOAT_DEFAULT_PREC);
+
+// Returns the exact value of a finite Float as a Rational, or 'undef' for NaN and the infinities.
+Rational floatToRational(const Float& x);
+
+// Constants
+
+// Returns the value of a named constant at the given precision in bits: "pi", "e", "log2" (ln 2),
+// "euler" (Euler-Mascheroni) or "catalan". Each value is computed once per precision and shared.
+// Safe to call from multiple threads. Returns nullptr if the name is unknown.
+const Float* constantValue(const std::string& name, mpfr_prec_t prec = MATHSOLVER_FLOAT_DEFAULT_PREC);
+
 }
 
 #endif
\ No newline at end of file
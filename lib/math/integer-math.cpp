@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <vector>
 #include "integer-math.h"
 
 namespace MathSolver
@@ -25,7 +27,7 @@ Integer gcd(const Integer& a, const Integer& b)
 Integer powr(const Integer& a, const Integer& b)
 {
     if (b.isZero())         return Integer(1);
-    if (b == Integer(1))    return a;
+    if (b.isOne())          return a;
     if (b.isEven())         return powr(a * a, b >> 1);
     else                    return a * powr(a * a, (b - Integer(1)) >> 1);
 }
@@ -42,6 +44,12 @@ Integer pow(const Integer& a, const Integer& b)
     return powr(a, b);
 }
 
+Rational pow(const Rational& a, const Integer& b)
+{
+    if (b.sign())   return Rational(powr(a.denominator(), -b), powr(a.numerator(), -b));
+    else            return Rational(powr(a.numerator(), b), powr(a.denominator(), b));
+}
+
 
 Integer factr(const Integer& p, int n)
 {
@@ -68,4 +76,43 @@ Integer fact(int n)
     return factr(Integer(1), n);
 }
 
-}
\ No newline at end of file
+void toMpz(const Integer& x, mpz_t z)
+{
+    mpz_import(z, highestNonZeroByte(x.data(), x.size()), -1, sizeof(uint32_t), 0, 0, x.data());  // least significant word first
+    if (x.sign())
+        mpz_neg(z, z);
+}
+
+Integer fromMpz(const mpz_t z)
+{
+    size_t len = std::max((size_t)1, (mpz_sizeinbase(z, 2) + 31) / 32);
+    uint32_t* arr = new uint32_t[len]();
+    mpz_export(arr, nullptr, -1, sizeof(uint32_t), 0, 0, z);
+    return Integer(arr, len, mpz_sgn(z) < 0);
+}
+
+Integer product(const Integer* xs, size_t n)
+{
+    if (n == 0)
+        return Integer(1);
+
+    std::vector<__mpz_struct> z(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        mpz_init(&z[i]);
+        toMpz(xs[i], &z[i]);
+    }
+
+    for (size_t step = 1; step < n; step *= 2)  // z[i] *= z[i + step] for each pair at this level
+    {
+        for (size_t i = 0; i + step < n; i += 2 * step)
+            mpz_mul(&z[i], &z[i], &z[i + step]);
+    }
+
+    Integer res = fromMpz(&z[0]);
+    for (auto& e : z)
+        mpz_clear(&e);
+    return res;
+}
+
+}
@@ -1,7 +1,9 @@
 #ifndef _MATHSOLVER_INTEGERMATH_H_
 #define _MATHSOLVER_INTEGERMATH_H_
 
+#include <gmp.h>
 #include "../types/integer.h"
+#include "../types/rational.h"
 #include "../common/base.h"
 
 #define MATHSOLVER_FACTORIAL_MAX    500
@@ -19,9 +21,21 @@ Integer gcd(const Integer& a, const Integer& b);
 // Calculates the power of a raised the b
 Integer pow(const Integer& a, const Integer& b);
 
+// Calculates the power of a raised to b. A negative power inverts a.
+Rational pow(const Rational& a, const Integer& b);
+
 // Returns the nth factorial and returns the result as an Integer.
 Integer fact(int n);
 
+// Sets an initialized GMP integer to the value of a finite Integer.
+void toMpz(const Integer& x, mpz_t z);
+
+// Returns the value of a GMP integer as an Integer.
+Integer fromMpz(const mpz_t z);
+
+// Returns the product of finite Integers, multiplied pairwise in a balanced tree.
+Integer product(const Integer* xs, size_t n);
+
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,178 @@
+#include <algorithm>
+#include "float-math.h"
+#include "interval-math.h"
+
+namespace MathSolver
+{
+
+// Returns an enclosure of pi.
+static Interval piInterval(mpfr_prec_t prec)
+{
+    Interval res(prec);
+    mpfr_const_pi(res.lower().data(), MPFR_RNDD);
+    mpfr_const_pi(res.upper().data(), MPFR_RNDU);
+    return res;
+}
+
+// Returns a bitmask of the parities of the integers k with (k + shift)pi in x:
+// bit 0 is set if some such k is even, bit 1 if some such k is odd.
+static int periodParity(const Interval& x, double shift)
+{
+    Interval t = x / piInterval(x.precision());
+    mpfr_sub_d(t.lower().data(), t.lower().data(), shift, MPFR_RNDD);
+    mpfr_sub_d(t.upper().data(), t.upper().data(), shift, MPFR_RNDU);
+    if (!t.isFinite())
+        return 0x3;
+
+    Float klo = t.lower(), khi = t.upper();
+    mpfr_ceil(klo.data(), klo.data());
+    mpfr_floor(khi.data(), khi.data());
+    if (mpfr_greater_p(klo.data(), khi.data()))
+        return 0x0;
+    if (!mpfr_equal_p(klo.data(), khi.data()))
+        return 0x3;
+
+    mpfr_div_2ui(klo.data(), klo.data(), 1, MPFR_RNDN);
+    return mpfr_integer_p(klo.data()) ? 0x1 : 0x2;
+}
+
+// Hull of a function at both endpoints of x.
+template <typename Func>
+Interval endpointHull(const Func& f, const Interval& x)
+{
+    Interval res(x.precision());
+    Float tmp = x.lower();
+    f(res.lower().data(), x.lower().data(), MPFR_RNDD);
+    f(tmp.data(), x.upper().data(), MPFR_RNDD);
+    mpfr_min(res.lower().data(), res.lower().data(), tmp.data(), MPFR_RNDD);
+    f(res.upper().data(), x.lower().data(), MPFR_RNDU);
+    f(tmp.data(), x.upper().data(), MPFR_RNDU);
+    mpfr_max(res.upper().data(), res.upper().data(), tmp.data(), MPFR_RNDU);
+    return res;
+}
+
+// Shared implementation of sine and cosine. The maxima of the function lie at (2k + shift)pi
+// and the minima at (2k + 1 + shift)pi.
+template <typename Func>
+Interval periodic(const Func& f, const Interval& x, double shift)
+{
+    if (x.isUndef())
+        return x;
+
+    int parity = periodParity(x, shift);
+    if (parity == 0x3)
+        return Interval(Float("-1"), Float("1"), x.precision());
+
+    Interval res = endpointHull(f, x);
+    if (parity & 0x1)   mpfr_set_si(res.upper().data(), 1, MPFR_RNDU);
+    if (parity & 0x2)   mpfr_set_si(res.lower().data(), -1, MPFR_RNDD);
+    return res;
+}
+
+Interval exp(const Interval& x)
+{
+    Interval res(x.precision());
+    mpfr_exp(res.lower().data(), x.lower().data(), MPFR_RNDD);
+    mpfr_exp(res.upper().data(), x.upper().data(), MPFR_RNDU);
+    return res;
+}
+
+Interval log(const Interval& x)
+{
+    if (x.isUndef() || mpfr_sgn(x.lower().data()) <= 0)
+        return Interval::undef(x.precision());
+
+    Interval res(x.precision());
+    mpfr_log(res.lower().data(), x.lower().data(), MPFR_RNDD);
+    mpfr_log(res.upper().data(), x.upper().data(), MPFR_RNDU);
+    return res;
+}
+
+Interval sin(const Interval& x)
+{
+    return periodic(mpfr_sin, x, 0.5);
+}
+
+Interval cos(const Interval& x)
+{
+    return periodic(mpfr_cos, x, 0.0);
+}
+
+Interval tan(const Interval& x)
+{
+    // Increasing between the poles at (k + 1/2)pi
+    if (x.isUndef() || periodParity(x, 0.5) != 0x0)
+        return Interval::undef(x.precision());
+
+    Interval res(x.precision());
+    mpfr_tan(res.lower().data(), x.lower().data(), MPFR_RNDD);
+    mpfr_tan(res.upper().data(), x.upper().data(), MPFR_RNDU);
+    return res;
+}
+
+Interval pow(const Interval& b, long n)
+{
+    if (n < 0)
+        return Interval(Float("1"), b.precision()) / pow(b, -n);
+    if (n == 0 || b.isUndef())
+        return (n == 0) ? Interval(Float("1"), b.precision()) : b;
+
+    Interval res(b.precision());
+    if ((n & 0x1) || mpfr_sgn(b.lower().data()) >= 0)      // increasing
+    {
+        mpfr_pow_si(res.lower().data(), b.lower().data(), n, MPFR_RNDD);
+        mpfr_pow_si(res.upper().data(), b.upper().data(), n, MPFR_RNDU);
+    }
+    else if (mpfr_sgn(b.upper().data()) <= 0)               // decreasing
+    {
+        mpfr_pow_si(res.lower().data(), b.upper().data(), n, MPFR_RNDD);
+        mpfr_pow_si(res.upper().data(), b.lower().data(), n, MPFR_RNDU);
+    }
+    else                                                    // minimum at zero
+    {
+        Float m = b.upper();
+        mpfr_neg(res.upper().data(), b.lower().data(), MPFR_RNDU);
+        mpfr_max(m.data(), m.data(), res.upper().data(), MPFR_RNDU);
+        mpfr_pow_si(res.upper().data(), m.data(), n, MPFR_RNDU);
+    }
+
+    return res;
+}
+
+Interval pow(const Interval& b, const Interval& x)
+{
+    if (x.isPoint() && mpfr_integer_p(x.lower().data()) && mpfr_fits_slong_p(x.lower().data(), MPFR_RNDN))
+        return pow(b, mpfr_get_si(x.lower().data(), MPFR_RNDN));
+    if (b.isPoint() && b.lower().isZero() && mpfr_sgn(x.lower().data()) > 0)     // 0^x = 0 for x > 0
+        return Interval(x.precision());
+    return exp(x * log(b));
+}
+
+Interval mod(const Interval& x, const Interval& n)
+{
+    Interval q = x / n;
+    if (!q.isFinite())
+        return Interval::undef(x.precision());
+
+    Float lo = q.lower(), hi = q.upper();
+    mpfr_trunc(lo.data(), lo.data());
+    mpfr_trunc(hi.data(), hi.data());
+    if (!mpfr_equal_p(lo.data(), hi.data()))
+        return Interval::undef(x.precision());
+    return x - n * Interval(lo, x.precision());
+}
+
+Interval constantInterval(const std::string& name, mpfr_prec_t prec)
+{
+    const Float* c = constantValue(name, prec);
+    if (c == nullptr)
+        return Interval::undef(prec);
+
+    // Correctly rounded at 'prec', so the exact value is within one ulp
+    Interval res(*c, prec);
+    mpfr_nextbelow(res.lower().data());
+    mpfr_nextabove(res.upper().data());
+    return res;
+}
+
+}
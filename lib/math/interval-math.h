@@ -0,0 +1,29 @@
+#ifndef _MATHSOLVER_INTERVAL_MATH_H_
+#define _MATHSOLVER_INTERVAL_MATH_H_
+
+#include <string>
+#include "../types/interval.h"
+#include "../common/base.h"
+
+namespace MathSolver
+{
+
+// Elementary functions on intervals. Each result contains the function applied to every point of
+// the argument. Arguments that leave the domain (e.g. log of an interval containing zero) give
+// Interval::undef().
+
+Interval exp(const Interval& x);                    // e^x
+Interval log(const Interval& x);                    // ln x
+Interval sin(const Interval& x);                    // sine
+Interval cos(const Interval& x);                    // cosine
+Interval tan(const Interval& x);                    // tangent
+Interval pow(const Interval& b, long n);            // b^n
+Interval pow(const Interval& b, const Interval& x); // b^x, point integer powers are computed directly
+Interval mod(const Interval& x, const Interval& n); // x mod n with the sign of x, undefined if x/n straddles an integer
+
+// Returns the interval around a named constant (see constantValue) at the given precision.
+Interval constantInterval(const std::string& name, mpfr_prec_t prec);
+
+}
+
+#endif
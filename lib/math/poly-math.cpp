@@ -0,0 +1,317 @@
+#include <algorithm>
+#include <climits>
+#include <vector>
+#include "poly-math.h"
+
+namespace MathSolver
+{
+
+//
+//  Schoolbook and Karatsuba
+//
+
+// res[0 .. n + m - 1) += a[0 .. n) * b[0 .. m)
+void mulSchoolbookAcc(const Integer* a, size_t n, const Integer* b, size_t m, Integer* res)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (a[i].isZero())
+            continue;
+        for (size_t j = 0; j < m; ++j)
+        {
+            if (!b[j].isZero())
+                res[i + j] += a[i] * b[j];
+        }
+    }
+}
+
+// res[0 .. n + m - 1) += a[0 .. n) * b[0 .. m)
+void mulKaratsubaAcc(const Integer* a, size_t n, const Integer* b, size_t m, Integer* res)
+{
+    if (n < m)
+    {
+        std::swap(a, b);
+        std::swap(n, m);
+    }
+
+    if (m < MATHSOLVER_KARATSUBA_THRESHOLD)
+    {
+        mulSchoolbookAcc(a, n, b, m, res);
+        return;
+    }
+
+    if (n > m)  // unbalanced: multiply b by m-sized pieces of a
+    {
+        for (size_t i = 0; i < n; i += m)
+            mulKaratsubaAcc(a + i, std::min(m, n - i), b, m, res + i);
+        return;
+    }
+
+    // a = a0 + a1 x^h, b = b0 + b1 x^h
+    // ab = z0 + ((a0 + a1)(b0 + b1) - z0 - z2) x^h + z2 x^2h, where z0 = a0 b0, z2 = a1 b1
+    size_t h = n / 2;
+    size_t k = n - h;
+    std::vector<Integer> z0(2 * h - 1, Integer(0));
+    std::vector<Integer> z1(2 * k - 1, Integer(0));
+    std::vector<Integer> z2(2 * k - 1, Integer(0));
+    mulKaratsubaAcc(a, h, b, h, z0.data());
+    mulKaratsubaAcc(a + h, k, b + h, k, z2.data());
+
+    std::vector<Integer> sa(a + h, a + n);
+    std::vector<Integer> sb(b + h, b + n);
+    for (size_t i = 0; i < h; ++i)
+    {
+        sa[i] += a[i];
+        sb[i] += b[i];
+    }
+
+    mulKaratsubaAcc(sa.data(), k, sb.data(), k, z1.data());
+    for (size_t i = 0; i < z0.size(); ++i)
+    {
+        z1[i] -= z0[i];
+        res[i] += z0[i];
+    }
+
+    for (size_t i = 0; i < z2.size(); ++i)
+    {
+        z1[i] -= z2[i];
+        res[i + 2 * h] += z2[i];
+    }
+
+    for (size_t i = 0; i < z1.size(); ++i)
+        res[i + h] += z1[i];
+}
+
+DensePoly mulSchoolbook(const DensePoly& a, const DensePoly& b)
+{
+    if (a.isZero() || b.isZero())
+        return DensePoly();
+
+    std::vector<Integer> res(a.data().size() + b.data().size() - 1, Integer(0));
+    mulSchoolbookAcc(a.data().data(), a.data().size(), b.data().data(), b.data().size(), res.data());
+    return DensePoly(std::move(res));
+}
+
+DensePoly mulKaratsuba(const DensePoly& a, const DensePoly& b)
+{
+    if (a.isZero() || b.isZero())
+        return DensePoly();
+
+    std::vector<Integer> res(a.data().size() + b.data().size() - 1, Integer(0));
+    mulKaratsubaAcc(a.data().data(), a.data().size(), b.data().data(), b.data().size(), res.data());
+    return DensePoly(std::move(res));
+}
+
+//
+//  Number-theoretic transform
+//
+
+// NTT-friendly primes p = c * 2^k + 1 with primitive root 3. The smallest k limits the transform length.
+const uint32_t NTT_PRIMES[3] = { 998244353, 167772161, 469762049 };
+const uint32_t NTT_ROOT = 3;
+const size_t NTT_MAX_LENGTH = (size_t)1 << 23;
+
+// Coefficients of the product are recovered exactly when their magnitude is below half the product
+// of the primes (about 2^85).
+const size_t NTT_MAX_BITS = 84;
+
+uint32_t powMod(uint64_t b, uint64_t e, uint32_t m)
+{
+    uint64_t r = 1;
+    b %= m;
+    while (e > 0)
+    {
+        if (e & 0x1)    r = (r * b) % m;
+        b = (b * b) % m;
+        e >>= 1;
+    }
+
+    return (uint32_t)r;
+}
+
+// In-place iterative transform of length 2^k modulo p.
+void ntt(std::vector<uint32_t>& a, bool invert, uint32_t p)
+{
+    size_t n = a.size();
+    for (size_t i = 1, j = 0; i < n; ++i)   // bit-reversal permutation
+    {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j ^= bit;
+        if (i < j)
+            std::swap(a[i], a[j]);
+    }
+
+    for (size_t len = 2; len <= n; len <<= 1)
+    {
+        uint64_t w = powMod(NTT_ROOT, (p - 1) / len, p);
+        if (invert)     w = powMod(w, p - 2, p);
+
+        std::vector<uint32_t> ws(len / 2);
+        ws[0] = 1;
+        for (size_t i = 1; i < len / 2; ++i)
+            ws[i] = (uint32_t)((ws[i - 1] * w) % p);
+
+        for (size_t i = 0; i < n; i += len)
+        {
+            for (size_t j = 0; j < len / 2; ++j)
+            {
+                uint32_t u = a[i + j];
+                uint32_t v = (uint32_t)(((uint64_t)a[i + j + len / 2] * ws[j]) % p);
+                a[i + j] = (u + v >= p) ? u + v - p : u + v;
+                a[i + j + len / 2] = (u >= v) ? u - v : u + p - v;
+            }
+        }
+    }
+
+    if (invert)
+    {
+        uint64_t ninv = powMod(n, p - 2, p);
+        for (auto& x : a)
+            x = (uint32_t)((x * ninv) % p);
+    }
+}
+
+// Returns true and stores the value if the Integer fits in a signed 64-bit integer.
+bool toInt64(const Integer& x, int64_t& v)
+{
+    size_t len = highestNonZeroByte(x.data(), x.size());
+    if (len > 2)
+        return false;
+
+    uint64_t mag = (len > 0 ? x.data()[0] : 0) | (len > 1 ? ((uint64_t)x.data()[1] << 32) : 0);
+    if (mag > (uint64_t)INT64_MAX)
+        return false;
+
+    v = x.sign() ? -(int64_t)mag : (int64_t)mag;
+    return true;
+}
+
+// Returns the Integer with the value of a signed 128-bit integer.
+Integer fromInt128(__int128 v)
+{
+    unsigned __int128 mag = (v < 0) ? -(unsigned __int128)v : (unsigned __int128)v;
+    uint32_t* words = new uint32_t[4];  // owned by the Integer
+    for (size_t i = 0; i < 4; ++i)
+        words[i] = (uint32_t)(mag >> (32 * i));
+    return Integer(words, 4, v < 0);
+}
+
+// Returns the number of bits needed to store x.
+size_t bitWidth(uint64_t x)
+{
+    size_t bits = 0;
+    for (; x; x >>= 1)
+        ++bits;
+    return bits;
+}
+
+// Converts the coefficients to signed 64-bit integers and returns the width of the largest magnitude,
+// or returns false if any coefficient is too large.
+bool toInt64Coeffs(const DensePoly& a, std::vector<int64_t>& coeffs, size_t& bits)
+{
+    coeffs.resize(a.data().size());
+    uint64_t max = 0;
+    for (size_t i = 0; i < coeffs.size(); ++i)
+    {
+        if (!toInt64(a.data()[i], coeffs[i]))
+            return false;
+        max = std::max(max, (uint64_t)(coeffs[i] < 0 ? -coeffs[i] : coeffs[i]));
+    }
+
+    bits = bitWidth(max);
+    return true;
+}
+
+bool mulNTT(const DensePoly& a, const DensePoly& b, DensePoly& res)
+{
+    if (a.isZero() || b.isZero())
+    {
+        res = DensePoly();
+        return true;
+    }
+
+    std::vector<int64_t> ca, cb;
+    size_t abits, bbits;
+    size_t len = a.data().size() + b.data().size() - 1;
+    if (!toInt64Coeffs(a, ca, abits) || !toInt64Coeffs(b, cb, bbits) ||
+        abits + bbits + bitWidth(std::min(ca.size(), cb.size())) > NTT_MAX_BITS)
+        return false;
+
+    size_t n = 1;
+    while (n < len)
+        n <<= 1;
+    if (n > NTT_MAX_LENGTH)
+        return false;
+
+    std::vector<uint32_t> residues[3];
+    for (size_t k = 0; k < 3; ++k)
+    {
+        uint32_t p = NTT_PRIMES[k];
+        std::vector<uint32_t> fa(n, 0), fb(n, 0);
+        for (size_t i = 0; i < ca.size(); ++i)
+            fa[i] = (uint32_t)(((ca[i] % (int64_t)p) + p) % p);
+        for (size_t i = 0; i < cb.size(); ++i)
+            fb[i] = (uint32_t)(((cb[i] % (int64_t)p) + p) % p);
+
+        ntt(fa, false, p);
+        ntt(fb, false, p);
+        for (size_t i = 0; i < n; ++i)
+            fa[i] = (uint32_t)(((uint64_t)fa[i] * fb[i]) % p);
+        ntt(fa, true, p);
+        residues[k] = std::move(fa);
+    }
+
+    // Garner's algorithm: x = r0 + p0 (t1 + p1 t2)
+    const uint64_t p0 = NTT_PRIMES[0], p1 = NTT_PRIMES[1], p2 = NTT_PRIMES[2];
+    const uint64_t inv01 = powMod(p0, p1 - 2, p1);
+    const uint64_t inv012 = powMod((p0 * p1) % p2, p2 - 2, p2);
+    const unsigned __int128 prod = (unsigned __int128)p0 * p1 * p2;
+
+    std::vector<Integer> coeffs(len);
+    for (size_t i = 0; i < len; ++i)
+    {
+        uint64_t r0 = residues[0][i], r1 = residues[1][i], r2 = residues[2][i];
+        uint64_t t1 = ((r1 + p1 - r0 % p1) % p1) * inv01 % p1;
+        uint64_t x01 = r0 + p0 * t1;    // < p0 p1 < 2^64
+        uint64_t t2 = ((r2 + p2 - x01 % p2) % p2) * inv012 % p2;
+        unsigned __int128 x = (unsigned __int128)x01 + (unsigned __int128)p0 * p1 * t2;
+        coeffs[i] = fromInt128((x > prod / 2) ? (__int128)x - (__int128)prod : (__int128)x);
+    }
+
+    res = DensePoly(std::move(coeffs));
+    return true;
+}
+
+//
+//  Dispatch
+//
+
+DensePoly mul(const DensePoly& a, const DensePoly& b)
+{
+    size_t len = std::min(a.data().size(), b.data().size());
+    if (len < MATHSOLVER_KARATSUBA_THRESHOLD)
+        return mulSchoolbook(a, b);
+
+    DensePoly res;
+    if (len >= MATHSOLVER_NTT_THRESHOLD && mulNTT(a, b, res))
+        return res;
+    return mulKaratsuba(a, b);
+}
+
+DensePoly pow(const DensePoly& a, unsigned int n)
+{
+    DensePoly res(Integer(1));
+    DensePoly base(a);
+    while (n > 0)   // square and multiply
+    {
+        if (n & 0x1)    res = mul(res, base);
+        n >>= 1;
+        if (n > 0)      base = mul(base, base);
+    }
+
+    return res;
+}
+
+}
@@ -0,0 +1,35 @@
+#ifndef _MATHSOLVER_POLY_MATH_H_
+#define _MATHSOLVER_POLY_MATH_H_
+
+#include "../types/poly.h"
+#include "../common/base.h"
+
+// Shorter operands than this are multiplied with the schoolbook method
+#define MATHSOLVER_KARATSUBA_THRESHOLD      16
+
+// Operands at least this long are multiplied with the NTT when the coefficients allow it
+#define MATHSOLVER_NTT_THRESHOLD            16
+
+namespace MathSolver
+{
+
+// Returns the product of two polynomials using schoolbook multiplication. O(nm)
+DensePoly mulSchoolbook(const DensePoly& a, const DensePoly& b);
+
+// Returns the product of two polynomials using Karatsuba multiplication. O(n^1.58)
+DensePoly mulKaratsuba(const DensePoly& a, const DensePoly& b);
+
+// Computes the product of two polynomials with number-theoretic transforms over three primes and
+// reconstructs the exact coefficients with the Chinese remainder theorem. O(n log n). Returns false
+// and leaves 'res' unchanged if the coefficients are too large to be reconstructed exactly.
+bool mulNTT(const DensePoly& a, const DensePoly& b, DensePoly& res);
+
+// Returns the product of two polynomials, choosing the algorithm by the size of the operands.
+DensePoly mul(const DensePoly& a, const DensePoly& b);
+
+// Returns the polynomial raised to a non-negative integer power.
+DensePoly pow(const DensePoly& a, unsigned int n);
+
+}
+
+#endif
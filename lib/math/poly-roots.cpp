@@ -0,0 +1,540 @@
+#include <algorithm>
+#include <gmpxx.h>
+#include "../types/interval.h"
+#include "float-math.h"
+#include "integer-math.h"
+#include "poly-roots.h"
+
+namespace MathSolver
+{
+
+// Integer polynomial in GMP integers, lowest degree first
+using ZPoly = std::vector<mpz_class>;
+
+// Interval of the scaled domain (c/2^k, (c + 1)/2^k) and the polynomial whose roots in (0, 1)
+// are the roots of the scaled polynomial in that interval
+struct VcaNode
+{
+    ZPoly poly;
+    mpz_class c;
+    unsigned long k;
+    bool lowerRoot;     // the lower endpoint is a root that has been divided out
+};
+
+// Prime modulus for the squarefree test, 2^61 - 1
+const uint64_t SQUAREFREE_PRIME = 2305843009213693951ULL;
+
+static ZPoly toZPoly(const DensePoly& p)
+{
+    ZPoly res(p.data().size());
+    for (size_t i = 0; i < res.size(); ++i)
+        toMpz(p.data()[i], res[i].get_mpz_t());
+    return res;
+}
+
+static DensePoly fromZPoly(const ZPoly& p)
+{
+    std::vector<Integer> coeffs;
+    coeffs.reserve(p.size());
+    for (const auto& c : p)
+        coeffs.push_back(fromMpz(c.get_mpz_t()));
+    return DensePoly(std::move(coeffs));
+}
+
+// Removes zero coefficients from the top.
+static void trimZPoly(ZPoly& p)
+{
+    while (!p.empty() && p.back() == 0)
+        p.pop_back();
+}
+
+// Divides by the gcd of the coefficients and makes the leading coefficient positive.
+static void makePrimitive(ZPoly& p)
+{
+    if (p.empty())
+        return;
+
+    mpz_class g = 0;
+    for (const auto& c : p)
+        mpz_gcd(g.get_mpz_t(), g.get_mpz_t(), c.get_mpz_t());
+    if (p.back() < 0)
+        g = -g;
+    for (auto& c : p)
+        mpz_divexact(c.get_mpz_t(), c.get_mpz_t(), g.get_mpz_t());
+}
+
+// Divides by the largest power of two common to every coefficient.
+static void removePow2(ZPoly& p)
+{
+    mp_bitcnt_t shift = ~(mp_bitcnt_t)0;
+    for (const auto& c : p)
+    {
+        if (c != 0)
+            shift = std::min(shift, mpz_scan1(c.get_mpz_t(), 0));
+    }
+
+    if (shift != 0 && shift != ~(mp_bitcnt_t)0)
+    {
+        for (auto& c : p)
+            mpz_tdiv_q_2exp(c.get_mpz_t(), c.get_mpz_t(), shift);
+    }
+}
+
+static ZPoly derivativeZPoly(const ZPoly& p)
+{
+    ZPoly res;
+    for (size_t i = 1; i < p.size(); ++i)
+        res.push_back(p[i] * (unsigned long)i);
+    trimZPoly(res);
+    return res;
+}
+
+// Returns lc(b)^k * a mod b for some k, a pseudo-remainder of a by b.
+static ZPoly pseudoRemainder(ZPoly a, const ZPoly& b)
+{
+    while (a.size() >= b.size() && !a.empty())
+    {
+        size_t shift = a.size() - b.size();
+        mpz_class lead = a.back();
+        for (auto& c : a)
+            c *= b.back();
+        for (size_t i = 0; i < b.size(); ++i)
+            a[i + shift] -= lead * b[i];
+        trimZPoly(a);
+    }
+
+    return a;
+}
+
+// Returns the primitive gcd of two polynomials by the primitive remainder sequence.
+static ZPoly gcdZPoly(ZPoly a, ZPoly b)
+{
+    makePrimitive(a);
+    makePrimitive(b);
+    while (!b.empty())
+    {
+        ZPoly r = pseudoRemainder(a, b);
+        makePrimitive(r);
+        a = std::move(b);
+        b = std::move(r);
+    }
+
+    return a;
+}
+
+// Returns a / b, assuming b is primitive and divides a.
+static ZPoly divExactZPoly(ZPoly a, const ZPoly& b)
+{
+    ZPoly q(a.size() - b.size() + 1);
+    for (size_t i = q.size(); i-- > 0;)
+    {
+        mpz_divexact(q[i].get_mpz_t(), a[i + b.size() - 1].get_mpz_t(), b.back().get_mpz_t());
+        for (size_t j = 0; j < b.size(); ++j)
+            a[i + j] -= q[i] * b[j];
+    }
+
+    return q;
+}
+
+static uint64_t mulMod(uint64_t a, uint64_t b)
+{
+    return (uint64_t)((unsigned __int128)a * b % SQUAREFREE_PRIME);
+}
+
+static uint64_t invMod(uint64_t a)
+{
+    uint64_t res = 1, e = SQUAREFREE_PRIME - 2;
+    for (; e; e >>= 1, a = mulMod(a, a))
+    {
+        if (e & 1) res = mulMod(res, a);
+    }
+
+    return res;
+}
+
+// Returns true if gcd(p, p') is a constant, shown by a gcd of degree zero modulo a large prime
+// that divides neither leading coefficient. Returns false if the test is inconclusive.
+static bool isSquarefreeModP(const ZPoly& p, const ZPoly& dp)
+{
+    auto reduce = [](const ZPoly& z) {
+        std::vector<uint64_t> r(z.size());
+        for (size_t i = 0; i < z.size(); ++i)
+            r[i] = mpz_fdiv_ui(z[i].get_mpz_t(), SQUAREFREE_PRIME);
+        return r;
+    };
+
+    std::vector<uint64_t> a = reduce(p), b = reduce(dp);
+    if (a.back() == 0 || b.empty() || b.back() == 0)
+        return false;
+
+    while (b.size() > 1)
+    {
+        uint64_t inv = invMod(b.back());
+        while (a.size() >= b.size())
+        {
+            uint64_t f = mulMod(a.back(), inv);
+            size_t shift = a.size() - b.size();
+            for (size_t i = 0; i < b.size(); ++i)
+                a[i + shift] = (a[i + shift] + SQUAREFREE_PRIME - mulMod(f, b[i])) % SQUAREFREE_PRIME;
+            while (!a.empty() && a.back() == 0)
+                a.pop_back();
+        }
+
+        if (a.empty())      // b divides a: non-trivial gcd
+            return false;
+        std::swap(a, b);
+    }
+
+    return true;
+}
+
+static ZPoly squarefreeZPoly(ZPoly p)
+{
+    makePrimitive(p);
+    ZPoly dp = derivativeZPoly(p);
+    if (p.size() <= 2 || isSquarefreeModP(p, dp))
+        return p;
+
+    ZPoly g = gcdZPoly(p, dp);
+    if (g.size() <= 1)
+        return p;
+
+    ZPoly res = divExactZPoly(p, g);
+    makePrimitive(res);
+    return res;
+}
+
+// p(x) -> p(x + 1)
+static void taylorShift1(ZPoly& p)
+{
+    size_t n = p.size() - 1;
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (size_t j = n; j-- > i;)
+            p[j] += p[j + 1];
+    }
+}
+
+// Returns the number of sign changes in the coefficients, counting no further than 'limit'.
+static size_t signVariations(const ZPoly& p, size_t limit)
+{
+    size_t count = 0;
+    int last = 0;
+    for (const auto& c : p)
+    {
+        int s = sgn(c);
+        if (s == 0)
+            continue;
+        if (last != 0 && s != last && ++count >= limit)
+            break;
+        last = s;
+    }
+
+    return count;
+}
+
+static Rational dyadic(const mpz_class& num, unsigned long k)
+{
+    mpz_class den = 1;
+    den <<= k;
+    return Rational(fromMpz(num.get_mpz_t()), fromMpz(den.get_mpz_t()));
+}
+
+// Appends isolating intervals of the positive roots of a squarefree polynomial with a non-zero
+// constant term, in increasing order. If 'zeroRoot' is true, zero is a root that has been divided out.
+static void isolatePositiveRoots(ZPoly q, bool zeroRoot, std::vector<RootInterval>& roots)
+{
+    size_t n = q.size() - 1;
+    if (n == 0)
+        return;
+
+    // Every root is smaller than 1 + max |q_i / q_n| <= 2^b, so map (0, 2^b) to (0, 1)
+    size_t top = 0;
+    for (size_t i = 0; i < n; ++i)
+        top = std::max(top, mpz_sizeinbase(q[i].get_mpz_t(), 2));
+    size_t lead = mpz_sizeinbase(q[n].get_mpz_t(), 2);
+    unsigned long b = ((top + 1 > lead) ? top + 1 - lead : 0) + 1;
+    for (size_t i = 1; i <= n; ++i)
+        q[i] <<= b * i;
+    removePow2(q);
+
+    std::vector<VcaNode> pending;
+    pending.push_back({ std::move(q), 0, 0, zeroRoot });
+    while (!pending.empty())
+    {
+        VcaNode node = std::move(pending.back());
+        pending.pop_back();
+
+        bool lowerRoot = node.lowerRoot;
+        if (node.poly[0] == 0)     // root at the lower endpoint
+        {
+            roots.push_back({ dyadic(node.c << b, node.k), dyadic(node.c << b, node.k), true });
+            node.poly.erase(node.poly.begin());
+            lowerRoot = true;
+        }
+
+        size_t deg = node.poly.size() - 1;
+        if (deg == 0)
+            continue;
+
+        // Roots in (0, 1) are bounded by the sign variations of (x + 1)^n p(1 / (x + 1))
+        ZPoly t(node.poly.rbegin(), node.poly.rend());
+        taylorShift1(t);
+        size_t var = signVariations(t, 2);
+        if (var == 0)
+            continue;
+
+        if (var == 1 && !lowerRoot && t[0] != 0)    // t(0) = p(1): neither endpoint is a root
+        {
+            roots.push_back({ dyadic(node.c << b, node.k), dyadic((node.c + 1) << b, node.k), false });
+            continue;
+        }
+
+        // Split at the midpoint: 2^n p(x / 2) on the lower half, its shift by 1 on the upper half
+        ZPoly lower = std::move(node.poly);
+        for (size_t i = 0; i < deg; ++i)
+            lower[i] <<= deg - i;
+        removePow2(lower);
+
+        ZPoly upper = lower;
+        taylorShift1(upper);
+        pending.push_back({ std::move(upper), 2 * node.c + 1, node.k + 1, false });
+        pending.push_back({ std::move(lower), 2 * node.c, node.k + 1, lowerRoot });
+    }
+}
+
+// Returns the sign of p(num / den) for den > 0.
+static int signAtZPoly(const ZPoly& p, const mpz_class& num, const mpz_class& den)
+{
+    if (p.empty())
+        return 0;
+
+    // den^n p(num / den) = sum p_i num^i den^(n - i)
+    mpz_class acc = p.back(), dpow = 1;
+    for (size_t i = p.size() - 1; i-- > 0;)
+    {
+        dpow *= den;
+        acc *= num;
+        acc += p[i] * dpow;
+    }
+
+    return sgn(acc);
+}
+
+// Returns the sign of p at a Float, using interval evaluation and falling back to exact arithmetic.
+static int signAtFloat(const ZPoly& p, const std::vector<Interval>& coeffs, const Float& x, mpfr_prec_t prec)
+{
+    Interval xi(x, prec);
+    Interval acc = coeffs.back();
+    for (size_t i = coeffs.size() - 1; i-- > 0;)
+        acc = acc * xi + coeffs[i];
+
+    if (mpfr_sgn(acc.lower().data()) > 0)   return 1;
+    if (mpfr_sgn(acc.upper().data()) < 0)   return -1;
+
+    mpz_class m, den = 1;
+    mpfr_exp_t e = mpfr_get_z_2exp(m.get_mpz_t(), x.data());
+    if (e >= 0)     m <<= e;
+    else            den <<= -e;
+    return signAtZPoly(p, m, den);
+}
+
+// Returns the exact midpoint of two Floats.
+static Float midpoint(const Float& a, const Float& b)
+{
+    Float res;
+    if (a.isZero() || b.isZero())
+    {
+        mpfr_set_prec(res.data(), std::max(a.precision(), b.precision()));
+        mpfr_add(res.data(), a.data(), b.data(), MPFR_RNDN);
+    }
+    else
+    {
+        mpfr_exp_t hi = std::max(mpfr_get_exp(a.data()), mpfr_get_exp(b.data()));
+        mpfr_exp_t lo = std::min(mpfr_get_exp(a.data()) - a.precision(), mpfr_get_exp(b.data()) - b.precision());
+        mpfr_set_prec(res.data(), hi - lo + 2);
+        mpfr_add(res.data(), a.data(), b.data(), MPFR_RNDN);
+    }
+
+    mpfr_div_2ui(res.data(), res.data(), 1, MPFR_RNDN);
+    return res;
+}
+
+// Returns the Float rounded to the given precision.
+static Float roundTo(const Float& x, mpfr_prec_t prec)
+{
+    Float res;
+    mpfr_set_prec(res.data(), prec);
+    mpfr_set(res.data(), x.data(), MPFR_RNDN);
+    return res;
+}
+
+// Converts a Rational to a Float, rounded in the given direction. Dyadic rationals are exact.
+static Float rationalBound(const Rational& x, mpfr_rnd_t rnd)
+{
+    mpz_class num, den;
+    toMpz(x.numerator(), num.get_mpz_t());
+    toMpz(x.denominator(), den.get_mpz_t());
+
+    Float res;
+    mpfr_set_prec(res.data(), std::max<mpfr_prec_t>(MATHSOLVER_FLOAT_DEFAULT_PREC,
+                                                   mpz_sizeinbase(num.get_mpz_t(), 2) + mpz_sizeinbase(den.get_mpz_t(), 2) + 64));
+    mpfr_set_z(res.data(), num.get_mpz_t(), rnd);
+    mpfr_div_z(res.data(), res.data(), den.get_mpz_t(), rnd);
+    return res;
+}
+
+//
+//  Public functions
+//
+
+DensePoly derivative(const DensePoly& p)
+{
+    std::vector<Integer> coeffs;
+    for (size_t i = 1; i < p.data().size(); ++i)
+        coeffs.push_back(p.data()[i] * Integer((int64_t)i));
+    return DensePoly(std::move(coeffs));
+}
+
+DensePoly squarefreePart(const DensePoly& p)
+{
+    if (p.isZero())
+        return p;
+    return fromZPoly(squarefreeZPoly(toZPoly(p)));
+}
+
+std::vector<RootInterval> isolateRealRoots(const DensePoly& p)
+{
+    std::vector<RootInterval> roots;
+    if (p.degree() < 1)
+        return roots;
+
+    ZPoly q = squarefreeZPoly(toZPoly(p));
+    bool zero = (q[0] == 0);
+    if (zero)
+        q.erase(q.begin());
+
+    // Negative roots are the positive roots of p(-x)
+    ZPoly r = q;
+    for (size_t i = 1; i < r.size(); i += 2)
+        r[i] = -r[i];
+
+    std::vector<RootInterval> negative;
+    isolatePositiveRoots(r, zero, negative);
+    for (auto it = negative.rbegin(); it != negative.rend(); ++it)
+        roots.push_back({ -it->upper, it->lower.isZero() ? Rational() : -it->lower, it->exact });
+
+    if (zero)
+        roots.push_back({ Rational(), Rational(), true });
+
+    isolatePositiveRoots(q, zero, roots);
+    return roots;
+}
+
+int signAt(const DensePoly& p, const Rational& x)
+{
+    mpz_class num, den;
+    toMpz(x.numerator(), num.get_mpz_t());
+    toMpz(x.denominator(), den.get_mpz_t());
+    return signAtZPoly(toZPoly(p), num, den);
+}
+
+Float refineRoot(const DensePoly& p, const RootInterval& root, mpfr_prec_t prec)
+{
+    if (root.exact)
+        return rationalToFloat(root.lower, prec);
+
+    // Near the root, p(x) is a small difference of terms as wide as the coefficients, so the
+    // interval evaluation needs that many bits on top of the target precision to decide the sign
+    ZPoly z = toZPoly(p);
+    size_t width = 0;
+    for (const auto& c : z)
+        width = std::max(width, mpz_sizeinbase(c.get_mpz_t(), 2));
+
+    mpfr_prec_t wp = prec + width + 2 * mpz_sizeinbase(mpz_class(z.size()).get_mpz_t(), 2) + 32;
+    std::vector<Interval> coeffs;
+    for (const auto& c : z)
+    {
+        Float f;
+        mpfr_set_prec(f.data(), std::max<mpfr_prec_t>(2, mpz_sizeinbase(c.get_mpz_t(), 2)));
+        mpfr_set_z(f.data(), c.get_mpz_t(), MPFR_RNDN);
+        coeffs.emplace_back(f, wp);
+    }
+
+    Float lo = rationalBound(root.lower, MPFR_RNDD);
+    Float hi = rationalBound(root.upper, MPFR_RNDU);
+    int lowerSign = signAtFloat(z, coeffs, lo, wp);
+
+    // Safeguarded Newton: take the Newton step from the last iterate if it stays in the bracket and
+    // at least halves it, otherwise bisect. Every iterate shrinks the bracket by its sign.
+    Float x = midpoint(lo, hi), next, fx, dfx, step, eps;
+    for (Float* f : { &next, &fx, &dfx, &step, &eps })
+        mpfr_set_prec(f->data(), wp);
+
+    // A root exactly halfway between two Floats at 'prec' never rounds the same from both sides
+    for (size_t steps = 0; steps < 4 * (size_t)prec + 4096; ++steps)
+    {
+        Float lr = roundTo(lo, prec);
+        if (lr == roundTo(hi, prec))
+            return lr;
+
+        mpfr_set_zero(fx.data(), 1);
+        mpfr_set_zero(dfx.data(), 1);
+        for (size_t i = coeffs.size(); i-- > 0;)
+        {
+            mpfr_mul(dfx.data(), dfx.data(), x.data(), MPFR_RNDN);
+            mpfr_add(dfx.data(), dfx.data(), fx.data(), MPFR_RNDN);
+            mpfr_mul(fx.data(), fx.data(), x.data(), MPFR_RNDN);
+            mpfr_add(fx.data(), fx.data(), coeffs[i].lower().data(), MPFR_RNDN);
+        }
+
+        bool newton = !dfx.isZero();
+        if (newton)
+        {
+            mpfr_div(step.data(), fx.data(), dfx.data(), MPFR_RNDN);
+            mpfr_sub(next.data(), x.data(), step.data(), MPFR_RNDN);
+            mpfr_sub(eps.data(), hi.data(), lo.data(), MPFR_RNDU);
+            mpfr_div_2ui(eps.data(), eps.data(), 1, MPFR_RNDU);
+            newton = next > lo && next < hi && mpfr_cmpabs(step.data(), eps.data()) <= 0;
+        }
+
+        if (!newton)
+            next = midpoint(lo, hi);
+
+        int s = signAtFloat(z, coeffs, next, wp);
+        if (s == 0)                 return roundTo(next, prec);
+        else if (s == lowerSign)    lo = next;
+        else                        hi = next;
+
+        // Once the step is below the target precision, close the bracket half an ulp around the iterate
+        if (newton && !next.isZero() &&
+            (step.isZero() || mpfr_get_exp(step.data()) < mpfr_get_exp(next.data()) - prec))
+        {
+            mpfr_set_ui_2exp(eps.data(), 1, mpfr_get_exp(next.data()) - prec - 1, MPFR_RNDN);
+            Float a, b;
+            mpfr_set_prec(a.data(), wp);
+            mpfr_set_prec(b.data(), wp);
+            mpfr_sub(a.data(), next.data(), eps.data(), MPFR_RNDN);
+            mpfr_add(b.data(), next.data(), eps.data(), MPFR_RNDN);
+            if (a > lo)
+            {
+                int sa = signAtFloat(z, coeffs, a, wp);
+                if (sa == 0)                return roundTo(a, prec);
+                else if (sa == lowerSign)   lo = a;
+            }
+
+            if (b < hi)
+            {
+                int sb = signAtFloat(z, coeffs, b, wp);
+                if (sb == 0)                return roundTo(b, prec);
+                else if (sb != lowerSign)   hi = b;
+            }
+        }
+
+        x = next;
+    }
+
+    return roundTo(lo, prec);
+}
+
+}
@@ -0,0 +1,44 @@
+#ifndef _MATHSOLVER_POLY_ROOTS_H_
+#define _MATHSOLVER_POLY_ROOTS_H_
+
+#include <vector>
+#include "../common/base.h"
+#include "../types/float.h"
+#include "../types/poly.h"
+#include "../types/rational.h"
+
+namespace MathSolver
+{
+
+// Isolating interval of a real root. If 'exact' is true, the root is exactly 'lower' (= 'upper').
+// Otherwise the root is the only root in the open interval (lower, upper) and neither endpoint
+// is a root.
+struct RootInterval
+{
+    Rational lower;
+    Rational upper;
+    bool exact;
+};
+
+// Returns the derivative of a polynomial.
+DensePoly derivative(const DensePoly& p);
+
+// Returns the primitive squarefree part p / gcd(p, p') with a positive leading coefficient. It has
+// the same real roots as p, each with multiplicity one.
+DensePoly squarefreePart(const DensePoly& p);
+
+// Returns disjoint isolating intervals for the distinct real roots of a non-zero polynomial, in
+// increasing order. Uses Descartes' rule of signs with Vincent-Collins-Akritas bisection on the
+// squarefree part. Endpoints are dyadic rationals.
+std::vector<RootInterval> isolateRealRoots(const DensePoly& p);
+
+// Returns the sign of p(x): 1, -1 or 0. Exact.
+int signAt(const DensePoly& p, const Rational& x);
+
+// Refines an isolating interval by safeguarded Newton steps and returns the root rounded to the given precision.
+// The polynomial must change sign at the root, e.g. the squarefree part.
+Float refineRoot(const DensePoly& p, const RootInterval& root, mpfr_prec_t prec = MATHSOLVER_FLOAT_DEFAULT_PREC);
+
+}
+
+#endif
@@ -0,0 +1,416 @@
+#include <algorithm>
+#include <map>
+#include <string>
+#include "simplex.h"
+
+namespace MathSolver
+{
+
+// Simplex dictionary for constraints a_i . x <= b_i over free variables. Every basic variable is
+// cst[r] + sum_k T[r][k] * (nonbasic variable k). Variables 0, ..., n - 1 are the unknowns,
+// n + i is the slack b_i - a_i . x >= 0 of constraint i and n + m is the phase one variable.
+// Strict constraints are read as not strict.
+class SimplexTableau
+{
+public:
+
+    SimplexTableau(const std::vector<LinearConstraint>& rows, size_t n);
+
+    // Finds a feasible dictionary. Returns false if there is none.
+    bool phaseOne();
+
+    // Maximizes objective . x from a feasible dictionary.
+    LinearSystem::Status maximize(const std::vector<Rational>& objective, Rational& value);
+
+    // Writes the values of the unknowns in the current basic solution.
+    void solution(std::vector<Rational>& point) const;
+
+private:
+
+    // Exchanges the basic variable of row r with the nonbasic variable of column k.
+    void pivot(size_t r, size_t k);
+
+    // Runs the simplex method on the objective row with Bland's rule.
+    LinearSystem::Status iterate();
+
+    // Unknowns are free; every other variable is non-negative.
+    inline bool isFree(size_t var) const { return var < mFree; }
+
+private:
+    std::vector<std::vector<Rational>> mT;
+    std::vector<Rational> mCst;
+    std::vector<Rational> mObj;
+    Rational mObjCst;
+    std::vector<size_t> mBasic;
+    std::vector<size_t> mNonbasic;
+    size_t mFree;
+};
+
+SimplexTableau::SimplexTableau(const std::vector<LinearConstraint>& rows, size_t n)
+    : mT(rows.size(), std::vector<Rational>(n)), mCst(rows.size()), mBasic(rows.size()), mNonbasic(n), mFree(n)
+{
+    for (size_t r = 0; r < rows.size(); ++r)
+    {
+        for (size_t j = 0; j < n && j < rows[r].coeffs.size(); ++j)
+            mT[r][j] = -rows[r].coeffs[j];
+        mCst[r] = rows[r].bound;
+        mBasic[r] = n + r;
+    }
+
+    for (size_t k = 0; k < n; ++k)
+        mNonbasic[k] = k;
+
+    // Free unknowns never leave the basis, so they are pivoted in first and their rows are then
+    // only definitions. An unknown that appears in no constraint stays nonbasic at zero.
+    for (size_t k = 0; k < n; ++k)
+    {
+        for (size_t r = 0; r < mT.size(); ++r)
+        {
+            if (!isFree(mBasic[r]) && !mT[r][k].isZero())
+            {
+                pivot(r, k);
+                break;
+            }
+        }
+    }
+}
+
+void SimplexTableau::pivot(size_t r, size_t k)
+{
+    std::vector<Rational>& row = mT[r];
+    Rational inv = Rational(Integer(1)) / row[k];
+    mCst[r] = -(mCst[r] * inv);
+    for (size_t j = 0; j < row.size(); ++j)
+    {
+        if (j != k && !row[j].isZero())
+            row[j] = -(row[j] * inv);
+    }
+    row[k] = inv;
+    std::swap(mBasic[r], mNonbasic[k]);
+
+    auto substitute = [&](std::vector<Rational>& other, Rational& cst) {
+        if (other[k].isZero())
+            return;
+
+        Rational f = other[k];
+        cst += f * mCst[r];
+        for (size_t j = 0; j < row.size(); ++j)
+        {
+            if (j != k && !row[j].isZero())
+                other[j] += f * row[j];
+        }
+        other[k] = f * inv;
+    };
+
+    for (size_t i = 0; i < mT.size(); ++i)
+    {
+        if (i != r)
+            substitute(mT[i], mCst[i]);
+    }
+
+    if (!mObj.empty())
+        substitute(mObj, mObjCst);
+}
+
+LinearSystem::Status SimplexTableau::iterate()
+{
+    while (true)
+    {
+        // Entering variable: the lowest-numbered one that increases the objective. A free
+        // nonbasic unknown appears in no constraint, so any dependence on it is unbounded.
+        size_t e = mNonbasic.size();
+        for (size_t k = 0; k < mNonbasic.size(); ++k)
+        {
+            if (mObj[k].isZero())
+                continue;
+            if (isFree(mNonbasic[k]))
+                return LinearSystem::UNBOUNDED;
+            if (!mObj[k].sign() && (e == mNonbasic.size() || mNonbasic[k] < mNonbasic[e]))
+                e = k;
+        }
+
+        if (e == mNonbasic.size())
+            return LinearSystem::OPTIMAL;
+
+        // Leaving variable: the tightest constraint, ties broken by the lowest-numbered variable
+        size_t l = mT.size();
+        Rational best;
+        for (size_t r = 0; r < mT.size(); ++r)
+        {
+            if (isFree(mBasic[r]) || mT[r][e].isZero() || !mT[r][e].sign())
+                continue;
+
+            Rational ratio = mCst[r] / -mT[r][e];
+            int cmp = (l == mT.size()) ? -1 : ratio.compare(best);
+            if (cmp < 0 || (cmp == 0 && mBasic[r] < mBasic[l]))
+            {
+                l = r;
+                best = ratio;
+            }
+        }
+
+        if (l == mT.size())
+            return LinearSystem::UNBOUNDED;
+        pivot(l, e);
+    }
+}
+
+bool SimplexTableau::phaseOne()
+{
+    size_t worst = mT.size();
+    for (size_t r = 0; r < mT.size(); ++r)
+    {
+        if (!isFree(mBasic[r]) && mCst[r].sign() && (worst == mT.size() || mCst[r] < mCst[worst]))
+            worst = r;
+    }
+
+    if (worst == mT.size())     // the basic solution is feasible
+        return true;
+
+    // Relax every constraint by x0 >= 0 and minimize x0, starting from the most violated one
+    size_t aux = mNonbasic.size();
+    size_t auxVar = mFree + mT.size();
+    for (size_t r = 0; r < mT.size(); ++r)
+        mT[r].push_back(Rational(Integer(isFree(mBasic[r]) ? 0 : 1)));
+    mNonbasic.push_back(auxVar);
+    mObj.assign(mNonbasic.size(), Rational());
+    mObj[aux] = Rational(Integer(-1));
+    mObjCst = Rational();
+
+    pivot(worst, aux);
+    iterate();
+    bool feasible = !mObjCst.sign();
+
+    // Drive x0 out of the basis. Its value is zero, so any pivot keeps the dictionary feasible.
+    auto it = std::find(mBasic.begin(), mBasic.end(), auxVar);
+    if (feasible && it != mBasic.end())
+    {
+        size_t r = it - mBasic.begin();
+        size_t k = 0;
+        while (k < mNonbasic.size() && mT[r][k].isZero())
+            ++k;
+
+        if (k < mNonbasic.size())
+        {
+            pivot(r, k);
+        }
+        else
+        {
+            mT.erase(mT.begin() + r);
+            mCst.erase(mCst.begin() + r);
+            mBasic.erase(mBasic.begin() + r);
+        }
+    }
+
+    aux = std::find(mNonbasic.begin(), mNonbasic.end(), auxVar) - mNonbasic.begin();
+    if (aux < mNonbasic.size())
+    {
+        for (auto& row : mT)
+            row.erase(row.begin() + aux);
+        mNonbasic.erase(mNonbasic.begin() + aux);
+    }
+
+    mObj.clear();
+    return feasible;
+}
+
+LinearSystem::Status SimplexTableau::maximize(const std::vector<Rational>& objective, Rational& value)
+{
+    // Rewrite the objective over the nonbasic variables
+    mObj.assign(mNonbasic.size(), Rational());
+    mObjCst = Rational();
+    for (size_t r = 0; r < mT.size(); ++r)
+    {
+        if (mBasic[r] >= objective.size() || objective[mBasic[r]].isZero())
+            continue;
+
+        const Rational& c = objective[mBasic[r]];
+        mObjCst += c * mCst[r];
+        for (size_t k = 0; k < mNonbasic.size(); ++k)
+        {
+            if (!mT[r][k].isZero())
+                mObj[k] += c * mT[r][k];
+        }
+    }
+
+    for (size_t k = 0; k < mNonbasic.size(); ++k)
+    {
+        if (mNonbasic[k] < objective.size())
+            mObj[k] += objective[mNonbasic[k]];
+    }
+
+    LinearSystem::Status status = iterate();
+    value = mObjCst;
+    return status;
+}
+
+void SimplexTableau::solution(std::vector<Rational>& point) const
+{
+    point.assign(mFree, Rational());
+    for (size_t r = 0; r < mT.size(); ++r)
+    {
+        if (isFree(mBasic[r]))
+            point[mBasic[r]] = mCst[r];
+    }
+}
+
+//
+//  LinearSystem
+//
+
+LinearSystem::LinearSystem(size_t varCount)
+    : mVars(varCount)
+{
+}
+
+void LinearSystem::add(const std::vector<Rational>& coeffs, const Rational& bound, bool strict)
+{
+    LinearConstraint c{ coeffs, bound, strict };
+    c.coeffs.resize(mVars);
+    mRows.push_back(std::move(c));
+}
+
+bool LinearSystem::feasible(std::vector<Rational>* point) const
+{
+    if (std::none_of(mRows.begin(), mRows.end(), [](const LinearConstraint& c) { return c.strict; }))
+    {
+        SimplexTableau tableau(mRows, mVars);
+        if (!tableau.phaseOne())
+            return false;
+
+        if (point)
+            tableau.solution(*point);
+        return true;
+    }
+
+    // Tighten the strict constraints by a margin t <= 1 and maximize it: a_i . x + t <= b_i
+    std::vector<LinearConstraint> rows = mRows;
+    for (auto& c : rows)
+        c.coeffs.push_back(c.strict ? Rational(Integer(1)) : Rational());
+
+    std::vector<Rational> margin(mVars + 1);
+    margin[mVars] = Rational(Integer(1));
+    rows.push_back({ margin, Rational(Integer(1)), false });
+
+    SimplexTableau tableau(rows, mVars + 1);
+    Rational value;
+    if (!tableau.phaseOne() || tableau.maximize(margin, value) != OPTIMAL || value.sign() || value.isZero())
+        return false;
+
+    if (point)
+    {
+        tableau.solution(*point);
+        point->pop_back();
+    }
+
+    return true;
+}
+
+LinearSystem::Status LinearSystem::maximize(const std::vector<Rational>& objective, Rational& value, std::vector<Rational>* point) const
+{
+    SimplexTableau tableau(mRows, mVars);
+    if (!tableau.phaseOne())
+        return INFEASIBLE;
+
+    Status status = tableau.maximize(objective, value);
+    if (status == OPTIMAL && point)
+        tableau.solution(*point);
+    return status;
+}
+
+bool LinearSystem::project(size_t var, LinearBound& lower, LinearBound& upper) const
+{
+    if (!feasible())
+        return false;
+
+    // The closure of a non-empty system is the system with no strict constraints, so its extrema
+    // bound the projection. An extremum belongs to the projection if the system still has a point
+    // after fixing x_var to it.
+    for (int dir : { -1, 1 })
+    {
+        LinearBound& bound = (dir < 0) ? lower : upper;
+        std::vector<Rational> objective(mVars);
+        objective[var] = Rational(Integer(dir));
+
+        Rational value;
+        if (maximize(objective, value) != OPTIMAL)
+        {
+            bound = LinearBound{ Rational(), true, false };
+            continue;
+        }
+
+        LinearSystem fixed = *this;
+        objective[var] = Rational(Integer(-dir));
+        fixed.add(objective, -value, false);
+        bound = LinearBound{ (dir < 0) ? -value : value, false, fixed.feasible() };
+    }
+
+    return true;
+}
+
+std::vector<size_t> LinearSystem::reduce() const
+{
+    // Parallel constraints: scale each so its first non-zero coefficient is 1 or -1 and keep the
+    // tightest bound of each direction
+    std::map<std::vector<std::string>, std::pair<size_t, Rational>> directions;
+    for (size_t i = 0; i < mRows.size(); ++i)
+    {
+        const LinearConstraint& c = mRows[i];
+        auto first = std::find_if(c.coeffs.begin(), c.coeffs.end(), [](const Rational& a) { return !a.isZero(); });
+        if (first == c.coeffs.end())    // 0 < b
+        {
+            if (c.bound.sign() || (c.bound.isZero() && c.strict))
+                return { i };
+            continue;
+        }
+
+        Rational scale = first->sign() ? -*first : *first;
+        std::vector<std::string> key;
+        for (const auto& a : c.coeffs)
+            key.push_back((a / scale).toString());
+
+        Rational bound = c.bound / scale;
+        auto it = directions.find(key);
+        if (it == directions.end())
+        {
+            directions.emplace(std::move(key), std::make_pair(i, bound));
+        }
+        else
+        {
+            int cmp = bound.compare(it->second.second);
+            if (cmp < 0 || (cmp == 0 && c.strict && !mRows[it->second.first].strict))
+                it->second = std::make_pair(i, bound);
+        }
+    }
+
+    std::vector<size_t> kept;
+    for (const auto& e : directions)
+        kept.push_back(e.second.first);
+    std::sort(kept.begin(), kept.end());
+
+    // A constraint is implied by the others if they have no point violating it
+    for (size_t k = 0; k < kept.size();)
+    {
+        LinearSystem others(mVars);
+        for (size_t j = 0; j < kept.size(); ++j)
+        {
+            if (j != k)
+                others.mRows.push_back(mRows[kept[j]]);
+        }
+
+        const LinearConstraint& c = mRows[kept[k]];
+        std::vector<Rational> negated(mVars);
+        for (size_t j = 0; j < mVars; ++j)
+            negated[j] = -c.coeffs[j];
+        others.add(negated, -c.bound, !c.strict);
+
+        if (others.feasible())
+            ++k;
+        else
+            kept.erase(kept.begin() + k);
+    }
+
+    return kept;
+}
+
+}
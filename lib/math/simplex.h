@@ -0,0 +1,78 @@
+#ifndef _MATHSOLVER_SIMPLEX_H_
+#define _MATHSOLVER_SIMPLEX_H_
+
+#include <vector>
+#include "../common/base.h"
+#include "../types/rational.h"
+
+namespace MathSolver
+{
+
+// Linear constraint coeffs . x < bound, or coeffs . x <= bound if not strict.
+struct LinearConstraint
+{
+    std::vector<Rational> coeffs;
+    Rational bound;
+    bool strict;
+};
+
+// Bound of a linear function over a system: the supremum or infimum 'value', unless 'infinite',
+// and whether some point of the system attains it.
+struct LinearBound
+{
+    Rational value;
+    bool infinite;
+    bool closed;
+};
+
+// Conjunction of linear constraints over the real variables x_0, ..., x_{n-1}, solved exactly
+// by the simplex method over Rationals. The tableau keeps one row per constraint and one column
+// per variable, so a pivot costs O(mn) for m constraints. Bland's rule guarantees termination.
+class LinearSystem
+{
+public:
+
+    enum Status
+    {
+        INFEASIBLE,
+        UNBOUNDED,
+        OPTIMAL
+    };
+
+    // Constructs the empty system over 'varCount' variables.
+    LinearSystem(size_t varCount);
+
+    // Adds the constraint coeffs . x < bound, or <= if not strict. Missing coefficients are zero.
+    void add(const std::vector<Rational>& coeffs, const Rational& bound, bool strict);
+
+    // Returns true if some point satisfies every constraint. If 'point' is given, writes such a
+    // point: a vertex of the system with every strict constraint tightened by the same margin.
+    bool feasible(std::vector<Rational>* point = nullptr) const;
+
+    // Maximizes objective . x over the closure of the system, where strict constraints are not
+    // strict. On OPTIMAL, sets 'value' and, if given, an optimal vertex 'point'.
+    Status maximize(const std::vector<Rational>& objective, Rational& value, std::vector<Rational>* point = nullptr) const;
+
+    // Projects the system onto one variable: sets the infimum and supremum of x_var over the
+    // system. Returns false if the system is infeasible.
+    bool project(size_t var, LinearBound& lower, LinearBound& upper) const;
+
+    // Returns the indices of an irredundant subset of the constraints defining the same set: exact
+    // duplicates and weaker parallel constraints are dropped, then every constraint implied by
+    // the others. Solves one system per remaining constraint.
+    std::vector<size_t> reduce() const;
+
+    // Returns the constraints.
+    inline const std::vector<LinearConstraint>& constraints() const { return mRows; }
+
+    // Returns the number of variables.
+    inline size_t varCount() const { return mVars; }
+
+private:
+    std::vector<LinearConstraint> mRows;
+    size_t mVars;
+};
+
+}
+
+#endif
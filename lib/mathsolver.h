@@ -3,21 +3,38 @@
 
 #include "common/base.h"
 
+#include "eval/adaptive.h"
 #include "eval/arithmetic.h"
 #include "eval/arithrr.h"
+#include "eval/bisection.h"
+#include "eval/boolean.h"
+#include "eval/booleval.h"
+#include "eval/enclosure.h"
 #include "eval/evaluator.h"
 #include "eval/inequality.h"
 #include "eval/inequalityrr.h"
+#include "eval/polyeval.h"
+#include "eval/predicate.h"
 
 #include "expr/arithmetic.h"
 #include "expr/expr.h"
 #include "expr/parser.h"
 #include "expr/polynomial.h"
 
+#include "math/ball-math.h"
 #include "math/float-math.h"
 #include "math/integer-math.h"
+#include "math/interval-math.h"
+#include "math/poly-math.h"
+#include "math/poly-roots.h"
+#include "math/simplex.h"
 
+#include "types/ball.h"
+#include "types/bdd.h"
 #include "types/float.h"
 #include "types/integer.h"
+#include "types/interval.h"
+#include "types/range-index.h"
+#include "types/rational.h"
 
 #endif
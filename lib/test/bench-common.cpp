@@ -0,0 +1,35 @@
+#include <cstdio>
+#include "bench-common.h"
+
+namespace MathSolver
+{
+
+std::string BenchModule::result() const
+{
+    std::string results = "\"" + mName + "\"";
+    for (const std::string& s : mResults)
+        results += ("\n    " + s);
+    return results;
+}
+
+void BenchModule::record(const std::string& label, double usec)
+{
+    char buf[64];
+    if (usec >= 1e6)        snprintf(buf, sizeof(buf), "%.3f s", usec / 1e6);
+    else if (usec >= 1e3)   snprintf(buf, sizeof(buf), "%.3f ms", usec / 1e3);
+    else                    snprintf(buf, sizeof(buf), "%.3f us", usec);
+    mResults.push_back(label + "\t" + buf);
+}
+
+void BenchModule::note(const std::string& label, const std::string& value)
+{
+    mResults.push_back(label + "\t" + value);
+}
+
+void BenchModule::reset(const std::string& name)
+{
+    mName = name;
+    mResults.clear();
+}
+
+} // END MathSolver namespace
@@ -0,0 +1,59 @@
+#ifndef _MATHSOLVER_BENCH_COMMON_H_
+#define _MATHSOLVER_BENCH_COMMON_H_
+
+#include <chrono>
+#include <stddef.h>
+#include <string>
+#include <vector>
+#include "../common/base.h"
+
+namespace MathSolver
+{
+
+class BenchModule
+{
+public:
+
+    // Default constructor
+    BenchModule(const std::string& name) : mName(name) {}
+
+    // No copying, assigning
+    BenchModule(const BenchModule&) = delete;
+    BenchModule& operator=(const BenchModule&) = delete;
+
+    // Returns the timings of the module as a string.
+    std::string result() const;
+
+    // Calls the nullary function 'count' times and records the average time of a single call.
+    // Returns the average time in microseconds.
+    template <typename Func>
+    double run(const std::string& label, size_t count, const Func& func)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < count; ++i)
+            func();
+        auto end = std::chrono::steady_clock::now();
+
+        double usec = std::chrono::duration<double, std::micro>(end - start).count() / (count ? count : 1);
+        record(label, usec);
+        return usec;
+    }
+
+    // Records a timing (in microseconds) measured by the caller.
+    void record(const std::string& label, double usec);
+
+    // Records an arbitrary statistic alongside the timings.
+    void note(const std::string& label, const std::string& value);
+
+    // Sets the name of the module and clears the recorded timings.
+    void reset(const std::string& name);
+
+private:
+
+    std::vector<std::string> mResults;
+    std::string mName;
+};
+
+} // END MathSolver namespace
+
+#endif
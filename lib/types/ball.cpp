@@ -0,0 +1,190 @@
+#include <algorithm>
+#include "ball.h"
+
+namespace MathSolver
+{
+
+Float Ball::zeroRadius()
+{
+    Float f;
+    mpfr_set_prec(f.data(), MATHSOLVER_BALL_RAD_PREC);
+    mpfr_set_zero(f.data(), 1);
+    return f;
+}
+
+Ball::Ball(mpfr_prec_t prec)
+    : mRad(zeroRadius())
+{
+    mpfr_set_prec(mMid.data(), prec);
+    mpfr_set_zero(mMid.data(), 1);
+}
+
+Ball::Ball(const Float& x, mpfr_prec_t prec, bool exact)
+    : Ball(prec)
+{
+    addError(mpfr_set(mMid.data(), x.data(), MPFR_RNDN));
+    if (!exact && mpfr_regular_p(x.data()))     // ulp of x at its own precision
+    {
+        Float ulp = zeroRadius();
+        mpfr_set_ui_2exp(ulp.data(), 1, mpfr_get_exp(x.data()) - x.precision(), MPFR_RNDU);
+        mpfr_add(mRad.data(), mRad.data(), ulp.data(), MPFR_RNDU);
+    }
+}
+
+Ball Ball::undef(mpfr_prec_t prec)
+{
+    Ball res(prec);
+    mpfr_set_nan(res.mMid.data());
+    mpfr_set_inf(res.mRad.data(), 1);
+    return res;
+}
+
+Ball Ball::unbounded(mpfr_prec_t prec)
+{
+    Ball res(prec);
+    mpfr_set_inf(res.mRad.data(), 1);
+    return res;
+}
+
+Ball Ball::operator+(const Ball& other) const
+{
+    Ball res(std::max(precision(), other.precision()));
+    int t = mpfr_add(res.mMid.data(), mMid.data(), other.mMid.data(), MPFR_RNDN);
+    mpfr_add(res.mRad.data(), mRad.data(), other.mRad.data(), MPFR_RNDU);
+    res.addError(t);
+    return res;
+}
+
+Ball Ball::operator-(const Ball& other) const
+{
+    Ball res(std::max(precision(), other.precision()));
+    int t = mpfr_sub(res.mMid.data(), mMid.data(), other.mMid.data(), MPFR_RNDN);
+    mpfr_add(res.mRad.data(), mRad.data(), other.mRad.data(), MPFR_RNDU);
+    res.addError(t);
+    return res;
+}
+
+Ball Ball::operator*(const Ball& other) const
+{
+    // |xy - ab| <= |a|s + |b|r + rs for x in [a - r, a + r], y in [b - s, b + s]
+    Ball res(std::max(precision(), other.precision()));
+    Float a = zeroRadius(), b = zeroRadius();
+    int t = mpfr_mul(res.mMid.data(), mMid.data(), other.mMid.data(), MPFR_RNDN);
+    mpfr_abs(a.data(), mMid.data(), MPFR_RNDU);
+    mpfr_abs(b.data(), other.mMid.data(), MPFR_RNDU);
+    mpfr_mul(a.data(), a.data(), other.mRad.data(), MPFR_RNDU);
+    mpfr_mul(b.data(), b.data(), mRad.data(), MPFR_RNDU);
+    mpfr_mul(res.mRad.data(), mRad.data(), other.mRad.data(), MPFR_RNDU);
+    mpfr_add(res.mRad.data(), res.mRad.data(), a.data(), MPFR_RNDU);
+    mpfr_add(res.mRad.data(), res.mRad.data(), b.data(), MPFR_RNDU);
+    res.addError(t);
+    return res;
+}
+
+Ball Ball::operator/(const Ball& other) const
+{
+    // |x/y - a/b| <= (|a|s + |b|r) / (|b|(|b| - s)) for x in [a - r, a + r], y in [b - s, b + s]
+    mpfr_prec_t prec = std::max(precision(), other.precision());
+    if (isUndef() || other.isUndef() || (other.isExact() && other.mid().isZero()))
+        return undef(prec);
+    if (other.containsZero())
+        return unbounded(prec);
+
+    Ball res(prec);
+    Float num = zeroRadius(), tmp = zeroRadius(), den = zeroRadius();
+    int t = mpfr_div(res.mMid.data(), mMid.data(), other.mMid.data(), MPFR_RNDN);
+    mpfr_abs(num.data(), mMid.data(), MPFR_RNDU);
+    mpfr_mul(num.data(), num.data(), other.mRad.data(), MPFR_RNDU);
+    mpfr_abs(tmp.data(), other.mMid.data(), MPFR_RNDU);
+    mpfr_mul(tmp.data(), tmp.data(), mRad.data(), MPFR_RNDU);
+    mpfr_add(num.data(), num.data(), tmp.data(), MPFR_RNDU);
+
+    mpfr_abs(den.data(), other.mMid.data(), MPFR_RNDD);
+    mpfr_sub(tmp.data(), den.data(), other.mRad.data(), MPFR_RNDD);
+    if (mpfr_sgn(tmp.data()) <= 0)
+        return unbounded(prec);
+
+    mpfr_mul(den.data(), den.data(), tmp.data(), MPFR_RNDD);
+    mpfr_div(res.mRad.data(), num.data(), den.data(), MPFR_RNDU);
+    res.addError(t);
+    return res;
+}
+
+Ball Ball::operator-() const
+{
+    Ball res(*this);
+    mpfr_neg(res.mMid.data(), res.mMid.data(), MPFR_RNDN);
+    return res;
+}
+
+bool Ball::containsZero() const
+{
+    return !isFinite() || mpfr_cmpabs(mMid.data(), mRad.data()) <= 0;
+}
+
+Float Ball::lower() const
+{
+    Float res;
+    mpfr_set_prec(res.data(), precision());
+    mpfr_sub(res.data(), mMid.data(), mRad.data(), MPFR_RNDD);
+    return res;
+}
+
+Float Ball::upper() const
+{
+    Float res;
+    mpfr_set_prec(res.data(), precision());
+    mpfr_add(res.data(), mMid.data(), mRad.data(), MPFR_RNDU);
+    return res;
+}
+
+// Returns the value printed with the given number of significant digits.
+std::string toDigits(const Float& x, size_t digits)
+{
+    char* c;
+    mpfr_asprintf(&c, "%.*Rg", (int)digits, x.data());
+    std::string s(c);
+    mpfr_free_str(c);
+    return s;
+}
+
+bool Ball::roundsTo(size_t digits, std::string& str) const
+{
+    if (!isFinite())
+        return false;
+
+    if (isExact())
+    {
+        str = toDigits(mMid, digits);
+        return true;
+    }
+
+    // Rounding is monotone: if both bounds round to the same string, so does every point between
+    std::string lo = toDigits(lower(), digits);
+    if (lo != toDigits(upper(), digits))
+        return false;
+
+    str = lo;
+    return true;
+}
+
+void Ball::addError(int t)
+{
+    if (t != 0 && mpfr_regular_p(mMid.data()))    // inexact: error is at most one ulp
+    {
+        Float ulp = zeroRadius();
+        mpfr_set_ui_2exp(ulp.data(), 1, mpfr_get_exp(mMid.data()) - precision(), MPFR_RNDU);
+        mpfr_add(mRad.data(), mRad.data(), ulp.data(), MPFR_RNDU);
+    }
+}
+
+std::string Ball::toString() const
+{
+    char* c;
+    mpfr_asprintf(&c, "%.16Rg +/- %.3Rg", mMid.data(), mRad.data());
+    std::string s(c);
+    mpfr_free_str(c);
+    return s;
+}
+
+}
@@ -0,0 +1,90 @@
+#ifndef _MATHSOLVER_BALL_H_
+#define _MATHSOLVER_BALL_H_
+
+#include <string>
+#include "../common/base.h"
+#include "float.h"
+
+// Precision of the radius in bits. Radii are always rounded up.
+#define MATHSOLVER_BALL_RAD_PREC    32
+
+namespace MathSolver
+{
+
+// Midpoint-radius interval [mid - rad, mid + rad] for rigorous error tracking. The midpoint is
+// computed at the working precision with round to nearest, and each operation adds a bound on its
+// own rounding error to the radius, so the ball always contains the exact result.
+class Ball
+{
+public:
+
+    // Constructs the exact ball 0 at the given working precision.
+    Ball(mpfr_prec_t prec = MATHSOLVER_FLOAT_DEFAULT_PREC);
+
+    // Constructs a ball around a value at the given working precision. If 'exact' is false, the
+    // value is assumed to be rounded at its own precision and the radius covers that error.
+    Ball(const Float& x, mpfr_prec_t prec, bool exact = true);
+
+    // Returns the ball containing every real number, for a result that is undefined at any
+    // working precision, e.g. 1/0.
+    static Ball undef(mpfr_prec_t prec);
+
+    // Returns the ball containing every real number, for a result that cannot be bounded at the
+    // working precision but may be at a higher one, e.g. 1/x where x is inexact and contains zero.
+    static Ball unbounded(mpfr_prec_t prec);
+
+    Ball operator+(const Ball& other) const;   // Addition
+    Ball operator-(const Ball& other) const;   // Subtraction
+    Ball operator*(const Ball& other) const;   // Multiplication
+    Ball operator/(const Ball& other) const;   // Division. Unbounded if the divisor contains zero.
+    Ball operator-() const;                    // Negation
+
+    // Returns true if zero is inside the ball.
+    bool containsZero() const;
+
+    // Returns true if the radius is zero.
+    inline bool isExact() const { return mRad.isZero(); }
+
+    // Returns true if the ball is bounded.
+    inline bool isFinite() const { return mpfr_number_p(mMid.data()) && mpfr_number_p(mRad.data()); }
+
+    // Returns true if the ball is undefined (see undef).
+    inline bool isUndef() const { return mpfr_nan_p(mMid.data()); }
+
+    // Returns the lower and upper bounds of the ball, rounded outwards.
+    Float lower() const;
+    Float upper() const;
+
+    // Returns the midpoint.
+    inline const Float& mid() const { return mMid; }
+    inline Float& mid() { return mMid; }
+
+    // Returns the radius.
+    inline const Float& rad() const { return mRad; }
+    inline Float& rad() { return mRad; }
+
+    // Returns the working precision in bits.
+    inline mpfr_prec_t precision() const { return mMid.precision(); }
+
+    // Returns true if every number in the ball rounds to the same decimal string with the given
+    // number of significant digits, and stores that string.
+    bool roundsTo(size_t digits, std::string& str) const;
+
+    // Adds the rounding error of an operation that stored its result at the midpoint and returned
+    // the MPFR ternary value 't'.
+    void addError(int t);
+
+    // Converts this ball to a std::string, "mid +/- rad".
+    std::string toString() const;
+
+    // Returns a zero Float with the precision of a radius.
+    static Float zeroRadius();
+
+private:
+    Float mMid;
+    Float mRad;
+};
+
+}
+
+#endif
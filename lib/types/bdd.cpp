@@ -0,0 +1,189 @@
+#include <algorithm>
+#include "bdd.h"
+
+namespace MathSolver
+{
+
+Bdd::Bdd(size_t varCount)
+    : mVars(varCount)
+{
+    // Terminals are tested after every variable
+    mNodes.push_back({ (uint32_t)varCount, ZERO, ZERO });
+    mNodes.push_back({ (uint32_t)varCount, ONE, ONE });
+}
+
+Bdd::Ref Bdd::variable(size_t var)
+{
+    return makeNode((uint32_t)var, ZERO, ONE);
+}
+
+Bdd::Ref Bdd::makeNode(uint32_t var, Ref low, Ref high)
+{
+    if (low == high)
+        return low;
+
+    Key key{ var, low, high };
+    auto it = mUnique.find(key);
+    if (it != mUnique.end())
+        return it->second;
+
+    Ref ref = (Ref)mNodes.size();
+    mNodes.push_back({ var, low, high });
+    mUnique.emplace(key, ref);
+    return ref;
+}
+
+Bdd::Ref Bdd::ite(Ref f, Ref g, Ref h)
+{
+    if (f == ONE)                   return g;
+    if (f == ZERO)                  return h;
+    if (g == h)                     return g;
+    if (g == ONE && h == ZERO)      return f;
+
+    Key key{ f, g, h };
+    auto it = mIteCache.find(key);
+    if (it != mIteCache.end())
+        return it->second;
+
+    uint32_t var = std::min({ mNodes[f].var, mNodes[g].var, mNodes[h].var });
+    Ref high = ite(cofactor(f, var, true), cofactor(g, var, true), cofactor(h, var, true));
+    Ref low = ite(cofactor(f, var, false), cofactor(g, var, false), cofactor(h, var, false));
+    Ref res = makeNode(var, low, high);
+    mIteCache.emplace(key, res);
+    return res;
+}
+
+Bdd::Cube Bdd::satisfy(Ref f) const
+{
+    Cube cube;
+    while (f != ONE)
+    {
+        const Node& n = mNodes[f];
+        bool value = (n.high != ZERO);  // every non-terminal node has a path to ONE
+        cube.emplace_back(n.var, value);
+        f = value ? n.high : n.low;
+    }
+
+    return cube;
+}
+
+double Bdd::satCount(Ref f) const
+{
+    // Fraction of assignments reaching ONE, memoized per node
+    std::unordered_map<Ref, double> memo;
+    auto fraction = [&](Ref r, auto& self) -> double {
+        if (r == ZERO)  return 0.0;
+        if (r == ONE)   return 1.0;
+
+        auto it = memo.find(r);
+        if (it != memo.end())
+            return it->second;
+
+        double res = 0.5 * (self(mNodes[r].low, self) + self(mNodes[r].high, self));
+        memo.emplace(r, res);
+        return res;
+    };
+
+    double total = 1.0;
+    for (size_t i = 0; i < mVars; ++i)
+        total *= 2.0;
+    return fraction(f, fraction) * total;
+}
+
+bool Bdd::cover(Ref f, std::vector<Cube>& cubes, size_t maxCubes)
+{
+    Ref res;
+    bool ok = isop(f, f, cubes, res, maxCubes);
+    mIsopCache.clear();
+    return ok;
+}
+
+bool Bdd::isop(Ref lower, Ref upper, std::vector<Cube>& cubes, Ref& res, size_t maxCubes)
+{
+    cubes.clear();
+    if (lower == ZERO)
+    {
+        res = ZERO;
+        return true;
+    }
+
+    if (upper == ONE)
+    {
+        cubes.emplace_back();
+        res = ONE;
+        return true;
+    }
+
+    Key key{ lower, upper, 0 };
+    auto it = mIsopCache.find(key);
+    if (it != mIsopCache.end())
+    {
+        cubes = it->second.first;
+        res = it->second.second;
+        return true;
+    }
+
+    // Cover the minterms needing var = 0, those needing var = 1, then whatever is left with cubes
+    // independent of var
+    uint32_t var = std::min(mNodes[lower].var, mNodes[upper].var);
+    Ref l0 = cofactor(lower, var, false), l1 = cofactor(lower, var, true);
+    Ref u0 = cofactor(upper, var, false), u1 = cofactor(upper, var, true);
+
+    std::vector<Cube> c0, c1, cd;
+    Ref r0, r1, rd;
+    if (!isop(conjoin(l0, negate(u1)), u0, c0, r0, maxCubes) ||
+        !isop(conjoin(l1, negate(u0)), u1, c1, r1, maxCubes))
+        return false;
+
+    Ref ld = disjoin(conjoin(l0, negate(r0)), conjoin(l1, negate(r1)));
+    if (!isop(ld, conjoin(u0, u1), cd, rd, maxCubes))
+        return false;
+
+    if (c0.size() + c1.size() + cd.size() > maxCubes)
+        return false;
+
+    for (auto& c : c0)
+    {
+        c.emplace_back(var, false);
+        cubes.push_back(std::move(c));
+    }
+
+    for (auto& c : c1)
+    {
+        c.emplace_back(var, true);
+        cubes.push_back(std::move(c));
+    }
+
+    for (auto& c : cd)
+        cubes.push_back(std::move(c));
+
+    res = makeNode(var, disjoin(r0, rd), disjoin(r1, rd));
+    mIsopCache.emplace(key, std::make_pair(cubes, res));
+    return true;
+}
+
+size_t Bdd::size(Ref f) const
+{
+    std::vector<Ref> stack = { f };
+    std::vector<bool> seen(mNodes.size(), false);
+    size_t count = 0;
+    while (!stack.empty())
+    {
+        Ref r = stack.back();
+        stack.pop_back();
+        if (seen[r])
+            continue;
+
+        seen[r] = true;
+        ++count;
+        if (r != ZERO && r != ONE)
+        {
+            stack.push_back(mNodes[r].low);
+            stack.push_back(mNodes[r].high);
+        }
+    }
+
+    return count;
+}
+
+}
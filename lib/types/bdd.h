@@ -0,0 +1,112 @@
+#ifndef _MATHSOLVER_BDD_H_
+#define _MATHSOLVER_BDD_H_
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "../common/base.h"
+
+namespace MathSolver
+{
+
+// Reduced ordered binary decision diagram over the variables 0, 1, ..., n - 1, tested in that order.
+// Nodes are hash-consed, so two references are equal if and only if they represent the same
+// function, and the results of 'ite' are memoized.
+class Bdd
+{
+public:
+
+    using Ref = uint32_t;
+    static const Ref ZERO = 0;
+    static const Ref ONE = 1;
+
+    // A product of literals (variable, polarity). The empty cube is the constant true.
+    using Cube = std::vector<std::pair<size_t, bool>>;
+
+    // Constructs a manager over 'varCount' variables.
+    Bdd(size_t varCount);
+
+    // No copying, assigning
+    Bdd(const Bdd&) = delete;
+    Bdd& operator=(const Bdd&) = delete;
+
+    // Returns the function of a single variable.
+    Ref variable(size_t var);
+
+    // If-then-else: (f and g) or (not f and h).
+    Ref ite(Ref f, Ref g, Ref h);
+
+    // Boolean operations.
+    inline Ref negate(Ref f) { return ite(f, ZERO, ONE); }
+    inline Ref conjoin(Ref f, Ref g) { return ite(f, g, ZERO); }
+    inline Ref disjoin(Ref f, Ref g) { return ite(f, ONE, g); }
+    inline Ref exclusiveOr(Ref f, Ref g) { return ite(f, negate(g), g); }
+
+    // Returns a cube whose assignments all satisfy f. The function must not be ZERO.
+    Cube satisfy(Ref f) const;
+
+    // Returns the number of satisfying assignments over all variables.
+    double satCount(Ref f) const;
+
+    // Computes an irredundant sum of products for f (Minato-Morreale). Returns false and leaves
+    // 'cubes' unspecified if the cover would need more than 'maxCubes' cubes.
+    bool cover(Ref f, std::vector<Cube>& cubes, size_t maxCubes);
+
+    // Returns the number of nodes reachable from f, including terminals.
+    size_t size(Ref f) const;
+
+    // Returns the number of nodes in the manager.
+    inline size_t nodeCount() const { return mNodes.size(); }
+
+    // Returns the number of variables.
+    inline size_t varCount() const { return mVars; }
+
+private:
+
+    struct Node
+    {
+        uint32_t var;
+        Ref low;
+        Ref high;
+    };
+
+    struct Key
+    {
+        uint32_t a, b, c;
+        inline bool operator==(const Key& other) const { return a == other.a && b == other.b && c == other.c; }
+    };
+
+    struct KeyHash
+    {
+        inline size_t operator()(const Key& k) const
+        {
+            uint64_t h = ((uint64_t)k.a * 0x9E3779B97F4A7C15ull) ^ ((uint64_t)k.b * 0xC2B2AE3D27D4EB4Full) ^ k.c;
+            return (size_t)(h ^ (h >> 29));
+        }
+    };
+
+    // Returns the unique node (var, low, high), or 'low' if both branches are equal.
+    Ref makeNode(uint32_t var, Ref low, Ref high);
+
+    // Returns the cofactor of f with the variable set to 'value'. Assumes var is at or above f.
+    inline Ref cofactor(Ref f, uint32_t var, bool value) const
+    {
+        const Node& n = mNodes[f];
+        return (n.var != var) ? f : (value ? n.high : n.low);
+    }
+
+    // Interval cover: returns a cover of some R with lower <= R <= upper and sets 'res' to R.
+    bool isop(Ref lower, Ref upper, std::vector<Cube>& cubes, Ref& res, size_t maxCubes);
+
+private:
+    std::vector<Node> mNodes;
+    std::unordered_map<Key, Ref, KeyHash> mUnique;
+    std::unordered_map<Key, Ref, KeyHash> mIteCache;
+    std::unordered_map<Key, std::pair<std::vector<Cube>, Ref>, KeyHash> mIsopCache;
+    size_t mVars;
+};
+
+}
+
+#endif
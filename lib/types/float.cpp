@@ -8,6 +8,13 @@ namespace MathSolver
 const Float POS_INFINITY = Float("+inf");
 const Float NEG_INFINITY = Float("-inf");
 
+// MPFR keeps constants such as pi in a cache that is reused by later operations. The cache
+// is freed once at exit rather than after every operation.
+struct MpfrCacheCleanup
+{
+    ~MpfrCacheCleanup() { mpfr_free_cache(); }
+} gMpfrCacheCleanup;
+
 Float::Float()
 {
     mpfr_init2(mData, MATHSOLVER_FLOAT_DEFAULT_PREC);
@@ -16,7 +23,7 @@ Float::Float()
 
 Float::Float(const Float& other)
 {
-    mpfr_init2(mData, MATHSOLVER_FLOAT_DEFAULT_PREC);
+    mpfr_init2(mData, mpfr_get_prec(other.mData));  // exact, like a move
     mRoundDir = mpfr_set(mData, other.mData, MATHSOLVER_FLOAT_DEFAULT_RND_MODE);
 }
 
@@ -50,7 +57,7 @@ Float& Float::operator=(const Float& other)
     if (mData->_mpfr_d != nullptr) 
         mpfr_clear(mData);
     
-    mpfr_init2(mData, MATHSOLVER_FLOAT_DEFAULT_PREC);
+    mpfr_init2(mData, mpfr_get_prec(other.mData));
     mRoundDir = mpfr_set(mData, other.mData, MATHSOLVER_FLOAT_DEFAULT_RND_MODE);
     return *this;
 }
@@ -149,7 +156,6 @@ std::string Float::toString() const
 {
     char* c = new char[30];
     mpfr_snprintf(c, 30, "%.16Rg", mData);  
-    mpfr_free_cache();
 
     std::string s(c);
     delete[] c;
@@ -197,7 +203,12 @@ std::string Float::toExactString() const
     return s;
 }
 
- void Float::fromString(const char* str)
+void Float::setPrecision(mpfr_prec_t prec)
+{
+    mRoundDir = mpfr_prec_round(mData, prec, MATHSOLVER_FLOAT_DEFAULT_RND_MODE);
+}
+
+void Float::fromString(const char* str)
  {
     char* end;
     int t = mpfr_strtofr(mData, str, &end, 0, MATHSOLVER_FLOAT_DEFAULT_RND_MODE);
@@ -22,11 +22,11 @@ public:
     Float();                            // Default constructor
     Float(const char* data);            // Constructor from C string
     Float(const std::string& data);     // Constructor from std::string
-    Float(const Float& other);          // Copy constructor
+    Float(const Float& other);          // Copy constructor, keeps the precision of 'other'
     Float(Float&& other);               // Move constructor
     ~Float();                           // Destructor
 
-    Float& operator=(const Float& other);       // Copy assignment
+    Float& operator=(const Float& other);       // Copy assignment, keeps the precision of 'other'
     Float& operator=(Float&& other);            // Move assignment
     Float& operator=(const char* data);         // Assignment from c string
     Float& operator=(const std::string& data);  // Assignment from std::string
@@ -68,9 +68,25 @@ public:
     // Returns true if the float stored is zero.
     inline bool isZero() const { return mpfr_zero_p(mData) != 0; }
 
+    // Returns true if the float stored is one.
+    inline bool isOne() const { return !isNaN() && mpfr_cmp_si(mData, 1) == 0; }
+
+    // Returns true if the float stored is negative one.
+    inline bool isMinusOne() const { return !isNaN() && mpfr_cmp_si(mData, -1) == 0; }
+
+    // Compares this float and a machine integer without allocating. Returns a positive value if this float
+    // is larger, a negative value if it is smaller, or zero if they are equal. NaN compares larger.
+    inline int compare(long n) const { return isNaN() ? 1 : mpfr_cmp_si(mData, n); }
+
     // Returns true if the float is negative.
     inline bool sign() const { return mpfr_signbit(mData); }
 
+    // Returns the precision in bits.
+    inline mpfr_prec_t precision() const { return mpfr_get_prec(mData); }
+
+    // Rounds this float to the given precision in bits.
+    void setPrecision(mpfr_prec_t prec);
+
     // Converts this Float to a std::string. This conversion may result in more than one value mapping to same string.
     std::string toString() const;
 
@@ -509,6 +509,22 @@ int Integer::compare(const Integer& other) const
     else                                                  return cmpBytes(mData, mSize, other.mData, other.mSize);
 }
 
+int Integer::compare(int64_t n) const
+{
+    if (isUndef())      return 1;
+    if (isInf())        return ((mSign) ? -1 : 1);
+
+    size_t len = highestNonZeroByte(mData, mSize);
+    bool neg = mSign && len > 0;    // -0 == 0
+    if (neg != (n < 0))     return ((neg) ? -1 : 1);
+    if (len > 2)            return ((neg) ? -1 : 1);
+
+    uint64_t mag = ((len > 0) ? mData[0] : 0) | ((len > 1) ? ((uint64_t)mData[1] << 32) : 0);
+    uint64_t nmag = (n < 0) ? -(uint64_t)n : (uint64_t)n;
+    int cmp = (mag > nmag) - (mag < nmag);
+    return ((neg) ? -cmp : cmp);
+}
+
 Integer Integer::divRem(const Integer& other, Integer& rem) const
 {
     Integer quo;
@@ -548,6 +564,12 @@ std::string Integer::toString() const
     {
         return ((mSign) ? "-" : "") + std::string("inf");
     }
+    else if (highestNonZeroByte(mData, mSize) <= 2) // fits in 64 bits
+    {
+        uint64_t x = mData[0];
+        if (mSize > 1)  x |= ((uint64_t)mData[1] << 32);
+        return ((mSign) ? "-" : "") + std::to_string(x);
+    }
     else
     {
         std::string str;
@@ -935,6 +957,9 @@ void Integer::subAssign(const Integer& other, bool sign)
     size_t low, high;
     mSign = sign;
 
+    if (mSize < otherSize)  // resize first so 'l' and 's' do not point at the freed buffer
+        resizeNoCheck(otherSize);
+
     if (cmpBytes(mData, thisSize, other.mData, otherSize) >= 0)
     {
         l = mData;
@@ -950,9 +975,6 @@ void Integer::subAssign(const Integer& other, bool sign)
         low = thisSize;
     }
 
-    if (mSize < high)
-        resizeNoCheck(high);
-
     size_t i = 0;
     uint32_t c = 1;
     for (; i < low; ++i)
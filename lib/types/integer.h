@@ -162,6 +162,10 @@ public:
     // the other Integer is larger. Returns zero if they are equal. Comparing 'undef' and 'undef' returns 0.
     int compare(const Integer& other) const;
 
+    // Compares this Integer and a machine integer without allocating. Returns a positive value if this Integer
+    // is larger, a negative value if it is smaller, or zero if they are equal. 'undef' compares larger.
+    int compare(int64_t n) const;
+
     // Returns a pointer to the byte array.
     inline uint32_t* data() const { return mData; }
 
@@ -181,6 +185,12 @@ public:
     // Returns true if this Integer is odd.
     inline bool isOdd() const { return (mData[0] & 0x1); }
 
+    // Returns true if this Integer is one.
+    inline bool isOne() const { return compare(1) == 0; }
+
+    // Returns true if this Integer is negative one.
+    inline bool isMinusOne() const { return compare(-1) == 0; }
+
     // Returns true if this Integer is inf
     inline bool isUndef() const { return (mFlags & MATHSOLVER_INT_NAN); }
 
@@ -0,0 +1,173 @@
+#include <algorithm>
+#include "interval.h"
+
+namespace MathSolver
+{
+
+// Returns a NaN Float at the given precision.
+static Float withPrecision(mpfr_prec_t prec)
+{
+    Float f;
+    mpfr_set_prec(f.data(), prec);
+    return f;
+}
+
+// Endpoint product with 0 * inf = 0, since an infinite endpoint only bounds finite points.
+static void mulEndpoint(mpfr_ptr res, mpfr_srcptr a, mpfr_srcptr b, mpfr_rnd_t rnd)
+{
+    if (mpfr_zero_p(a) || mpfr_zero_p(b))   mpfr_set_zero(res, 1);
+    else                                    mpfr_mul(res, a, b, rnd);
+}
+
+Interval::Interval(mpfr_prec_t prec)
+    : mLower(withPrecision(prec)), mUpper(withPrecision(prec))
+{
+    mpfr_set_zero(mLower.data(), 1);
+    mpfr_set_zero(mUpper.data(), 1);
+}
+
+Interval::Interval(const Float& x, mpfr_prec_t prec)
+    : Interval(x, x, prec)
+{
+}
+
+Interval::Interval(const Float& lo, const Float& hi, mpfr_prec_t prec)
+    : mLower(withPrecision(prec)), mUpper(withPrecision(prec))
+{
+    mpfr_set(mLower.data(), lo.data(), MPFR_RNDD);
+    mpfr_set(mUpper.data(), hi.data(), MPFR_RNDU);
+}
+
+Interval Interval::entire(mpfr_prec_t prec)
+{
+    Interval res(prec);
+    mpfr_set_inf(res.mLower.data(), -1);
+    mpfr_set_inf(res.mUpper.data(), 1);
+    return res;
+}
+
+Interval Interval::undef(mpfr_prec_t prec)
+{
+    Interval res(prec);
+    mpfr_set_nan(res.mLower.data());
+    mpfr_set_nan(res.mUpper.data());
+    return res;
+}
+
+Interval Interval::operator+(const Interval& other) const
+{
+    Interval res(std::max(precision(), other.precision()));
+    mpfr_add(res.mLower.data(), mLower.data(), other.mLower.data(), MPFR_RNDD);
+    mpfr_add(res.mUpper.data(), mUpper.data(), other.mUpper.data(), MPFR_RNDU);
+    return res;
+}
+
+Interval Interval::operator-(const Interval& other) const
+{
+    Interval res(std::max(precision(), other.precision()));
+    mpfr_sub(res.mLower.data(), mLower.data(), other.mUpper.data(), MPFR_RNDD);
+    mpfr_sub(res.mUpper.data(), mUpper.data(), other.mLower.data(), MPFR_RNDU);
+    return res;
+}
+
+Interval Interval::operator*(const Interval& other) const
+{
+    mpfr_prec_t prec = std::max(precision(), other.precision());
+    if (isUndef() || other.isUndef())
+        return undef(prec);
+
+    // Common case: both intervals non-negative
+    Interval res(prec);
+    if (!mLower.sign() && !other.mLower.sign())
+    {
+        mulEndpoint(res.mLower.data(), mLower.data(), other.mLower.data(), MPFR_RNDD);
+        mulEndpoint(res.mUpper.data(), mUpper.data(), other.mUpper.data(), MPFR_RNDU);
+        return res;
+    }
+
+    // General case: extremes of the four endpoint products
+    const Float* lhs[2] = { &mLower, &mUpper };
+    const Float* rhs[2] = { &other.mLower, &other.mUpper };
+    Float tmp = withPrecision(prec);
+    mpfr_set_inf(res.mLower.data(), 1);
+    mpfr_set_inf(res.mUpper.data(), -1);
+    for (const Float* a : lhs)
+    {
+        for (const Float* b : rhs)
+        {
+            mulEndpoint(tmp.data(), a->data(), b->data(), MPFR_RNDD);
+            mpfr_min(res.mLower.data(), res.mLower.data(), tmp.data(), MPFR_RNDD);
+            mulEndpoint(tmp.data(), a->data(), b->data(), MPFR_RNDU);
+            mpfr_max(res.mUpper.data(), res.mUpper.data(), tmp.data(), MPFR_RNDU);
+        }
+    }
+
+    return res;
+}
+
+Interval Interval::operator/(const Interval& other) const
+{
+    mpfr_prec_t prec = std::max(precision(), other.precision());
+    if (isUndef() || other.containsZero())
+        return undef(prec);
+
+    // x/y = x * [1/y_hi, 1/y_lo] when 0 is not in y
+    Interval recip(prec);
+    mpfr_ui_div(recip.mLower.data(), 1, other.mUpper.data(), MPFR_RNDD);
+    mpfr_ui_div(recip.mUpper.data(), 1, other.mLower.data(), MPFR_RNDU);
+    return *this * recip;
+}
+
+Interval Interval::operator-() const
+{
+    Interval res(precision());
+    mpfr_neg(res.mLower.data(), mUpper.data(), MPFR_RNDD);
+    mpfr_neg(res.mUpper.data(), mLower.data(), MPFR_RNDU);
+    return res;
+}
+
+bool Interval::contains(const Float& x) const
+{
+    return !isUndef() && mpfr_lessequal_p(mLower.data(), x.data()) && mpfr_lessequal_p(x.data(), mUpper.data());
+}
+
+bool Interval::containsZero() const
+{
+    return isUndef() || (mpfr_sgn(mLower.data()) <= 0 && mpfr_sgn(mUpper.data()) >= 0);
+}
+
+Interval Interval::hull(const Interval& other) const
+{
+    mpfr_prec_t prec = std::max(precision(), other.precision());
+    if (isUndef() || other.isUndef())
+        return undef(prec);
+
+    Interval res(prec);
+    mpfr_min(res.mLower.data(), mLower.data(), other.mLower.data(), MPFR_RNDD);
+    mpfr_max(res.mUpper.data(), mUpper.data(), other.mUpper.data(), MPFR_RNDU);
+    return res;
+}
+
+Float Interval::mid() const
+{
+    Float res = withPrecision(precision());
+    mpfr_add(res.data(), mLower.data(), mUpper.data(), MPFR_RNDN);
+    mpfr_div_2ui(res.data(), res.data(), 1, MPFR_RNDN);
+    return res;
+}
+
+Float Interval::width() const
+{
+    Float res = withPrecision(precision());
+    mpfr_sub(res.data(), mUpper.data(), mLower.data(), MPFR_RNDU);
+    return res;
+}
+
+std::string Interval::toString() const
+{
+    if (isUndef())
+        return "undef";
+    return "[" + mLower.toString() + ", " + mUpper.toString() + "]";
+}
+
+}
@@ -0,0 +1,83 @@
+#ifndef _MATHSOLVER_INTERVAL_TYPE_H_
+#define _MATHSOLVER_INTERVAL_TYPE_H_
+
+#include <string>
+#include "../common/base.h"
+#include "float.h"
+
+namespace MathSolver
+{
+
+// Closed interval [lower, upper] with endpoints at a fixed working precision. Every operation
+// rounds the lower endpoint down and the upper endpoint up, so the result always contains the
+// exact result for every point of the operands. Unlike Ball, the enclosure may be unbounded.
+// An undefined result (e.g. division by an interval containing zero) has NaN endpoints.
+class Interval
+{
+public:
+
+    // Constructs the point interval [0, 0] at the given working precision.
+    Interval(mpfr_prec_t prec = MATHSOLVER_FLOAT_DEFAULT_PREC);
+
+    // Constructs the smallest interval at the given precision containing a value.
+    Interval(const Float& x, mpfr_prec_t prec);
+
+    // Constructs the smallest interval at the given precision containing [lo, hi].
+    Interval(const Float& lo, const Float& hi, mpfr_prec_t prec);
+
+    // Returns the interval [-inf, inf].
+    static Interval entire(mpfr_prec_t prec);
+
+    // Returns the undefined interval.
+    static Interval undef(mpfr_prec_t prec);
+
+    Interval operator+(const Interval& other) const;    // Addition
+    Interval operator-(const Interval& other) const;    // Subtraction
+    Interval operator*(const Interval& other) const;    // Multiplication
+    Interval operator/(const Interval& other) const;    // Division. Undefined if the divisor contains zero.
+    Interval operator-() const;                         // Negation
+
+    // Returns true if the value is inside the interval.
+    bool contains(const Float& x) const;
+
+    // Returns true if zero is inside the interval. Always true for an undefined interval.
+    bool containsZero() const;
+
+    // Returns the smallest interval containing both intervals.
+    Interval hull(const Interval& other) const;
+
+    // Returns true if the interval is a single point.
+    inline bool isPoint() const { return !isUndef() && mLower == mUpper; }
+
+    // Returns true if the interval is undefined.
+    inline bool isUndef() const { return mLower.isNaN() || mUpper.isNaN(); }
+
+    // Returns true if both endpoints are finite.
+    inline bool isFinite() const { return mpfr_number_p(mLower.data()) && mpfr_number_p(mUpper.data()); }
+
+    // Returns the endpoints.
+    inline const Float& lower() const { return mLower; }
+    inline Float& lower() { return mLower; }
+    inline const Float& upper() const { return mUpper; }
+    inline Float& upper() { return mUpper; }
+
+    // Returns the midpoint, rounded to nearest.
+    Float mid() const;
+
+    // Returns the width upper - lower, rounded up.
+    Float width() const;
+
+    // Returns the working precision in bits.
+    inline mpfr_prec_t precision() const { return mLower.precision(); }
+
+    // Converts this interval to a std::string, "[lower, upper]" or "undef".
+    std::string toString() const;
+
+private:
+    Float mLower;
+    Float mUpper;
+};
+
+}
+
+#endif
@@ -0,0 +1,413 @@
+#include <algorithm>
+#include <climits>
+#include <iterator>
+#include "poly.h"
+
+namespace MathSolver
+{
+
+//
+//  Dense polynomial
+//
+
+DensePoly::DensePoly(const Integer& c)
+{
+    if (!c.isZero())
+        mCoeffs.push_back(c);
+}
+
+DensePoly::DensePoly(const std::vector<Integer>& coeffs)
+    : mCoeffs(coeffs)
+{
+    trim();
+}
+
+DensePoly::DensePoly(std::vector<Integer>&& coeffs)
+    : mCoeffs(std::move(coeffs))
+{
+    trim();
+}
+
+DensePoly DensePoly::monomial(const Integer& c, size_t n)
+{
+    DensePoly res;
+    if (!c.isZero())
+    {
+        res.mCoeffs.resize(n + 1, Integer(0));
+        res.mCoeffs[n] = c;
+    }
+
+    return res;
+}
+
+DensePoly DensePoly::operator+(const DensePoly& other) const
+{
+    DensePoly res(*this);
+    return (res += other);
+}
+
+DensePoly DensePoly::operator-(const DensePoly& other) const
+{
+    DensePoly res(*this);
+    return (res -= other);
+}
+
+DensePoly DensePoly::operator*(const DensePoly& other) const
+{
+    if (isZero() || other.isZero())
+        return DensePoly();
+
+    std::vector<Integer> coeffs(mCoeffs.size() + other.mCoeffs.size() - 1, Integer(0));
+    for (size_t i = 0; i < mCoeffs.size(); ++i)
+    {
+        if (mCoeffs[i].isZero())
+            continue;
+        for (size_t j = 0; j < other.mCoeffs.size(); ++j)
+        {
+            if (!other.mCoeffs[j].isZero())
+                coeffs[i + j] += mCoeffs[i] * other.mCoeffs[j];
+        }
+    }
+
+    return DensePoly(std::move(coeffs));
+}
+
+DensePoly& DensePoly::operator+=(const DensePoly& other)
+{
+    if (other.mCoeffs.size() > mCoeffs.size())
+        mCoeffs.resize(other.mCoeffs.size(), Integer(0));
+    for (size_t i = 0; i < other.mCoeffs.size(); ++i)
+        mCoeffs[i] += other.mCoeffs[i];
+    trim();
+    return *this;
+}
+
+DensePoly& DensePoly::operator-=(const DensePoly& other)
+{
+    if (other.mCoeffs.size() > mCoeffs.size())
+        mCoeffs.resize(other.mCoeffs.size(), Integer(0));
+    for (size_t i = 0; i < other.mCoeffs.size(); ++i)
+        mCoeffs[i] -= other.mCoeffs[i];
+    trim();
+    return *this;
+}
+
+DensePoly& DensePoly::operator*=(const DensePoly& other)
+{
+    *this = *this * other;
+    return *this;
+}
+
+DensePoly DensePoly::operator-() const
+{
+    DensePoly res(*this);
+    for (auto& c : res.mCoeffs)
+        c = -c;
+    return res;
+}
+
+const Integer& DensePoly::coeff(size_t n) const
+{
+    static const Integer ZERO(0);
+    return (n < mCoeffs.size()) ? mCoeffs[n] : ZERO;
+}
+
+DensePoly DensePoly::pow(unsigned int n) const
+{
+    DensePoly res(Integer(1));
+    DensePoly base(*this);
+    while (n > 0)   // square and multiply
+    {
+        if (n & 0x1)    res *= base;
+        n >>= 1;
+        if (n > 0)      base *= base;
+    }
+
+    return res;
+}
+
+void DensePoly::trim()
+{
+    while (!mCoeffs.empty() && mCoeffs.back().isZero())
+        mCoeffs.pop_back();
+}
+
+//
+//  Sparse polynomial
+//
+
+SparsePoly::SparsePoly()
+{
+    setVariables(std::vector<std::string>());
+}
+
+SparsePoly::SparsePoly(const std::vector<std::string>& vars)
+{
+    setVariables(vars);
+}
+
+SparsePoly::SparsePoly(const Integer& c)
+{
+    setVariables(std::vector<std::string>());
+    if (!c.isZero())
+        mTerms.emplace(0, c);
+}
+
+SparsePoly SparsePoly::variable(const std::string& var)
+{
+    SparsePoly res(std::vector<std::string>({ var }));
+    res.mTerms.emplace(1, Integer(1));
+    return res;
+}
+
+// Returns the sorted union of two sorted variable lists.
+static std::vector<std::string> mergeVariables(const std::vector<std::string>& lhs, const std::vector<std::string>& rhs)
+{
+    std::vector<std::string> vars;
+    std::set_union(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(vars));
+    return vars;
+}
+
+SparsePoly SparsePoly::operator+(const SparsePoly& other) const
+{
+    SparsePoly res(*this);
+    return (res += other);
+}
+
+SparsePoly SparsePoly::operator-(const SparsePoly& other) const
+{
+    SparsePoly res(*this);
+    return (res -= other);
+}
+
+SparsePoly SparsePoly::operator*(const SparsePoly& other) const
+{
+    if (mVars != other.mVars)
+    {
+        std::vector<std::string> vars = mergeVariables(mVars, other.mVars);
+        if (!checkVariables(vars))
+            return SparsePoly(mVars);
+        return extend(vars) * other.extend(vars);
+    }
+
+    if (!canMultiply(other))
+    {
+        gErrorManager.log("Exponent overflow in polynomial multiplication", ErrorManager::MATH, __FILE__, __LINE__);
+        return SparsePoly(mVars);
+    }
+
+    SparsePoly res(mVars);
+    for (const auto& lhs : mTerms)  // fields never carry, so keys add like exponent vectors
+    {
+        for (const auto& rhs : other.mTerms)
+        {
+            auto it = res.mTerms.find(lhs.first + rhs.first);
+            if (it == res.mTerms.end())     res.mTerms.emplace(lhs.first + rhs.first, lhs.second * rhs.second);
+            else                            it->second += lhs.second * rhs.second;
+        }
+    }
+
+    for (auto it = res.mTerms.begin(); it != res.mTerms.end(); )
+        it = (it->second.isZero() ? res.mTerms.erase(it) : std::next(it));
+    return res;
+}
+
+SparsePoly& SparsePoly::operator+=(const SparsePoly& other)
+{
+    if (mVars != other.mVars)
+    {
+        std::vector<std::string> vars = mergeVariables(mVars, other.mVars);
+        if (!checkVariables(vars))
+        {
+            mTerms.clear();
+            return *this;
+        }
+
+        *this = extend(vars);
+        return (*this += other.extend(vars));
+    }
+
+    for (const auto& term : other.mTerms)
+        addTerm(term.first, term.second);
+    return *this;
+}
+
+SparsePoly& SparsePoly::operator-=(const SparsePoly& other)
+{
+    return (*this += -other);
+}
+
+SparsePoly& SparsePoly::operator*=(const SparsePoly& other)
+{
+    *this = *this * other;
+    return *this;
+}
+
+SparsePoly SparsePoly::operator-() const
+{
+    SparsePoly res(*this);
+    for (auto& term : res.mTerms)
+        term.second = -term.second;
+    return res;
+}
+
+void SparsePoly::addTerm(key_type key, const Integer& c)
+{
+    if (c.isZero())
+        return;
+
+    auto it = mTerms.find(key);
+    if (it == mTerms.end())
+    {
+        mTerms.emplace(key, c);
+    }
+    else
+    {
+        it->second += c;
+        if (it->second.isZero())
+            mTerms.erase(it);
+    }
+}
+
+bool SparsePoly::canMultiply(const SparsePoly& other) const
+{
+    if (mVars != other.mVars)
+    {
+        std::vector<std::string> vars = mergeVariables(mVars, other.mVars);
+        return vars.size() <= MATHSOLVER_SPARSE_POLY_MAX_VARS && extend(vars).canMultiply(other.extend(vars));
+    }
+
+    std::vector<unsigned int> lhs = maxExponents();
+    std::vector<unsigned int> rhs = other.maxExponents();
+    for (size_t i = 0; i < mVars.size(); ++i)
+    {
+        if ((uint64_t)lhs[i] + rhs[i] > maxExponent())
+            return false;
+    }
+
+    return true;
+}
+
+bool SparsePoly::canPow(unsigned int n) const
+{
+    for (unsigned int e : maxExponents())
+    {
+        if ((uint64_t)e * n > maxExponent())
+            return false;
+    }
+
+    return true;
+}
+
+SparsePoly SparsePoly::extend(const std::vector<std::string>& vars) const
+{
+    if (vars == mVars)
+        return *this;
+    if (!checkVariables(vars))
+        return SparsePoly(mVars);
+
+    std::vector<size_t> index(mVars.size());  // position of each variable in the new list
+    for (size_t i = 0; i < mVars.size(); ++i)
+        index[i] = std::lower_bound(vars.begin(), vars.end(), mVars[i]) - vars.begin();
+
+    SparsePoly res(vars);
+    std::vector<unsigned int> exps(vars.size());
+    for (const auto& term : mTerms)
+    {
+        std::fill(exps.begin(), exps.end(), 0);
+        for (size_t i = 0; i < mVars.size(); ++i)
+            exps[index[i]] = exponent(term.first, i);
+        res.mTerms.emplace(res.pack(exps), term.second);
+    }
+
+    return res;
+}
+
+unsigned int SparsePoly::maxExponent() const
+{
+    return (mMask > (key_type)INT_MAX) ? INT_MAX : (unsigned int)mMask;
+}
+
+SparsePoly::key_type SparsePoly::pack(const std::vector<unsigned int>& exps) const
+{
+    key_type key = 0;
+    for (size_t i = 0; i < mVars.size(); ++i)
+        key |= ((key_type)exps[i] << ((mVars.size() - 1 - i) * mWidth));
+    return key;
+}
+
+SparsePoly SparsePoly::pow(unsigned int n) const
+{
+    if (!canPow(n))
+    {
+        gErrorManager.log("Exponent overflow in polynomial exponentiation", ErrorManager::MATH, __FILE__, __LINE__);
+        return SparsePoly(mVars);
+    }
+
+    SparsePoly res(mVars);
+    res.mTerms.emplace(0, Integer(1));
+    if (mTerms.size() <= 4) // repeated multiplication by a short polynomial is cheaper than squaring
+    {
+        for (unsigned int i = 0; i < n; ++i)
+            res = res * *this;
+        return res;
+    }
+
+    SparsePoly base(*this);
+    while (n > 0)
+    {
+        if (n & 0x1)    res *= base;
+        n >>= 1;
+        if (n > 0)      base *= base;
+    }
+
+    return res;
+}
+
+unsigned int SparsePoly::totalDegree(key_type key) const
+{
+    unsigned int deg = 0;
+    for (size_t i = 0; i < mVars.size(); ++i)
+        deg += exponent(key, i);
+    return deg;
+}
+
+std::vector<unsigned int> SparsePoly::unpack(key_type key) const
+{
+    std::vector<unsigned int> exps(mVars.size());
+    for (size_t i = 0; i < mVars.size(); ++i)
+        exps[i] = exponent(key, i);
+    return exps;
+}
+
+std::vector<unsigned int> SparsePoly::maxExponents() const
+{
+    std::vector<unsigned int> exps(mVars.size(), 0);
+    for (const auto& term : mTerms)
+    {
+        for (size_t i = 0; i < mVars.size(); ++i)
+            exps[i] = std::max(exps[i], exponent(term.first, i));
+    }
+
+    return exps;
+}
+
+bool SparsePoly::checkVariables(const std::vector<std::string>& vars)
+{
+    if (vars.size() <= MATHSOLVER_SPARSE_POLY_MAX_VARS)
+        return true;
+
+    gErrorManager.log("Too many variables for a sparse polynomial: " + std::to_string(vars.size()), ErrorManager::MATH, __FILE__, __LINE__);
+    return false;
+}
+
+void SparsePoly::setVariables(const std::vector<std::string>& vars)
+{
+    if (checkVariables(vars))   mVars = vars;
+    else                        mVars.clear();  // the zero polynomial, so no key is ever packed
+
+    mWidth = mVars.empty() ? 64 : 64 / mVars.size();
+    mMask = (mWidth == 64) ? ~(key_type)0 : (((key_type)1 << mWidth) - 1);
+}
+
+}
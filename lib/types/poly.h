@@ -0,0 +1,207 @@
+#ifndef _MATHSOLVER_POLY_H_
+#define _MATHSOLVER_POLY_H_
+
+#include <map>
+#include <string>
+#include <vector>
+#include "../common/base.h"
+#include "integer.h"
+
+// Largest degree of a dense polynomial created by conversion or exponentiation
+#define MATHSOLVER_DENSE_POLY_MAX_DEGREE    65536
+
+// Largest number of variables in a sparse polynomial (one bit per exponent)
+#define MATHSOLVER_SPARSE_POLY_MAX_VARS     64
+
+namespace MathSolver
+{
+
+// Univariate polynomial with Integer coefficients stored as a coefficient vector from
+// lowest to highest degree. The highest coefficient is never zero.
+class DensePoly
+{
+public:
+
+    // Constructs the zero polynomial.
+    inline DensePoly() {}
+
+    // Constructs a constant polynomial.
+    DensePoly(const Integer& c);
+
+    // Constructs a polynomial from coefficients ordered from lowest to highest degree.
+    DensePoly(const std::vector<Integer>& coeffs);
+    DensePoly(std::vector<Integer>&& coeffs);
+
+    // Returns the monomial c * x^n.
+    static DensePoly monomial(const Integer& c, size_t n);
+
+    // Equality operator
+    inline bool operator==(const DensePoly& other) const { return mCoeffs == other.mCoeffs; }
+
+    // Inequality operator
+    inline bool operator!=(const DensePoly& other) const { return !(*this == other); }
+
+    // Addition operator
+    DensePoly operator+(const DensePoly& other) const;
+
+    // Subtraction operator
+    DensePoly operator-(const DensePoly& other) const;
+
+    // Multiplication operator
+    DensePoly operator*(const DensePoly& other) const;
+
+    // Addition assignment operator
+    DensePoly& operator+=(const DensePoly& other);
+
+    // Subtraction assignment operator
+    DensePoly& operator-=(const DensePoly& other);
+
+    // Multiplication assignment operator
+    DensePoly& operator*=(const DensePoly& other);
+
+    // Unary minus operator
+    DensePoly operator-() const;
+
+    // Returns the coefficient of x^n.
+    const Integer& coeff(size_t n) const;
+
+    // Returns a reference to the coefficients, lowest degree first.
+    inline const std::vector<Integer>& data() const { return mCoeffs; }
+
+    // Returns the degree of this polynomial. The zero polynomial has degree -1.
+    inline int degree() const { return (int)mCoeffs.size() - 1; }
+
+    // Returns true if this is the zero polynomial.
+    inline bool isZero() const { return mCoeffs.empty(); }
+
+    // Returns this polynomial raised to a non-negative integer power.
+    DensePoly pow(unsigned int n) const;
+
+private:
+
+    // Removes zero coefficients from the top of the vector.
+    void trim();
+
+    std::vector<Integer> mCoeffs;
+};
+
+// Multivariate polynomial with Integer coefficients stored as a map from exponent vectors
+// to non-zero coefficients. Exponent vectors are packed into a single 64-bit key with
+// 64/n bits per variable, the first variable in the most significant field, so keys compare
+// lexicographically. Variables are sorted by name.
+class SparsePoly
+{
+public:
+
+    using key_type = uint64_t;
+    using term_map = std::map<key_type, Integer>;
+
+    // Constructs the zero polynomial with no variables.
+    SparsePoly();
+
+    // Constructs the zero polynomial over a list of variables. Logs an error and uses no variables
+    // if there are more than MATHSOLVER_SPARSE_POLY_MAX_VARS.
+    SparsePoly(const std::vector<std::string>& vars);
+
+    // Constructs a constant polynomial with no variables.
+    SparsePoly(const Integer& c);
+
+    // Returns the polynomial consisting of a single variable.
+    static SparsePoly variable(const std::string& var);
+
+    // Equality operator. Both polynomials must be over the same variables.
+    inline bool operator==(const SparsePoly& other) const { return mVars == other.mVars && mTerms == other.mTerms; }
+
+    // Inequality operator
+    inline bool operator!=(const SparsePoly& other) const { return !(*this == other); }
+
+    // Addition operator. Logs an error and returns zero if the result would have more than
+    // MATHSOLVER_SPARSE_POLY_MAX_VARS variables.
+    SparsePoly operator+(const SparsePoly& other) const;
+
+    // Subtraction operator
+    SparsePoly operator-(const SparsePoly& other) const;
+
+    // Multiplication operator. Logs an error and returns zero if an exponent overflows or the
+    // result would have more than MATHSOLVER_SPARSE_POLY_MAX_VARS variables.
+    SparsePoly operator*(const SparsePoly& other) const;
+
+    // Addition assignment operator
+    SparsePoly& operator+=(const SparsePoly& other);
+
+    // Subtraction assignment operator
+    SparsePoly& operator-=(const SparsePoly& other);
+
+    // Multiplication assignment operator
+    SparsePoly& operator*=(const SparsePoly& other);
+
+    // Unary minus operator
+    SparsePoly operator-() const;
+
+    // Adds c * (monomial at key) to this polynomial.
+    void addTerm(key_type key, const Integer& c);
+
+    // Returns true if the product of this polynomial and another fits in the packed exponents.
+    bool canMultiply(const SparsePoly& other) const;
+
+    // Returns true if this polynomial raised to n fits in the packed exponents.
+    bool canPow(unsigned int n) const;
+
+    // Returns this polynomial over a superset of its variables. Logs an error and returns zero if
+    // there are more than MATHSOLVER_SPARSE_POLY_MAX_VARS.
+    SparsePoly extend(const std::vector<std::string>& vars) const;
+
+    // Returns the exponent of the ith variable in a packed key.
+    inline unsigned int exponent(key_type key, size_t i) const
+    {
+        return (unsigned int)((key >> ((mVars.size() - 1 - i) * mWidth)) & mMask);
+    }
+
+    // Returns true if this is the zero polynomial.
+    inline bool isZero() const { return mTerms.empty(); }
+
+    // Returns the largest exponent that can be stored for a single variable.
+    unsigned int maxExponent() const;
+
+    // Returns the packed key for an exponent vector (one entry per variable).
+    key_type pack(const std::vector<unsigned int>& exps) const;
+
+    // Returns this polynomial raised to a non-negative integer power. Logs an error and returns
+    // zero if an exponent overflows.
+    SparsePoly pow(unsigned int n) const;
+
+    // Returns the number of non-zero terms.
+    inline size_t size() const { return mTerms.size(); }
+
+    // Returns a reference to the terms.
+    inline const term_map& terms() const { return mTerms; }
+
+    // Returns the sum of the exponents in a packed key.
+    unsigned int totalDegree(key_type key) const;
+
+    // Returns the exponent vector of a packed key.
+    std::vector<unsigned int> unpack(key_type key) const;
+
+    // Returns a reference to the (sorted) list of variables.
+    inline const std::vector<std::string>& variables() const { return mVars; }
+
+private:
+
+    // Returns the largest exponent of each variable.
+    std::vector<unsigned int> maxExponents() const;
+
+    // Returns true if a polynomial can be over this many variables. Logs an error otherwise.
+    static bool checkVariables(const std::vector<std::string>& vars);
+
+    // Sets the variables of this polynomial and the width of each exponent field.
+    void setVariables(const std::vector<std::string>& vars);
+
+    std::vector<std::string> mVars;
+    term_map mTerms;
+    key_type mMask;
+    size_t mWidth;
+};
+
+}
+
+#endif
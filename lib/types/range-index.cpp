@@ -0,0 +1,234 @@
+#include <algorithm>
+#include <numeric>
+#include "range-index.h"
+
+namespace MathSolver
+{
+
+RangeIndex::RangeIndex(const std::vector<Range>& ranges)
+    : mRoot(-1), mRanges(ranges.size()), mBuiltSize(0)
+{
+    for (size_t id = 0; id < ranges.size(); ++id)
+    {
+        for (const auto& e : ranges[id].data())
+            mEntries.push_back({ e, id });
+    }
+
+    rebuild();
+}
+
+size_t RangeIndex::insert(const Range& range)
+{
+    size_t id = mRanges++;
+    for (const auto& e : range.data())
+        mEntries.push_back({ e, id });
+
+    if (mRoot == -1 || mEntries.size() > 2 * mBuiltSize)
+    {
+        rebuild();
+        return id;
+    }
+
+    for (size_t i = mEntries.size() - range.data().size(); i < mEntries.size(); ++i)
+    {
+        const interval_t& ival = mEntries[i].ival;
+        int node = mRoot;
+        while (true)
+        {
+            int* child = nullptr;
+            if (ival.upper < mNodes[node].center)       child = &mNodes[node].left;
+            else if (ival.lower > mNodes[node].center)  child = &mNodes[node].right;
+
+            if (child == nullptr)   // closure contains the center
+            {
+                std::vector<size_t>& byLower = mNodes[node].byLower;
+                std::vector<size_t>& byUpper = mNodes[node].byUpper;
+                byLower.insert(std::upper_bound(byLower.begin(), byLower.end(), i, [&](size_t lhs, size_t rhs) {
+                    return mEntries[lhs].ival.lower < mEntries[rhs].ival.lower; }), i);
+                byUpper.insert(std::upper_bound(byUpper.begin(), byUpper.end(), i, [&](size_t lhs, size_t rhs) {
+                    return mEntries[lhs].ival.upper > mEntries[rhs].ival.upper; }), i);
+                break;
+            }
+
+            if (*child == -1)
+            {
+                *child = (int)mNodes.size();
+                mNodes.push_back({ ival.lower, { i }, { i }, -1, -1 });
+                break;
+            }
+
+            node = *child;
+        }
+    }
+
+    return id;
+}
+
+std::vector<size_t> RangeIndex::stab(const Float& val) const
+{
+    std::vector<size_t> res;
+    if (mRoot != -1)
+        stab(mRoot, val, res);
+    return res;
+}
+
+std::vector<size_t> RangeIndex::overlap(const interval_t& ival) const
+{
+    std::vector<size_t> res;
+    if (mRoot != -1)
+        overlap(mRoot, ival, res);
+
+    std::sort(res.begin(), res.end());
+    res.erase(std::unique(res.begin(), res.end()), res.end());
+    return res;
+}
+
+std::vector<size_t> RangeIndex::overlap(const Range& range) const
+{
+    std::vector<size_t> res;
+    if (mRoot != -1)
+    {
+        for (const auto& e : range.data())
+            overlap(mRoot, e, res);
+    }
+
+    std::sort(res.begin(), res.end());
+    res.erase(std::unique(res.begin(), res.end()), res.end());
+    return res;
+}
+
+int RangeIndex::build(std::vector<size_t>& entries)
+{
+    if (entries.empty())
+        return -1;
+
+    // The median lower bound is in the closure of at least one interval, so every node
+    // takes at least one entry
+    auto mid = entries.begin() + entries.size() / 2;
+    std::nth_element(entries.begin(), mid, entries.end(), [&](size_t lhs, size_t rhs) {
+        return mEntries[lhs].ival.lower < mEntries[rhs].ival.lower; });
+    Endpoint center = mEntries[*mid].ival.lower;
+
+    std::vector<size_t> left, right, here;
+    for (size_t i : entries)
+    {
+        if (mEntries[i].ival.upper < center)        left.push_back(i);
+        else if (mEntries[i].ival.lower > center)   right.push_back(i);
+        else                                        here.push_back(i);
+    }
+
+    int idx = (int)mNodes.size();
+    mNodes.push_back({ center, here, here, -1, -1 });
+    std::sort(mNodes[idx].byLower.begin(), mNodes[idx].byLower.end(), [&](size_t lhs, size_t rhs) {
+        return mEntries[lhs].ival.lower < mEntries[rhs].ival.lower; });
+    std::sort(mNodes[idx].byUpper.begin(), mNodes[idx].byUpper.end(), [&](size_t lhs, size_t rhs) {
+        return mEntries[lhs].ival.upper > mEntries[rhs].ival.upper; });
+
+    entries.clear();
+    entries.shrink_to_fit();
+    int l = build(left);
+    int r = build(right);
+    mNodes[idx].left = l;
+    mNodes[idx].right = r;
+    return idx;
+}
+
+void RangeIndex::rebuild()
+{
+    std::vector<size_t> all(mEntries.size());
+    std::iota(all.begin(), all.end(), 0);
+    mNodes.clear();
+    mRoot = build(all);
+    mBuiltSize = mEntries.size();
+}
+
+void RangeIndex::stab(int node, const Float& val, std::vector<size_t>& res) const
+{
+    // Intervals at a node contain the center, so below the center only those starting at or
+    // before the value can match, and above it only those ending at or after the value
+    while (node != -1)
+    {
+        const Node& n = mNodes[node];
+        int c = n.center.compare(val);
+        if (c > 0)
+        {
+            for (size_t i : n.byLower)
+            {
+                if (mEntries[i].ival.lower.compare(val) > 0)
+                    break;
+                if (contains(mEntries[i].ival, val))
+                    res.push_back(mEntries[i].id);
+            }
+
+            node = n.left;
+        }
+        else if (c < 0)
+        {
+            for (size_t i : n.byUpper)
+            {
+                if (mEntries[i].ival.upper.compare(val) < 0)
+                    break;
+                if (contains(mEntries[i].ival, val))
+                    res.push_back(mEntries[i].id);
+            }
+
+            node = n.right;
+        }
+        else
+        {
+            for (size_t i : n.byLower)
+            {
+                if (contains(mEntries[i].ival, val))
+                    res.push_back(mEntries[i].id);
+            }
+
+            return;
+        }
+    }
+}
+
+void RangeIndex::overlap(int node, const interval_t& ival, std::vector<size_t>& res) const
+{
+    if (node == -1)
+        return;
+
+    const Node& n = mNodes[node];
+    int lo = ival.lower.compare(n.center), hi = ival.upper.compare(n.center);
+    if (hi < 0)
+    {
+        for (size_t i : n.byLower)
+        {
+            if (mEntries[i].ival.lower > ival.upper)
+                break;
+            if (isIntersecting(mEntries[i].ival, ival))
+                res.push_back(mEntries[i].id);
+        }
+
+        overlap(n.left, ival, res);
+    }
+    else if (lo > 0)
+    {
+        for (size_t i : n.byUpper)
+        {
+            if (mEntries[i].ival.upper < ival.lower)
+                break;
+            if (isIntersecting(mEntries[i].ival, ival))
+                res.push_back(mEntries[i].id);
+        }
+
+        overlap(n.right, ival, res);
+    }
+    else
+    {
+        for (size_t i : n.byLower)
+        {
+            if (isIntersecting(mEntries[i].ival, ival))
+                res.push_back(mEntries[i].id);
+        }
+
+        if (lo < 0)     overlap(n.left, ival, res);
+        if (hi > 0)     overlap(n.right, ival, res);
+    }
+}
+
+}
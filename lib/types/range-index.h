@@ -0,0 +1,77 @@
+#ifndef _MATHSOLVER_RANGE_INDEX_H_
+#define _MATHSOLVER_RANGE_INDEX_H_
+
+#include <vector>
+#include "../common/base.h"
+#include "range.h"
+
+namespace MathSolver
+{
+
+// Centered interval tree over the intervals of many Ranges. Each Range is identified by the order
+// in which it was added (0, 1, ...). Stabbing and overlap queries take O(log n + k) for n
+// intervals and k reported intervals.
+class RangeIndex
+{
+public:
+
+    // Constructs an empty index.
+    inline RangeIndex() : mRoot(-1), mRanges(0), mBuiltSize(0) {}
+
+    // Builds a balanced index over the ranges. The id of each Range is its position.
+    RangeIndex(const std::vector<Range>& ranges);
+
+    // Adds a Range to the index and returns its id. The tree is rebuilt once the number of
+    // intervals has more than doubled since it was last built.
+    size_t insert(const Range& range);
+
+    // Returns the ids of the ranges containing the value, in no particular order.
+    std::vector<size_t> stab(const Float& val) const;
+
+    // Returns the ids of the ranges intersecting the interval or Range, in increasing order.
+    std::vector<size_t> overlap(const interval_t& ival) const;
+    std::vector<size_t> overlap(const Range& range) const;
+
+    // Returns the number of ranges in the index.
+    inline size_t size() const { return mRanges; }
+
+private:
+
+    struct Entry
+    {
+        interval_t ival;
+        size_t id;
+    };
+
+    // Intervals whose closure contains the center, sorted by lower bound (ascending) and by upper
+    // bound (descending). Intervals entirely below or above the center are in the children.
+    struct Node
+    {
+        Endpoint center;
+        std::vector<size_t> byLower;
+        std::vector<size_t> byUpper;
+        int left;
+        int right;
+    };
+
+    // Builds a subtree over the given entries and returns its index.
+    int build(std::vector<size_t>& entries);
+
+    // Rebuilds the tree over every entry.
+    void rebuild();
+
+    // Helper functions for queries.
+    void stab(int node, const Float& val, std::vector<size_t>& res) const;
+    void overlap(int node, const interval_t& ival, std::vector<size_t>& res) const;
+
+private:
+    std::vector<Entry> mEntries;
+    std::vector<Node> mNodes;
+    int mRoot;
+    size_t mRanges;
+    size_t mBuiltSize;
+};
+
+}
+
+#endif
@@ -1,8 +1,153 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <queue>
+#include <thread>
+#include <vector>
 #include "range.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 namespace MathSolver
 {
 
+//
+//  Endpoint
+//
+
+// Returns the sign of x - d without building an MPFR value from d. Zero if either is NaN.
+static int compareFloatDouble(mpfr_srcptr x, double d)
+{
+    if (!mpfr_regular_p(x) || !std::isnormal(d))    // zero, inf, NaN or subnormal
+        return mpfr_cmp_d(x, d);
+
+    uint64_t bits;
+    std::memcpy(&bits, &d, sizeof(double));
+    int sx = mpfr_sgn(x), sd = (d > 0) ? 1 : -1;
+    if (sx != sd)
+        return sx;
+
+    // Same sign: compare exponents, then the leading limb with the 53-bit mantissa
+    // d = 0.1f * 2^(e - 1022) where f is the stored fraction and e the stored exponent
+    int mag;
+    mpfr_exp_t ed = (mpfr_exp_t)((bits >> 52) & 0x7ff) - 1022;
+    if (mpfr_get_exp(x) != ed)
+    {
+        mag = (mpfr_get_exp(x) > ed) ? 1 : -1;
+    }
+    else
+    {
+#if GMP_NUMB_BITS == 64
+        const mp_limb_t* xp = (const mp_limb_t*)mpfr_custom_get_significand(x);
+        size_t n = (mpfr_get_prec(x) - 1) / GMP_NUMB_BITS + 1;
+        mp_limb_t md = ((mp_limb_t)1 << 63) | ((bits & 0xfffffffffffffULL) << 11);
+        if (xp[n - 1] != md)
+        {
+            mag = (xp[n - 1] > md) ? 1 : -1;
+        }
+        else
+        {
+            mag = 0;
+            for (size_t i = 0; i + 1 < n && mag == 0; ++i)
+                mag = (xp[i] != 0);
+        }
+#else
+        return mpfr_cmp_d(x, d);
+#endif
+    }
+
+    return (sx > 0) ? mag : -mag;
+}
+
+Endpoint::Endpoint(const Float& x)
+    : mDouble(mpfr_get_d(x.data(), MPFR_RNDN)), mFloat(nullptr)
+{
+    if (!x.isNaN() && compareFloatDouble(x.data(), mDouble) != 0)
+        mFloat = new Float(x);
+}
+
+Endpoint::Endpoint(const char* str)
+    : Endpoint(Float(str))
+{
+}
+
+Endpoint::Endpoint(const std::string& str)
+    : Endpoint(Float(str))
+{
+}
+
+Endpoint::Endpoint(const Endpoint& other)
+    : mDouble(other.mDouble), mFloat((other.mFloat == nullptr) ? nullptr : new Float(*other.mFloat))
+{
+}
+
+Endpoint::Endpoint(Endpoint&& other)
+    : mDouble(other.mDouble), mFloat(other.mFloat)
+{
+    other.mFloat = nullptr;
+}
+
+Endpoint::~Endpoint()
+{
+    delete mFloat;
+}
+
+Endpoint& Endpoint::operator=(const Endpoint& other)
+{
+    if (this != &other)
+    {
+        if (other.mFloat == nullptr)    { delete mFloat; mFloat = nullptr; }
+        else if (mFloat == nullptr)     mFloat = new Float(*other.mFloat);
+        else                            *mFloat = *other.mFloat;
+        mDouble = other.mDouble;
+    }
+
+    return *this;
+}
+
+Endpoint& Endpoint::operator=(Endpoint&& other)
+{
+    if (this != &other)
+    {
+        delete mFloat;
+        mDouble = other.mDouble;
+        mFloat = other.mFloat;
+        other.mFloat = nullptr;
+    }
+
+    return *this;
+}
+
+int Endpoint::compare(const Float& x) const
+{
+    if (mFloat == nullptr)  return -compareFloatDouble(x.data(), mDouble);
+    return mpfr_cmp(mFloat->data(), x.data());
+}
+
+int Endpoint::compareSlow(const Endpoint& other) const
+{
+    if (other.mFloat == nullptr)    return compareFloatDouble(mFloat->data(), other.mDouble);
+    if (mFloat == nullptr)          return -compareFloatDouble(other.mFloat->data(), mDouble);
+    return mpfr_cmp(mFloat->data(), other.mFloat->data());
+}
+
+Float Endpoint::toFloat() const
+{
+    if (mFloat != nullptr)
+        return *mFloat;
+
+    Float f;
+    mpfr_set_d(f.data(), mDouble, MPFR_RNDN);
+    return f;
+}
+
+//
+//  interval_t
+//
+
 const interval_t INTERVAL_REALS = { "-inf", "inf", false, false };
 const interval_t INTERVAL_EMPTY = { "0", "0", false, false };
 
@@ -37,9 +182,10 @@ interval_t conjoin(const interval_t& lhs, const interval_t& rhs)
 
 bool contains(const interval_t& ival, const Float& val)
 {
-    if (val < ival.lower || val > ival.upper)           return false;
-    if ((val == ival.lower && !ival.lowerClosed) ||
-        (val == ival.upper && !ival.upperClosed))       return false;
+    int lo = ival.lower.compare(val), hi = ival.upper.compare(val);
+    if (lo > 0 || hi < 0)                               return false;
+    if ((lo == 0 && !ival.lowerClosed) ||
+        (hi == 0 && !ival.upperClosed))                 return false;
     return true;
 }
 
@@ -55,7 +201,7 @@ bool isIntersecting(const interval_t& lhs, const interval_t& rhs)
 {
     if (lhs.upper < rhs.lower || lhs.lower > rhs.upper)                         return false;
     if ((lhs.upper == rhs.lower && !(lhs.upperClosed && rhs.lowerClosed)) ||
-        (lhs.lower == rhs.upper && !(lhs.upperClosed && rhs.lowerClosed)))      return false;
+        (lhs.lower == rhs.upper && !(lhs.lowerClosed && rhs.upperClosed)))      return false;
     return true;
 }
 
@@ -69,224 +215,389 @@ std::string toString(const interval_t& ival)
 //  Range type
 // 
 
-Range::Range(const Float& lower, const Float& upper, bool lclosed, bool uclosed)
+// Returns true if the lower bound of 'lhs' comes before the lower bound of 'rhs'.
+static bool lowerBefore(const interval_t& lhs, const interval_t& rhs)
 {
-    interval_t ival;
-    ival.lower = lower;
-    ival.upper = upper;
-    ival.lowerClosed = lclosed;
-    ival.upperClosed = uclosed;
+    return lhs.lower < rhs.lower || (lhs.lower == rhs.lower && lhs.lowerClosed && !rhs.lowerClosed);
+}
 
-    if (isValidInterval(ival))  mIntervals.push_back(ival);
-    else                        mIntervals.push_back(INTERVAL_REALS);
+// Returns true if the upper bound of 'lhs' comes before the upper bound of 'rhs'.
+static bool upperBefore(const interval_t& lhs, const interval_t& rhs)
+{
+    return lhs.upper < rhs.upper || (lhs.upper == rhs.upper && !lhs.upperClosed && rhs.upperClosed);
 }
 
-Range::Range(const std::initializer_list<interval_t>& ivals)
+// Returns true if the interval contains no points, e.g. (0, 0).
+static bool isEmptyInterval(const interval_t& ival)
 {
-    for (auto e : ivals)
-        mIntervals.push_back(e);
-    mIntervals.sort(cmpIntervals);
+    return ival.lower == ival.upper && !(ival.lowerClosed && ival.upperClosed);
 }
 
-Range::Range(const Range& other)
+// Appends an interval to a sorted, normalized list, merging it with the last interval if they
+// overlap or touch. The interval may not start before the last interval.
+static void appendMerged(std::vector<interval_t>& ivals, const interval_t& ival)
 {
-    for (auto e : other.mIntervals)
+    if (!ivals.empty())
     {
-        interval_t tmp = e;
-        mIntervals.push_back(tmp);
+        interval_t& last = ivals.back();
+        if (ival.lower < last.upper || (ival.lower == last.upper && (last.upperClosed || ival.lowerClosed)))
+        {
+            if (upperBefore(last, ival))
+            {
+                last.upper = ival.upper;
+                last.upperClosed = ival.upperClosed;
+            }
+
+            return;
+        }
     }
+
+    ivals.push_back(ival);
 }
 
-Range::Range(Range&& other)
+// Returns the intersection of two intervals as a possibly invalid interval.
+static interval_t intersect(const interval_t& lhs, const interval_t& rhs)
 {
-    while (!other.mIntervals.empty())
-    {
-        mIntervals.push_back(other.mIntervals.front());
-        other.mIntervals.pop_front();
-    }
+    const interval_t& lo = lowerBefore(lhs, rhs) ? rhs : lhs;
+    const interval_t& hi = upperBefore(lhs, rhs) ? lhs : rhs;
+    return { lo.lower, hi.upper, lo.lowerClosed, hi.upperClosed };
 }
 
-Range& Range::operator=(const Range& other)
+// Closed double intervals [lo[k], hi[k]] containing exactly the doubles that are in a Range.
+struct DoubleRange
 {
-    if (this != &other)
+    std::vector<double> lo;
+    std::vector<double> hi;
+};
+
+// Rounds each interval inwards to the nearest doubles. A double is never strictly between an
+// endpoint and its rounding, so membership of doubles is preserved.
+static DoubleRange toDoubleRange(const std::vector<interval_t>& ivals)
+{
+    DoubleRange res;
+    for (const auto& e : ivals)
     {
-        mIntervals.clear();
-        for (auto e : other.mIntervals)
+        double lo = e.lower.toDouble(MPFR_RNDU);
+        double hi = e.upper.toDouble(MPFR_RNDD);
+        if (!e.lowerClosed && e.lower.isDouble())   lo = std::nextafter(lo, INFINITY);
+        if (!e.upperClosed && e.upper.isDouble())   hi = std::nextafter(hi, -INFINITY);
+        if (lo <= hi)
         {
-            interval_t tmp = e;
-            mIntervals.push_back(tmp);
+            res.lo.push_back(lo);
+            res.hi.push_back(hi);
         }
     }
 
-    return *this;
+    return res;
 }
 
-Range& Range::operator=(Range&& other)
+// Ordering of batch points. False if either is NaN.
+static bool lessEqual(double lhs, double rhs) { return lhs <= rhs; }
+static bool lessEqual(const Float& lhs, const Float& rhs) { return mpfr_lessequal_p(lhs.data(), rhs.data()); }
+
+// Returns true if the points are in non-decreasing order and none are NaN.
+template <typename T>
+bool isSortedBatch(const T* pts, size_t n)
 {
-    if (this != &other)
+    for (size_t i = 1; i < n; ++i)
     {
-        mIntervals.clear();
-        while (!other.mIntervals.empty())
-        {
-            mIntervals.push_back(other.mIntervals.front());
-            other.mIntervals.pop_front();
-        }
+        if (!lessEqual(pts[i - 1], pts[i]))
+            return false;
     }
 
-    return *this;
+    return n == 0 || lessEqual(pts[0], pts[0]);
 }
 
-Range& Range::operator=(const interval_t& ival)
+// Tests each point against every interval. Used for ranges with few intervals.
+static void classifyScan(const DoubleRange& r, const double* pts, size_t n, bool* res)
+{
+    size_t i = 0;
+#ifdef __SSE2__
+    for (; i + 2 <= n; i += 2)
+    {
+        __m128d x = _mm_loadu_pd(pts + i);
+        __m128d in = _mm_setzero_pd();
+        for (size_t k = 0; k < r.lo.size(); ++k)
+            in = _mm_or_pd(in, _mm_and_pd(_mm_cmple_pd(_mm_set1_pd(r.lo[k]), x), _mm_cmple_pd(x, _mm_set1_pd(r.hi[k]))));
+
+        int mask = _mm_movemask_pd(in);
+        res[i] = mask & 0x1;
+        res[i + 1] = (mask >> 1) & 0x1;
+    }
+#endif
+
+    for (; i < n; ++i)
+    {
+        bool in = false;
+        for (size_t k = 0; k < r.lo.size(); ++k)
+            in |= (r.lo[k] <= pts[i] && pts[i] <= r.hi[k]);
+        res[i] = in;
+    }
+}
+
+// Matches sorted points against the intervals in a single sweep.
+static void classifySweep(const DoubleRange& r, const double* pts, size_t n, bool* res)
+{
+    size_t k = std::lower_bound(r.hi.begin(), r.hi.end(), pts[0]) - r.hi.begin();
+    for (size_t i = 0; i < n; ++i)
+    {
+        while (k < r.hi.size() && r.hi[k] < pts[i])
+            ++k;
+        res[i] = (k < r.lo.size() && r.lo[k] <= pts[i]);
+    }
+}
+
+// Binary searches for each point.
+static void classifySearch(const DoubleRange& r, const double* pts, size_t n, bool* res)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        size_t k = std::upper_bound(r.lo.begin(), r.lo.end(), pts[i]) - r.lo.begin();
+        res[i] = (k > 0 && pts[i] <= r.hi[k - 1]);
+    }
+}
+
+// Calls func(begin, end) on consecutive chunks of [0, n), one per thread.
+template <typename Func>
+void forEachChunk(size_t n, const Func& func)
+{
+    size_t threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    threads = std::min(threads, (n + MATHSOLVER_RANGE_BATCH_CHUNK - 1) / MATHSOLVER_RANGE_BATCH_CHUNK);
+    if (threads <= 1)
+    {
+        func(0, n);
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    size_t chunk = (n + threads - 1) / threads;
+    for (size_t begin = chunk; begin < n; begin += chunk)
+        workers.emplace_back(func, begin, std::min(n, begin + chunk));
+
+    func(0, chunk);
+    for (auto& t : workers)
+        t.join();
+}
+
+
+Range::Range(const Float& lower, const Float& upper, bool lclosed, bool uclosed)
+{
+    interval_t ival;
+    ival.lower = lower;
+    ival.upper = upper;
+    ival.lowerClosed = lclosed;
+    ival.upperClosed = uclosed;
+
+    if (isValidInterval(ival))  mIntervals.push_back(ival);
+    else                        mIntervals.push_back(INTERVAL_REALS);
+    normalize();
+}
+
+Range::Range(const interval_t& ival)
 {
     mIntervals.push_back(ival);
+    normalize();
+}
+
+Range::Range(const std::initializer_list<interval_t>& ivals)
+    : mIntervals(ivals)
+{
+    normalize();
+}
+
+Range::Range(std::vector<interval_t>&& ivals)
+    : mIntervals(std::move(ivals))
+{
+    normalize();
+}
+
+Range& Range::operator=(const interval_t& ival)
+{
+    mIntervals.assign(1, ival);
+    normalize();
     return *this;
 }
 
 Range& Range::operator=(const std::initializer_list<interval_t>& ivals)
 {
-    for (auto e : ivals)
-        mIntervals.push_back(e);
-    mIntervals.sort(cmpIntervals);
+    mIntervals.assign(ivals);
+    normalize();
     return *this;
 }
 
-Range Range::conjoin(const Range& other) const
+Range Range::complement() const
 {
-    Range tmp = *this;
-    Range tmp2 = other;
+    // Gaps between consecutive intervals, plus the two unbounded ends
     Range ret;
+    interval_t gap = { "-inf", "inf", false, false };
+    for (const auto& e : mIntervals)
+    {
+        gap.upper = e.lower;
+        gap.upperClosed = !e.lowerClosed;
+        if (isValidInterval(gap) && !isEmptyInterval(gap))
+            ret.mIntervals.push_back(gap);
 
-    auto it = tmp.mIntervals.begin();
-    while (it != tmp.mIntervals.end())
-    {    
-        for (auto it2 = tmp2.mIntervals.begin(); it2 != tmp2.mIntervals.end(); ++it2)
-        {
-            interval_t& lhs = *it;
-            interval_t& rhs = *it2;
-            if (isIntersecting(lhs, rhs))
-            {   
-                interval_t inter = MathSolver::conjoin(lhs, rhs);
-                Range sub = (Range(rhs)).subtract(Range(inter));
-                
-                it2 = tmp2.mIntervals.erase(it2);
-                if (!sub.mIntervals.empty())
-                    tmp2.mIntervals.insert(it2, sub.mIntervals.begin(), sub.mIntervals.end());
-                ret.mIntervals.push_back(inter);
-                break;
-            }        
-        }
-
-        it = ret.mIntervals.erase(it);
+        gap.lower = e.upper;
+        gap.lowerClosed = !e.upperClosed;
     }
 
+    gap.upper = "inf";
+    gap.upperClosed = false;
+    if (isValidInterval(gap) && !isEmptyInterval(gap))
+        ret.mIntervals.push_back(gap);
     return ret;
 }
 
-bool Range::contains(const Float& val) const
+Range Range::conjoin(const Range& other) const
 {
-    for (auto e : mIntervals)
+    // Intersections of normalized ranges are already sorted and non-adjacent
+    Range ret;
+    auto it = mIntervals.begin(), it2 = other.mIntervals.begin();
+    while (it != mIntervals.end() && it2 != other.mIntervals.end())
     {
-        if (MathSolver::contains(e, val))
-            return true;
+        interval_t inter = intersect(*it, *it2);
+        if (isValidInterval(inter) && !isEmptyInterval(inter))
+            ret.mIntervals.push_back(std::move(inter));
+
+        if (upperBefore(*it, *it2))     ++it;
+        else                            ++it2;
     }
 
-    return false;
+    return ret;
 }
 
-Range Range::disjoin(const Range& other) const
+Range Range::conjoin(const std::vector<const Range*>& ranges)
 {
-    Range ret = *this;
-    for (auto e : other.mIntervals) ret.mIntervals.push_back(e);
-    ret.mIntervals.sort(cmpIntervals);
+    if (ranges.empty())
+        return Range();
+
+    // An intersection of single intervals is one interval, so a fold is linear
+    auto convex = [](const Range* r) { return r->mIntervals.size() <= 1; };
+    if (std::all_of(ranges.begin(), ranges.end(), convex))
+    {
+        Range ret = *ranges.front();
+        for (auto it = std::next(ranges.begin()); it != ranges.end() && !ret.mIntervals.empty(); ++it)
+            ret = ret.conjoin(**it);
+        return ret;
+    }
 
-    for (auto itr = ret.mIntervals.begin(); itr != ret.mIntervals.end() && itr != std::prev(ret.mIntervals.end()); ++itr)
+    std::vector<Range> complements;
+    std::vector<const Range*> ptrs;
+    complements.reserve(ranges.size());
+    ptrs.reserve(ranges.size());
+    for (auto r : ranges)
     {
-        auto itr2 = std::next(itr);
-        interval_t& lhs = *itr;
-        interval_t& rhs = *itr2;
-        if (isIntersecting(lhs, rhs) || (lhs.lower == rhs.upper && lhs.lowerClosed != rhs.upperClosed) || (lhs.upper == rhs.lower && lhs.upperClosed != rhs.lowerClosed))
+        if (r->mIntervals.empty())  // ex: (and {} ...) ==> {}
+            return Range();
+        complements.push_back(r->complement());
+        ptrs.push_back(&complements.back());
+    }
+
+    return disjoin(ptrs).complement();
+}
+
+bool Range::contains(const Float& val) const
+{
+    // Only the last interval starting at or before 'val' can contain it
+    auto it = std::upper_bound(mIntervals.begin(), mIntervals.end(), val,
+                               [](const Float& v, const interval_t& ival) { return ival.lower.compare(v) > 0; });
+    return it != mIntervals.begin() && MathSolver::contains(*std::prev(it), val);
+}
+
+void Range::contains(const double* pts, size_t n, bool* res) const
+{
+    DoubleRange r = toDoubleRange(mIntervals);
+    forEachChunk(n, [&](size_t begin, size_t end) {
+        if (r.lo.size() <= MATHSOLVER_RANGE_SCAN_MAX)       classifyScan(r, pts + begin, end - begin, res + begin);
+        else if (isSortedBatch(pts + begin, end - begin))   classifySweep(r, pts + begin, end - begin, res + begin);
+        else                                                classifySearch(r, pts + begin, end - begin, res + begin);
+    });
+}
+
+void Range::contains(const Float* pts, size_t n, bool* res) const
+{
+    forEachChunk(n, [&](size_t begin, size_t end) {
+        if (isSortedBatch(pts + begin, end - begin))
+        {
+            auto it = mIntervals.begin();
+            for (size_t i = begin; i < end; ++i)
+            {
+                while (it != mIntervals.end() && (it->upper.compare(pts[i]) < 0 || (it->upper.compare(pts[i]) == 0 && !it->upperClosed)))
+                    ++it;
+                res[i] = (it != mIntervals.end() && MathSolver::contains(*it, pts[i]));
+            }
+        }
+        else
         {
-            interval_t tmp;
-            if (MathSolver::contains(lhs, rhs))  tmp = lhs;
-            else if (MathSolver::contains(rhs, lhs))  tmp = rhs;
-            else if (rhs.lower > lhs.lower && rhs.lower <= lhs.upper)  tmp = { lhs.lower, rhs.upper, lhs.lowerClosed, rhs.upperClosed };
-            else /*(lhs.lower > rhs.lower && lhs.lower <= rhs.upper)*/ tmp = { rhs.lower, lhs.upper, rhs.lowerClosed, lhs.upperClosed };
-
-            itr = ret.mIntervals.erase(itr);
-            itr = ret.mIntervals.erase(itr);
-            itr = ret.mIntervals.insert(itr, tmp);
+            for (size_t i = begin; i < end; ++i)
+                res[i] = contains(pts[i]);
         }
+    });
+}
+
+Range Range::disjoin(const Range& other) const
+{
+    Range ret;
+    ret.mIntervals.reserve(mIntervals.size() + other.mIntervals.size());
+    auto it = mIntervals.begin(), it2 = other.mIntervals.begin();
+    while (it != mIntervals.end() || it2 != other.mIntervals.end())
+    {
+        if (it2 == other.mIntervals.end() || (it != mIntervals.end() && lowerBefore(*it, *it2)))
+            appendMerged(ret.mIntervals, *it++);
+        else
+            appendMerged(ret.mIntervals, *it2++);
     }
 
     return ret;
 }
 
-bool Range::intersectsWith(const Range& other) const
+Range Range::disjoin(const std::vector<const Range*>& ranges)
 {
-    for (auto i : mIntervals)
+    // Min-heap of the next interval of each Range by lower bound
+    using Cursor = std::pair<const interval_t*, const interval_t*>;
+    auto later = [](const Cursor& lhs, const Cursor& rhs) { return lowerBefore(*rhs.first, *lhs.first); };
+    std::priority_queue<Cursor, std::vector<Cursor>, decltype(later)> heap(later);
+
+    size_t count = 0;
+    for (auto r : ranges)
     {
-        for (auto j : other.mIntervals)
-        {
-            if (isIntersecting(i, j))
-                return true;
-        }
+        if (!r->mIntervals.empty())
+            heap.emplace(r->mIntervals.data(), r->mIntervals.data() + r->mIntervals.size());
+        count += r->mIntervals.size();
     }
 
-    return false;
+    Range ret;
+    ret.mIntervals.reserve(count);
+    while (!heap.empty())
+    {
+        Cursor c = heap.top();
+        heap.pop();
+        appendMerged(ret.mIntervals, *c.first);
+        if (++c.first != c.second)
+            heap.push(c);
+    }
+
+    return ret;
 }
 
-Range Range::subtract(const Range& other) const
+bool Range::intersectsWith(const Range& other) const
 {
-    Range ret = *this;
-    for (auto rhs : other.mIntervals)
-    {      
-        auto itr = ret.mIntervals.begin();
-        while (itr != ret.mIntervals.end())
-        {
-            interval_t& lhs = *itr;
-            bool removed = false;
-            if (MathSolver::contains(rhs, lhs))         
-            {   
-                removed = true;
-            }
-            else if (MathSolver::contains(lhs, rhs))
-            {
-                interval_t low = { lhs.lower, rhs.lower, lhs.lowerClosed, !rhs.lowerClosed };
-                interval_t high = { rhs.upper, lhs.upper, !rhs.upperClosed, lhs.upperClosed };
-                if (isValidInterval(low)) ret.mIntervals.insert(itr, low);
-                if (isValidInterval(high)) ret.mIntervals.insert(itr, high);
-                removed = true;
-            }
-            else
-            {
-                interval_t inter = MathSolver::conjoin(lhs, rhs);
-                if (lhs.lower == inter.lower && lhs.upper == inter.upper)
-                {
-                    interval_t low = { lhs.lower, lhs.lower, true, true };
-                    interval_t high = { lhs.upper, lhs.upper, true, true };
-                    ret.mIntervals.insert(itr, { low, high });
-                    removed = true;
-                }
-                else if (lhs.lower == inter.lower)
-                {
-                    interval_t sub = { inter.upper, lhs.upper, !inter.upperClosed, lhs.upperClosed };
-                    ret.mIntervals.insert(itr, sub);
-                    removed = true;
-                }
-                else if (lhs.upper == inter.upper)
-                {
-                    interval_t sub = { lhs.lower, inter.lower, lhs.lowerClosed, !rhs.lowerClosed };
-                    ret.mIntervals.insert(itr, sub);
-                    removed = true;
-                }
-            }
+    auto it = mIntervals.begin(), it2 = other.mIntervals.begin();
+    while (it != mIntervals.end() && it2 != other.mIntervals.end())
+    {
+        if (isIntersecting(*it, *it2))
+            return true;
 
-            if (removed)    itr = ret.mIntervals.erase(itr);
-            else            ++itr;
-        }
+        if (upperBefore(*it, *it2))     ++it;
+        else                            ++it2;
     }
 
-    return ret;
+    return false;
+}
+
+Range Range::subtract(const Range& other) const
+{
+    return conjoin(other.complement());
 }
 
 std::string Range::toString() const
@@ -299,4 +610,18 @@ std::string Range::toString() const
     return ret;
 }
 
-}
\ No newline at end of file
+void Range::normalize()
+{
+    mIntervals.erase(std::remove_if(mIntervals.begin(), mIntervals.end(),
+                                    [](const interval_t& e) { return !isValidInterval(e) || isEmptyInterval(e); }),
+                     mIntervals.end());
+    std::sort(mIntervals.begin(), mIntervals.end(), lowerBefore);
+
+    std::vector<interval_t> merged;
+    merged.reserve(mIntervals.size());
+    for (auto& e : mIntervals)
+        appendMerged(merged, e);
+    mIntervals = std::move(merged);
+}
+
+}
@@ -1,20 +1,93 @@
 #ifndef _MATHSOLVER_RANGE_H_
 #define _MATHSOLVER_RANGE_H_
 
+#include <cmath>
 #include <initializer_list>
-#include <list>
+#include <vector>
 #include <string>
 #include "../common/base.h"
 #include "float.h"
 
+// Ranges with at most this many intervals are tested interval by interval in batch classification
+#define MATHSOLVER_RANGE_SCAN_MAX       16
+
+// Minimum number of points given to each thread in batch classification
+#define MATHSOLVER_RANGE_BATCH_CHUNK    (1 << 16)
+
 namespace MathSolver
 {
 
+// Endpoint of an interval. Values that are exactly representable as a double (including the
+// infinities) are stored inline; other values are promoted to a heap-allocated Float.
+class Endpoint
+{
+public:
+
+    inline Endpoint() : mDouble(0.0), mFloat(nullptr) {}   // Zero
+    inline Endpoint(double x) : mDouble(x), mFloat(nullptr) {}
+    Endpoint(const Float& x);
+    Endpoint(const char* str);
+    Endpoint(const std::string& str);
+    Endpoint(const Endpoint& other);
+    Endpoint(Endpoint&& other);
+    ~Endpoint();
+
+    Endpoint& operator=(const Endpoint& other);
+    Endpoint& operator=(Endpoint&& other);
+
+    inline bool operator==(const Endpoint& other) const { return compare(other) == 0; }
+    inline bool operator!=(const Endpoint& other) const { return compare(other) != 0; }
+    inline bool operator<(const Endpoint& other) const { return compare(other) < 0; }
+    inline bool operator>(const Endpoint& other) const { return compare(other) > 0; }
+    inline bool operator<=(const Endpoint& other) const { return compare(other) <= 0; }
+    inline bool operator>=(const Endpoint& other) const { return compare(other) >= 0; }
+
+    // Compares this endpoint with another. Returns a positive value if this endpoint is larger,
+    // a negative value if it is smaller, or zero if they are equal. Two doubles are compared
+    // without MPFR.
+    inline int compare(const Endpoint& other) const
+    {
+        if (mFloat == nullptr && other.mFloat == nullptr)
+            return (mDouble > other.mDouble) - (mDouble < other.mDouble);
+        return compareSlow(other);
+    }
+
+    // Compares this endpoint with a Float.
+    int compare(const Float& x) const;
+
+    // Returns true if the value is stored as a double.
+    inline bool isDouble() const { return mFloat == nullptr; }
+
+    // Returns true if the value is infinite.
+    inline bool isInf() const { return (mFloat == nullptr) ? std::isinf(mDouble) : mFloat->isInf(); }
+
+    // Returns true if the value is NaN.
+    inline bool isNaN() const { return (mFloat == nullptr) ? std::isnan(mDouble) : mFloat->isNaN(); }
+
+    // Returns the value rounded to a double in the given direction.
+    inline double toDouble(mpfr_rnd_t rnd) const { return (mFloat == nullptr) ? mDouble : mpfr_get_d(mFloat->data(), rnd); }
+
+    // Returns the value as a Float.
+    Float toFloat() const;
+
+    // Converts the value to a std::string (see Float::toString).
+    inline std::string toString() const { return toFloat().toString(); }
+
+private:
+
+    // Helper function. Compares when at least one endpoint is a Float.
+    int compareSlow(const Endpoint& other) const;
+
+private:
+    double mDouble;
+    Float* mFloat;
+};
+
 // Represents a single interval low < x < high
 struct interval_t
 {  
-    Float lower;
-    Float upper;
+    Endpoint lower;
+    Endpoint upper;
     bool lowerClosed;
     bool upperClosed;
 };
@@ -48,7 +121,9 @@ interval_t subtract(const interval_t& lhs, const interval_t& rhs);
 // Returns a std::string representation of the interval.
 std::string toString(const interval_t& ival);
 
-// Represents a single continuous range or multiple discontinous ranges
+// Represents a single continuous range or multiple discontinous ranges. The intervals are kept
+// sorted by lower bound, pairwise disjoint and non-adjacent, so each set has exactly one
+// representation and the set operations are single merge sweeps.
 class Range
 {
 public:
@@ -60,22 +135,25 @@ public:
     Range(const Float& lower, const Float& upper, bool lclosed, bool uclosed); 
 
     // Single interval (interval_t)
-    inline Range(const interval_t& ival) { mIntervals.push_back(ival); }
+    Range(const interval_t& ival);
 
     // Multiple intervals (interval_t)
     Range(const std::initializer_list<interval_t>& ivals);
 
+    // Multiple intervals in any order (interval_t)
+    Range(std::vector<interval_t>&& ivals);
+
     // Copy constructor
-    Range(const Range& other);
+    Range(const Range& other) = default;
 
     // Move constructor
-    Range(Range&& other);
+    Range(Range&& other) = default;
 
     // Copy assignment
-    Range& operator=(const Range& other);
+    Range& operator=(const Range& other) = default;
 
     // Move assignment
-    Range& operator=(Range&& other);
+    Range& operator=(Range&& other) = default;
 
     // Assignment from interval_t.
     Range& operator=(const interval_t& ival);
@@ -83,19 +161,38 @@ public:
     // Assignment from multiple interval_t.
     Range& operator=(const std::initializer_list<interval_t>& ivals);
 
+    // Returns the complement of this Range in the reals.
+    Range complement() const;
+
     // Returns the conjunction (intersection) of this Range and another.
     Range conjoin(const Range& other) const;
 
-    // Returns true if the value is contained within this Range.
+    // Returns the conjunction (intersection) of many Ranges: the complement of the disjunction of
+    // their complements, so O(n log k) for n intervals over k Ranges. Ranges of single intervals
+    // are folded pairwise instead. Empty if 'ranges' is empty.
+    static Range conjoin(const std::vector<const Range*>& ranges);
+
+    // Returns true if the value is contained within this Range. O(log n).
     bool contains(const Float& val) const;
 
-    // Returns a reference to the underlying.
-    inline std::list<interval_t>& data() { return mIntervals; }
-    inline const std::list<interval_t>& data() const { return mIntervals; }
+    // Batch classification: sets res[i] to true if pts[i] is contained within this Range. Sorted
+    // points are matched in a single sweep and large batches are split across threads. The
+    // double overload compares against endpoints rounded inwards to doubles, which is exact.
+    void contains(const double* pts, size_t n, bool* res) const;
+    void contains(const Float* pts, size_t n, bool* res) const;
+
+    // Returns a reference to the underlying intervals. Callers that modify them must keep them
+    // sorted, disjoint and non-adjacent.
+    inline std::vector<interval_t>& data() { return mIntervals; }
+    inline const std::vector<interval_t>& data() const { return mIntervals; }
 
     // Returns the disjunction (union) of this Range and another.
     Range disjoin(const Range& other) const;
 
+    // Returns the disjunction (union) of many Ranges in a single k-way merge, O(n log k) for n
+    // intervals over k Ranges, rather than the O(nk) of folding with pairwise disjoin().
+    static Range disjoin(const std::vector<const Range*>& ranges);
+
     // Returns true if there exists an intersection between this Range with another.
     bool intersectsWith(const Range& other) const;
 
@@ -106,7 +203,12 @@ public:
     std::string toString() const;
 
 private:
-    std::list<interval_t> mIntervals;
+
+    // Sorts the intervals, drops empty and invalid ones, and merges those that overlap or touch.
+    void normalize();
+
+private:
+    std::vector<interval_t> mIntervals;
 };
 
 }
@@ -0,0 +1,173 @@
+#include "rational.h"
+#include "../math/integer-math.h"
+
+namespace MathSolver
+{
+
+Rational::Rational()
+    : mNum(0), mDen(1), mReduced(true)
+{
+}
+
+Rational::Rational(const Integer& num)
+    : mNum(num), mDen(1), mReduced(true)
+{
+}
+
+Rational::Rational(const Integer& num, const Integer& den)
+    : mNum(num), mDen(den), mReduced(false)
+{
+    if (mDen.sign())
+    {
+        mNum = -mNum;
+        mDen = -mDen;
+    }
+}
+
+Rational Rational::operator+(const Rational& other) const
+{
+    Rational res(*this);
+    res += other;
+    return res;
+}
+
+Rational Rational::operator-(const Rational& other) const
+{
+    Rational res(*this);
+    res -= other;
+    return res;
+}
+
+Rational Rational::operator*(const Rational& other) const
+{
+    Rational res(*this);
+    res *= other;
+    return res;
+}
+
+Rational Rational::operator/(const Rational& other) const
+{
+    Rational res(*this);
+    res /= other;
+    return res;
+}
+
+Rational& Rational::operator+=(const Rational& other)
+{
+    if (mDen == other.mDen)     // a/d + c/d = (a + c)/d
+    {
+        mNum += other.mNum;
+    }
+    else                        // a/b + c/d = (ad + cb)/bd
+    {
+        mNum *= other.mDen;
+        mNum += other.mNum * mDen;
+        mDen *= other.mDen;
+    }
+
+    mReduced = false;
+    checkWidth();
+    return *this;
+}
+
+Rational& Rational::operator-=(const Rational& other)
+{
+    return (*this += -other);
+}
+
+Rational& Rational::operator*=(const Rational& other)
+{
+    mNum *= other.mNum;
+    mDen *= other.mDen;
+    mReduced = false;
+    checkWidth();
+    return *this;
+}
+
+Rational& Rational::operator/=(const Rational& other)
+{
+    mNum *= other.mDen;
+    mDen *= other.mNum;
+    if (mDen.sign())
+    {
+        mNum = -mNum;
+        mDen = -mDen;
+    }
+
+    mReduced = false;
+    checkWidth();
+    return *this;
+}
+
+Rational Rational::operator-() const
+{
+    Rational res(*this);
+    res.mNum = -res.mNum;
+    return res;
+}
+
+int Rational::compare(const Rational& other) const
+{
+    if (mDen == other.mDen)
+        return mNum.compare(other.mNum);
+    return (mNum * other.mDen).compare(other.mNum * mDen);
+}
+
+const Integer& Rational::denominator() const
+{
+    reduce();
+    return mDen;
+}
+
+const Integer& Rational::numerator() const
+{
+    reduce();
+    return mNum;
+}
+
+bool Rational::isInteger() const
+{
+    reduce();
+    return !isUndef() && mDen.isOne();
+}
+
+void Rational::reduce() const
+{
+    if (mReduced || isUndef())
+        return;
+
+    mpz_t n, d, g;
+    mpz_inits(n, d, g, nullptr);
+    toMpz(mNum, n);
+    toMpz(mDen, d);
+    mpz_gcd(g, n, d);
+    if (mpz_cmp_ui(g, 1) > 0)
+    {
+        mpz_divexact(n, n, g);
+        mpz_divexact(d, d, g);
+        mNum = fromMpz(n);
+        mDen = fromMpz(d);
+    }
+
+    mpz_clears(n, d, g, nullptr);
+    mReduced = true;
+}
+
+std::string Rational::toString() const
+{
+    if (isUndef())
+        return "undef";
+
+    reduce();
+    if (mDen.isOne())
+        return mNum.toString();
+    return mNum.toString() + "/" + mDen.toString();
+}
+
+void Rational::checkWidth()
+{
+    if (highestNonZeroByte(mDen.data(), mDen.size()) > MATHSOLVER_RATIONAL_REDUCE_WIDTH)
+        reduce();
+}
+
+}
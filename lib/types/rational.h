@@ -0,0 +1,114 @@
+#ifndef _MATHSOLVER_RATIONAL_H_
+#define _MATHSOLVER_RATIONAL_H_
+
+#include <string>
+#include "../common/base.h"
+#include "integer.h"
+
+// Unreduced results are reduced once the denominator is wider than this many 32-bit words
+#define MATHSOLVER_RATIONAL_REDUCE_WIDTH    8
+
+namespace MathSolver
+{
+
+// Exact fraction of two Integers. The denominator is always positive. Arithmetic does not
+// reduce the result by the gcd until the value is read or printed, or the denominator grows
+// wider than MATHSOLVER_RATIONAL_REDUCE_WIDTH. Comparisons cross multiply without reducing.
+class Rational
+{
+public:
+
+    // Constructs a Rational with a value of zero.
+    Rational();
+
+    // Constructs a Rational from an Integer.
+    Rational(const Integer& num);
+
+    // Constructs a Rational from a numerator and denominator. A zero denominator results in 'undef'.
+    Rational(const Integer& num, const Integer& den);
+
+    // Equality operator
+    inline bool operator==(const Rational& other) const { return !isUndef() && !other.isUndef() && compare(other) == 0; }
+
+    // Inequality operator
+    inline bool operator!=(const Rational& other) const { return !isUndef() && !other.isUndef() && compare(other) != 0; }
+
+    // Greater than operator
+    inline bool operator>(const Rational& other) const { return !isUndef() && !other.isUndef() && compare(other) > 0; }
+
+    // Less than operator
+    inline bool operator<(const Rational& other) const { return !isUndef() && !other.isUndef() && compare(other) < 0; }
+
+    // Greater than or equal operator
+    inline bool operator>=(const Rational& other) const { return !isUndef() && !other.isUndef() && compare(other) >= 0; }
+
+    // Less than or equal operator
+    inline bool operator<=(const Rational& other) const { return !isUndef() && !other.isUndef() && compare(other) <= 0; }
+
+    // Addition operator
+    Rational operator+(const Rational& other) const;
+
+    // Subtraction operator
+    Rational operator-(const Rational& other) const;
+
+    // Multiplication operator
+    Rational operator*(const Rational& other) const;
+
+    // Division operator. Division by zero results in 'undef'.
+    Rational operator/(const Rational& other) const;
+
+    // Addition assignment operator
+    Rational& operator+=(const Rational& other);
+
+    // Subtraction assignment operator
+    Rational& operator-=(const Rational& other);
+
+    // Multiplication assignment operator
+    Rational& operator*=(const Rational& other);
+
+    // Division assignment operator
+    Rational& operator/=(const Rational& other);
+
+    // Unary minus operator
+    Rational operator-() const;
+
+    // Compares this Rational and another by cross multiplication. Returns a positive value if this
+    // Rational is larger, a negative value if it is smaller, or zero if they are equal.
+    int compare(const Rational& other) const;
+
+    // Returns the reduced numerator and denominator.
+    const Integer& denominator() const;
+    const Integer& numerator() const;
+
+    // Returns true if the reduced denominator is one.
+    bool isInteger() const;
+
+    // Returns true if this Rational is 'undef'.
+    inline bool isUndef() const { return mNum.isUndef() || mDen.isZero(); }
+
+    // Returns true if this Rational is zero.
+    inline bool isZero() const { return !isUndef() && mNum.isZero(); }
+
+    // Divides the numerator and denominator by their gcd.
+    void reduce() const;
+
+    // Returns true if this Rational is negative.
+    inline bool sign() const { return mNum.sign() && !mNum.isZero(); }
+
+    // Returns this Rational as a std::string: "n/d", or "n" if the denominator is one.
+    std::string toString() const;
+
+private:
+
+    // Helper function. Reduces the result of an operation if the denominator has grown too wide.
+    void checkWidth();
+
+private:
+    mutable Integer mNum;
+    mutable Integer mDen;
+    mutable bool mReduced;
+};
+
+}
+
+#endif
@@ -84,7 +84,7 @@ int main()
 
 	tests.reset("*");
 	{
-		const size_t COUNT = 9;
+		const size_t COUNT = 14;
 		const std::string exprs[COUNT * 2] = 
 		{ 
 			"100*1000",		"100000",
@@ -95,7 +95,12 @@ int main()
 			"(a/b)*(c/d)",	"ac/bd",
 			"a*(1/d)",		"a/d",
 			"2*a+2*b",		"2(a+b)",
-			"2a+a(b)",		"(b+2)a"
+			"2a+a(b)",		"(b+2)a",
+			"(x+1)(x-1)",	"x^2-1",
+			"(x+1)*(x+1)",	"x^2+2x+1",
+			"2(x^2+x+1)(x-1)",	"2x^3-2",
+			"2(x+1)",		"2(x+1)",
+			"3(x^2+x)",		"3(x^2+x)"
 		};
 
 		status &= evalExpr(tests, exprs, COUNT);
@@ -202,5 +207,122 @@ int main()
 		status &= evalExpr(tests, exprs, COUNT);
 	}
 
+	tests.reset("Numeric sums and products");
+	{
+		const size_t COUNT = 7;
+		const std::string exprs[COUNT * 2] = 
+		{ 
+			"1.5+2+-1.5",				"2",
+			"1+2+3+4-10",				"0",
+			"2.5*4*0.5",				"5",
+			"-2*-3*-4",					"-24",
+			"2*3*0*5",					"0",
+			"123456789123456789123456789*987654321987654321",	"121932631356500531469135800347203169112635269",
+			"10000000000000000000000*10000000000000000000000*3",	"300000000000000000000000000000000000000000000"
+		};
+
+		status &= evalExpr(tests, exprs, COUNT);
+	}
+
+	tests.reset("Rationals");
+	{
+		const size_t COUNT = 16;
+		const std::string exprs[COUNT * 2] = 
+		{ 
+			"1/2+1/3",					"5/6",
+			"1/2+1/3+1/6",				"1",
+			"1/2-1/3",					"1/6",
+			"1/2*1/3",					"1/6",
+			"(1/2)/(3/4)",				"2/3",
+			"1/(2/3)",					"3/2",
+			"(2/3)^-2",					"9/4",
+			"(1/2)^2+1",				"5/4",
+			"1/2+0.25",					"0.75",
+			"(1/2)*x+(1/3)*x",			"(5/6)x",
+			"2*((1/2)*x)",				"x",
+			"(1/2)*x*2",				"x",
+			"x*(1/2)*(1/3)",			"(1/6)x",
+			"(1/2)*x*(-2)",				"-x",
+			"1/3*x+1/3*x",				"(2/3)x",
+			"3*x*(1/2)",				"(3/2)x"
+		};
+
+		status &= evalExpr(tests, exprs, COUNT);
+	}
+
+	tests.reset("Constants");
+	{
+		const size_t COUNT = 11;
+		const std::string exprs[COUNT * 2] = 
+		{ 
+			"pi",			"3.141592653589793",
+			"2e",			"5.43656365691809",
+			"cos(pi)",		"-1",
+			"sin(pi/7)",	"0.4338837391175581",
+			"x+pi",			"x+pi",
+			"2*pi*x",		"2*pi*x",
+			"pi-3",			"0.1415926535897932",
+			"4-pi",			"0.8584073464102068",
+			"sin(pi)",		"0",
+			"cos(3pi/2)",	"0",
+			"tan(100pi)",	"0"
+		};
+
+		status &= evalExpr(tests, exprs, COUNT);
+	}
+
+	tests.reset("Term order, no errors");
+	{
+		const size_t COUNT = 3;
+		const std::string exprs[COUNT * 2] = 
+		{ 
+			"x^3-2x+1",		"x^3-2x+1",
+			"x^3+x^2-x+1",	"x^3+x^2-x+1",
+			"x^2+2x^3+x",	"2x^3+x^2+x"
+		};
+
+		for (size_t i = 0; i < COUNT; ++i)
+		{
+			gErrorManager.clear();
+			ExprNode* expr = parseString(exprs[2 * i]);
+			flattenExpr(expr);
+			expr = evaluateExpr(expr);
+			tests.runTest(toInfixString(expr), exprs[2 * i + 1]);
+			tests.runTest(std::to_string(gErrorManager.hasError()), "0");
+			freeExpression(expr);
+		}
+
+		std::cout << tests.result() << std::endl;
+		status &= tests.status();
+	}
+
+	tests.reset("Adaptive precision");
+	{
+		const size_t COUNT = 7;
+		const std::string exprs[COUNT * 3] = 
+		{ 
+			"sin(pi/7)",			"0.4338837391175581",		"64",
+			"1/3+1",				"1.333333333333333",		"64",
+			"2^70",					"1.180591620717411e+21",	"64",
+			"cos(pi*10^80)",		"1",						"512",
+			"exp(pi*163^(1/2))",	"2.625374126407687e+17",	"64",
+			"1/(pi-3.14159265358979323846)",	"3.783030662840768e+20",	"128",
+			"1/(1-1)",				"",							"64"
+		};
+
+		for (size_t i = 0; i < COUNT; ++i)
+		{
+			ExprNode* expr = parseString(exprs[3 * i]);
+			flattenExpr(expr);
+			AdaptiveResult res = evaluateAdaptive(expr);
+			tests.runTest(res.digits, exprs[3 * i + 1]);
+			tests.runTest(std::to_string(res.precision), exprs[3 * i + 2]);
+			freeExpression(expr);
+		}
+
+		std::cout << tests.result() << std::endl;
+		status &= tests.status();
+	}
+
 	return (int)!status;
 }
@@ -21,6 +21,21 @@ bool evalExpr(TestModule& tester, const std::string exprs[], size_t count)
 	return tester.status();
 }
 
+// Replaces each variable a, b, c, ... with bit 0, 1, 2, ... of 'row'.
+ExprNode* assign(ExprNode* expr, size_t row)
+{
+	if (expr->type() == ExprNode::VARIABLE)
+	{
+		ExprNode* val = new BoolNode((row >> (((VarNode*)expr)->name()[0] - 'a')) & 1, expr->parent());
+		delete expr;
+		return val;
+	}
+
+	for (auto& e : expr->children())
+		e = assign(e, row);
+	return expr;
+}
+
 int main()
 {
 	bool status = true;
@@ -80,5 +95,128 @@ int main()
 		status &= evalExpr(tests, exprs, COUNT);
 	}
 
+	{
+		TestModule tests("Short circuit", verbose);
+		const size_t COUNT = 6;
+		const std::string exprs[COUNT * 2] =
+		{
+			"x^3-2*x>1 and false",			"false",
+			"true and x>2",					"x>2",
+			"x^2>1 or true",				"true",
+			"not (1>2)",					"true",
+			"false or x>1 or x<0",			"x<0 or x>1",
+			"true xor x>1",					"not x>1"
+		};
+
+		status &= evalExpr(tests, exprs, COUNT);
+	}
+
+	{
+		TestModule tests("Variables", verbose);
+		const size_t COUNT = 10;
+		const std::string exprs[COUNT * 2] =
+		{
+			"a and not a",								"false",
+			"a or not a",								"true",
+			"a and b or a and not b",					"a and not b",
+			"(a and b) or (a and c) or (a and b and c)",	"(a and b) or (a and c)",
+			"not (a and b)",							"not (a and b)",
+			"a xor b xor a",							"b",
+			"(a or b) and (a or not b)",				"a",
+			"x>2 and a or x>2",							"x>2",
+			"a or not not b",							"a or b",
+			"true and (a or not not b)",				"a or b"
+		};
+
+		status &= evalExpr(tests, exprs, COUNT);
+	}
+
+	{
+		TestModule tests("Satisfiability", verbose);
+		const std::string exprs[4][2] =
+		{
+			{ "a and b and not (a or b)",			"(a or b) and not a and not b" },
+			{ "a or b or c or d or e or f or g",	"not (not a and not b and not c and not d and not e and not f and not g)" },
+			{ "(a xor b) xor (c xor d) xor (e xor f) xor g",	"a xor b xor c xor d xor e xor f xor g" },
+			{ "a and not a or b and c",				"c and b" }
+		};
+
+		const std::string expected[4] = { "false true", "true true", "true true", "true true" };
+		for (size_t i = 0; i < 4; ++i)
+		{
+			ExprNode* lhs = parseString(exprs[i][0]);
+			ExprNode* rhs = parseString(exprs[i][1]);
+			flattenExpr(lhs);
+			flattenExpr(rhs);
+			std::string sat = isSatisfiable(lhs) ? "true" : "false";
+			std::string eqv = isEquivalent(lhs, rhs, BooleanOrder::FREQUENCY) ? "true" : "false";
+			tests.runTest(sat + " " + eqv, expected[i]);
+			freeExpression(lhs);
+			freeExpression(rhs);
+		}
+
+		std::cout << tests.result() << std::endl;
+		status &= tests.status();
+	}
+
+	{
+		TestModule tests("BoolProgram", verbose);
+		const std::string exprs[4] = { "a and (b or not c) xor a", "a or b or c", "not (a and b) and (a xor c)", "a and not a or b" };
+		for (const auto& str : exprs)
+		{
+			// Row k assigns bit i of k to the i-th letter, checked against the tree walker
+			ExprNode* expr = parseString(str);
+			flattenExpr(expr);
+			BoolProgram prog;
+			prog.lower(expr);
+
+			const uint64_t bits[3] = { 0xAA, 0xCC, 0xF0 };
+			std::vector<const uint64_t*> columns;
+			for (const auto& var : prog.variables())
+				columns.push_back(&bits[var[0] - 'a']);
+
+			uint64_t expected = 0;
+			for (size_t row = 0; row < 8; ++row)
+			{
+				ExprNode* res = evaluateExpr(assign(copyOf(expr), row));
+				if (((BoolNode*)res)->value())
+					expected |= (1ull << row);
+				freeExpression(res);
+			}
+
+			tests.runTest(std::to_string(prog.evaluate(columns, 8).front()), std::to_string(expected));
+			freeExpression(expr);
+		}
+
+		ExprNode* expr = parseString("a or not a");
+		BoolProgram prog;
+		prog.lower(expr);
+		std::vector<uint64_t> col(2, 0x123456789ABCDEFull);
+		std::vector<uint64_t> res = prog.evaluate({ col.data() }, 100);
+		tests.runTest(std::to_string(res.size()) + " " + std::to_string(res[0] == ~0ull) + " " + std::to_string(res[1]), "2 1 68719476735");
+		freeExpression(expr);
+
+		std::cout << tests.result() << std::endl;
+		status &= tests.status();
+	}
+
+	{
+		TestModule tests("Short circuit, skipped", verbose);
+		const std::string exprs[3] = { "x^3-x>0 and 1>2 and x^2>1", "x^3>1 or 1<2 or x^2>1 or x>1", "x^2>1 and x<5" };
+		const std::string expected[3] = { "0 2", "0 3", "2 0" };
+		for (size_t i = 0; i < 3; ++i)
+		{
+			ShortCircuitStats stats;
+			ExprNode* expr = parseString(exprs[i]);
+			flattenExpr(expr);
+			expr = evaluateExpr(expr, &stats);
+			tests.runTest(std::to_string(stats.evaluated) + " " + std::to_string(stats.skipped), expected[i]);
+			freeExpression(expr);
+		}
+
+		std::cout << tests.result() << std::endl;
+		status &= tests.status();
+	}
+
     return (int)(!status);
 }
\ No newline at end of file
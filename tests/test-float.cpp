@@ -252,5 +252,46 @@ int main()
         status &= tests.status();
     }
 
+    {
+        Float wide, narrow;
+        mpfr_set_prec(wide.data(), 1024);
+        mpfr_set_prec(narrow.data(), 24);
+        mpfr_const_pi(wide.data(), MPFR_RNDN);
+        mpfr_const_pi(narrow.data(), MPFR_RNDN);
+
+        Float copy(wide), assigned;
+        assigned = wide;
+        Float moved(std::move(copy));
+
+        TestModule tests("Copy (precision)", verbosity);
+        tests.runTest(std::to_string(Float(wide).precision()), "1024");
+        tests.runTest(std::to_string(assigned.precision()), "1024");
+        tests.runTest(std::to_string(moved.precision()), "1024");
+        tests.runTest(std::to_string(Float(narrow).precision()), "24");
+        tests.runTest(bool_to_string(Float(wide) == wide && assigned == wide), "true");
+        tests.runTest(bool_to_string(Float(narrow) == narrow), "true");
+
+        std::cout << tests.result() << std::endl;
+        status &= tests.status();
+    }
+
+    {
+        Float f1 = "1.0";
+        Float f2 = "-1.0";
+        Float f3 = "1.5";
+        Float f4 = "nan";
+
+        TestModule tests("small integers", verbosity);
+        tests.runTest(bool_to_string(f1.isOne()), "true");
+        tests.runTest(bool_to_string(f2.isOne()), "false");
+        tests.runTest(bool_to_string(f2.isMinusOne()), "true");
+        tests.runTest(bool_to_string(f4.isOne()), "false");
+        tests.runTest(bool_to_string(f3.compare(1) > 0), "true");
+        tests.runTest(bool_to_string(f3.compare(2) < 0), "true");
+
+        std::cout << tests.result() << std::endl;
+        status &= tests.status();
+    }
+
     return (int)(!status);
 }
\ No newline at end of file
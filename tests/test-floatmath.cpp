@@ -1,6 +1,7 @@
 #include <iostream>
 #include <string>
 #include "../lib/test/test-common.h"
+#include "../lib/math/ball-math.h"
 #include "../lib/math/float-math.h"
 
 using namespace MathSolver;
@@ -330,6 +331,43 @@ int main()
 		status &= tests.status();
     }
 
+    {
+        TestModule tests("constants", verbose);
+        const Float* pi = constantValue("pi");
+        const Float* pi53 = constantValue("pi", 53);
+
+        tests.runTest(pi->toString(), "3.141592653589793");
+        tests.runTest(constantValue("e")->toString(), "2.718281828459045");
+        tests.runTest(constantValue("log2")->toString(), "0.6931471805599453");
+        tests.runTest(std::to_string(pi53->precision()), "53");
+        tests.runTest(std::to_string(constantValue("pi") == pi), "1");       // shared
+        tests.runTest(std::to_string(constantValue("tau") == nullptr), "1");
+
+        std::cout << tests.result() << std::endl;
+		status &= tests.status();
+    }
+
+    {
+        TestModule tests("Ball", verbose);
+        Ball one(Float("1"), 64);
+        Ball three(Float("3"), 64);
+        Ball x = sin(one / three);
+        std::string str;
+
+        tests.runTest(std::to_string((one / three).roundsTo(16, str)) + str, "10.3333333333333333");
+        tests.runTest(std::to_string(exp(one).roundsTo(16, str)) + str, "12.718281828459045");
+        tests.runTest(std::to_string(pow(three, 40).isExact()), "1");
+        tests.runTest(std::to_string(x.lower() <= sin(Float("1") / Float("3")) && sin(Float("1") / Float("3")) <= x.upper()), "1");
+        tests.runTest(std::to_string((one / (one - one)).isFinite()), "0");
+        tests.runTest(std::to_string(log(Ball(Float("0"), 64)).isFinite()), "0");
+        tests.runTest(std::to_string((one / (one - one)).isUndef()), "1");
+        tests.runTest(std::to_string(log(constantBall("pi", 64) - constantBall("pi", 64)).isUndef()), "0");
+        tests.runTest(std::to_string(constantBall("pi", 64).roundsTo(16, str)) + str, "13.141592653589793");
+
+        std::cout << tests.result() << std::endl;
+		status &= tests.status();
+    }
+
     mpfr_free_cache();
     return (bool)(!status);
 }
\ No newline at end of file
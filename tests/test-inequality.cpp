@@ -124,5 +124,99 @@ int main()
 		status &= evalExpr(tests, exprs, COUNT);
 	}
 
+	{
+		TestModule tests("Connectives", verbose);
+		const size_t COUNT = 6;
+		const std::string exprs[COUNT * 2] =
+		{
+			"x>0 and x!=2 and x<5",			"0<x<2 or 2<x<5",
+			"x>=1 and x<3 and x>0",			"1<=x<3",
+			"x>1 and y<2 and x<4 and y>0",	"1<x<4 and 0<y<2",
+			"x<1 or x>3 or x<0",			"x<1 or x>3",
+			"x^2>1 and x>0",				"x>1",
+			"x>5 and y>0 and x<2",			"false"
+		};
+
+		status &= evalExpr(tests, exprs, COUNT);
+	}
+
+	{
+		TestModule tests("Chains", verbose);
+		const size_t COUNT = 6;
+		const std::string exprs[COUNT * 2] =
+		{
+			"1<=2<3",					"true",
+			"1<2.5<3<=3",				"true",
+			"2>1.5>=1.5>2",				"false",
+			"1<2<x<5<7",				"2<x<5",
+			"x<1<2",					"x<1",
+			"100000000000000000000001>100000000000000000000000.0",	"true"
+		};
+
+		status &= evalExpr(tests, exprs, COUNT);
+	}
+
+	{
+		TestModule tests("Polynomial", verbose);
+		const size_t COUNT = 11;
+		const std::string exprs[COUNT * 2] =
+		{
+			"x^3-2*x+1>0",				"-1.618033988749895<x<0.6180339887498948 or x>1",
+			"x^2>4",					"x<-2 or x>2",
+			"2*x+1>0",					"x>-0.5",
+			"x^2>=0",					"-inf<x<inf",
+			"x^2>0",					"x<0 or x>0",
+			"x^2<0",					"false",
+			"x^3!=x",					"x<-1 or -1<x<0 or 0<x<1 or x>1",
+			"x^2-2>0 and x^2-9<0",		"-3<x<-1.414213562373095 or 1.414213562373095<x<3",
+			"x^2/2>1",					"x<-1.414213562373095 or x>1.414213562373095",
+			"x^2/2>1/2",				"x<-1 or x>1",
+			"x/(-2)<1",					"x>-2"
+		};
+
+		status &= evalExpr(tests, exprs, COUNT);
+	}
+
+	{
+		TestModule tests("Linear systems", verbose);
+		const size_t COUNT = 9;
+		const std::string exprs[COUNT * 2] =
+		{
+			"x+y<3 and x+y>4",					"false",
+			"x+y<3 and x>2 and y>1",			"false",
+			"x-y>0 and y-z>0 and z-x>0",		"false",
+			"x+y<3 and 2*x+2*y<6",				"x+y<3",
+			"x+y<=3 and x>=2 and y>=1",			"x+y<=3 and x>=2 and y>=1",
+			"x+y<3 and x-y>1 and y>-5 and x-2*y<20",	"x+y<3 and x-y>1 and y>-5",
+			"x+y<3 and x>2 and x<5 and y>1",	"false",
+			"2<x+y<3 and x>2 and y>1",			"false",
+			"x+y<10 and x>2 and x<5 and y>0",	"x+y<10 and 2<x<5 and y>0"
+		};
+
+		status &= evalExpr(tests, exprs, COUNT);
+	}
+
+	{
+		TestModule tests("Linear projection", verbose);
+		LinearSystem system(0);
+		std::vector<std::string> vars;
+		ExprNode* expr = parseString("x+y<3 and x-y>1 and y>=-1");
+		flattenExpr(expr);
+		toLinearSystem(expr, system, vars);
+		freeExpression(expr);
+
+		std::vector<Rational> point;
+		bool feasible = system.feasible(&point);
+		tests.runTest(std::to_string(feasible) + " " + std::to_string(point[0] + point[1] < Rational(Integer(3))), "1 1");
+		tests.runTest(linearRange(system, 0).toString(), "(0, 4)");
+		tests.runTest(linearRange(system, 1).toString(), "[-1, 1)");
+		tests.runTest(std::to_string(system.reduce().size()), "3");
+
+		system.add({ Rational(Integer(0)), Rational(Integer(-1)) }, Rational(Integer(1)), true);	// y > -1
+		tests.runTest(linearRange(system, 1).toString(), "(-1, 1)");
+		std::cout << tests.result() << std::endl;
+		status &= tests.status();
+	}
+
     return (int)(!status);
 }
\ No newline at end of file
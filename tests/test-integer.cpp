@@ -262,6 +262,10 @@ int main()
 		tests.runTest(r68.toString(), "43239");
 		tests.runTest(r07.toString(), "12351235213512351351235123511998893");
 
+		Integer r81 = cints[8];		// shorter plus longer magnitude of opposite sign
+		r81 += cints[1];
+		tests.runTest(r81.toString(), "-9590845098800818953801280582410");
+
 		std::cout << tests.result() << std::endl;
 		status &= tests.status();
 	}
@@ -331,6 +335,10 @@ int main()
 		tests.runTest(r68.toString(), "43189");
 		tests.runTest(r07.toString(), "12351235213512351351235123512705795");
 
+		Integer r62 = cints[6];		// shorter minus longer magnitude
+		r62 -= cints[2];
+		tests.runTest(r62.toString(), "-9243689238946312305020");
+
 		std::cout << tests.result() << std::endl;
 		status &= tests.status();
 	}
@@ -1098,5 +1106,25 @@ int main()
 	std::cout << tests.result() << std::endl;
 	status &= tests.status();
 
+	{
+		tests.reset("small integers");
+		Integer one(1);
+		Integer mone(-1);
+		Integer big("18446744073709551617");	// 2^64 + 1
+		Integer u("nan");
+
+		tests.runTest(bool_to_string(one.isOne()), "true");
+		tests.runTest(bool_to_string(mone.isOne()), "false");
+		tests.runTest(bool_to_string(mone.isMinusOne()), "true");
+		tests.runTest(bool_to_string(u.isOne()), "false");
+		tests.runTest(std::to_string(big.compare(INT64_MAX) > 0), "1");
+		tests.runTest(std::to_string((-big).compare(INT64_MIN) < 0), "1");
+		tests.runTest(std::to_string(Integer(INT64_MIN).compare(INT64_MIN)), "0");
+		tests.runTest(std::to_string(Integer(0).compare(-1) > 0), "1");
+		tests.runTest(std::to_string(cints[7].compare(-353451)), "0");
+	}
+	std::cout << tests.result() << std::endl;
+	status &= tests.status();
+
 	return (int)(!status);
 }
@@ -0,0 +1,142 @@
+#include <iostream>
+#include <string>
+#include "../lib/test/test-common.h"
+#include "../lib/eval/bisection.h"
+#include "../lib/eval/enclosure.h"
+#include "../lib/eval/evaluator.h"
+#include "../lib/expr/parser.h"
+#include "../lib/math/interval-math.h"
+#include "../lib/types/interval.h"
+
+using namespace MathSolver;
+
+int main()
+{
+	bool status = true;
+	bool verbose = false;
+
+	{
+		Interval a(Float("-1"), Float("2"), 64);
+		Interval b(Float("3"), Float("4"), 64);
+		Interval third = Interval(Float("1"), 64) / Interval(Float("3"), 64);
+
+		TestModule tests("Arithmetic", verbose);
+		tests.runTest((a + b).toString(), "[2, 6]");
+		tests.runTest((a - b).toString(), "[-5, -1]");
+		tests.runTest((a * b).toString(), "[-4, 8]");
+		tests.runTest((a * a).toString(), "[-2, 4]");
+		tests.runTest((b / b).toString(), "[0.75, 1.333333333333333]");
+		tests.runTest((b / a).toString(), "undef");
+		tests.runTest((-a).toString(), "[-2, 1]");
+		tests.runTest(std::to_string(third.contains(Float("0.33333333333333333333333333"))), "1");
+		tests.runTest(std::to_string(mpfr_less_p(third.lower().data(), third.upper().data())), "1");
+		tests.runTest((Interval::entire(64) * Interval(64)).toString(), "[0, 0]");
+
+		std::cout << tests.result() << std::endl;
+		status &= tests.status();
+	}
+
+	{
+		Interval a(Float("-1"), Float("2"), 64);
+		Interval pi = constantInterval("pi", 64);
+		Interval widePi = constantInterval("pi", 1024);
+		Interval copy = widePi;     // bounds are not rounded to the default precision
+
+		TestModule tests("Functions", verbose);
+		tests.runTest(pow(a, 2).toString(), "[0, 4]");
+		tests.runTest(pow(a, 3).toString(), "[-1, 8]");
+		tests.runTest(exp(Interval(64)).toString(), "[1, 1]");
+		tests.runTest(log(a).toString(), "undef");
+		tests.runTest(sin(a).toString(), "[-0.8414709848078965, 1]");
+		tests.runTest(cos(a).toString(), "[-0.4161468365471424, 1]");
+		tests.runTest(cos(pi).toString(), "[-1, -1]");
+		tests.runTest(tan(a).toString(), "undef");
+		tests.runTest(std::to_string(sin(pi).contains(Float("0"))), "1");
+		tests.runTest(mod(Interval(Float("7"), 64), Interval(Float("3"), 64)).toString(), "[1, 1]");
+		tests.runTest(std::to_string(copy.precision()), "1024");
+		tests.runTest(std::to_string(copy.lower() == widePi.lower() && copy.upper() == widePi.upper()), "1");
+
+		std::cout << tests.result() << std::endl;
+		status &= tests.status();
+	}
+
+	{
+		IntervalBox box = { { "x", Interval(Float("1"), Float("2"), 64) },
+							{ "y", Interval(Float("-1"), Float("1"), 64) } };
+
+		TestModule tests("Evaluation", verbose);
+		tests.runTest(evaluateInterval(parseString("x^2-2*x"), box, 64).toString(), "[-3, 2]");
+		tests.runTest(evaluateInterval(parseString("x*y+1"), box, 64).toString(), "[-1, 3]");
+		tests.runTest(evaluateInterval(parseString("exp(y)"), box, 64).toString(), "[0.3678794411714423, 2.718281828459045]");
+		tests.runTest(evaluateInterval(parseString("1/y"), box, 64).toString(), "undef");
+		tests.runTest(evaluateInterval(parseString("x+z"), box, 64).toString(), "undef");
+		tests.runTest(evaluateInterval(parseString("3!/x"), box, 64).toString(), "[3, 6]");
+
+		std::cout << tests.result() << std::endl;
+		status &= tests.status();
+	}
+
+	{
+		interval_t domain = { -8.0, 8.0, true, true };
+		BisectionOptions opts;
+		opts.tolerance = 1e-6;
+
+		BisectionResult square = solveInequality(parseString("x^2<4"), domain, opts);
+		BisectionResult root = solveInequality(parseString("x^3-x!=0"), domain, opts);
+		BisectionResult sine = solveInequality(parseString("sin(x)>x^2-1"), domain, opts);
+		BisectionResult pole = solveInequality(parseString("1/x>1"), domain, opts);
+		opts.maxBoxes = 10;
+		BisectionResult budget = solveInequality(parseString("sin(x)>x^2-1"), domain, opts);
+
+		TestModule tests("Bisection", verbose);
+		tests.runTest(square.range.toString(), "(-2, 2)");
+		tests.runTest(root.range.toString(), "[-8, -1) U (-1, 0) U (0, 1) U (1, 8]");
+		tests.runTest(pole.range.toString(), "(0, 1)");
+		tests.runTest(std::to_string(sine.complete && sine.undecided.data().empty()), "1");
+		tests.runTest(std::to_string(sine.range.contains(Float("-0.636")) && !sine.range.contains(Float("-0.638"))), "1");
+		tests.runTest(std::to_string(sine.range.contains(Float("1.409")) && !sine.range.contains(Float("1.41"))), "1");
+		tests.runTest(std::to_string(!budget.complete && budget.boxes == 10), "1");
+		tests.runTest(std::to_string(budget.undecided.contains(Float("1.4096"))), "1");
+
+		std::cout << tests.result() << std::endl;
+		status &= tests.status();
+	}
+
+	{
+		auto setBuild = [](const std::string& str) {
+			ExprNode* expr = evaluateExpr(parseString(str));
+			std::string res = toInfixString(expr);
+			freeExpression(expr);
+			return res;
+		};
+
+		auto solveRange = [](const std::string& str) {
+			ExprNode* expr = evaluateExpr(parseString(str));
+			Range res = (expr->type() == ExprNode::RANGE) ? ((RangeNode*)expr)->value() : Range();
+			freeExpression(expr);
+			return res;
+		};
+
+		Range logBound = solveRange("{x | 0<x<4 and log(x)<1}");
+		Range expBound = solveRange("{x | -2<x<2 and exp(x)>2} or {x | x>5}");
+
+		TestModule tests("Set builders", verbose);
+		tests.runTest(setBuild("{x | -x>1}"), "(-inf, -1)");
+		tests.runTest(setBuild("{x | x^2<4 and x!=1}"), "(-2, 1) U (1, 2)");
+		tests.runTest(setBuild("{x | x>1 and x<3} or {x | x^2>25}"), "(-inf, -5) U (1, 3) U (5, inf)");
+		tests.runTest(setBuild("{x | exp(x)>2}"), "{ x | exp(x)>2 }");
+		tests.runTest(setBuild("{x | -2<x<2 and exp(x)>x^2-x+1}"), "(0, 2)");
+		tests.runTest(setBuild("{x | 0<x<10 and sin(1/x)>0}"), "{ x | 0<x<10 and sin((1/x))>0 }");  // out of budget
+		tests.runTest(setBuild("{x | -10<x<10 and sin(x)>0}"),
+			"(-10, -9.424777960521169) U (-6.283185307402164, -3.141592653701082) U (0, 3.141592653701082) U (6.283185307402164, 9.424777960521169)");
+		tests.runTest(setBuild("{x | -10<x<10 and sin(x)>=0}"),
+			"(-10, -9.424777960521169] U [-6.283185307402164, -3.141592653701082] U [0, 3.141592653701082] U [6.283185307402164, 9.424777960521169]");
+		tests.runTest(std::to_string(logBound.contains(Float("2.718")) && !logBound.contains(Float("2.719")) && !logBound.contains(Float("0"))), "1");
+		tests.runTest(std::to_string(expBound.contains(Float("0.694")) && !expBound.contains(Float("0.693")) && expBound.contains(Float("6"))), "1");
+
+		std::cout << tests.result() << std::endl;
+		status &= tests.status();
+	}
+
+	return (int)(!status);
+}
@@ -30,13 +30,14 @@ int main()
 	//
 
 	{
-		const size_t COUNT = 4;
+		const size_t COUNT = 5;
 		const std::string exprs[COUNT * 2] = 
 		{ 
 			"-x",		"(-* x)",
 			"-(x)",		"(-* x)",
 			"x+-y",		"(+ x (-* y))",
-			"x--y",		"(- x (-* y))"
+			"x--y",		"(- x (-* y))",
+			"{x | -x>1}",	"(| x (> (-* x) 1))"
 		};
 
 		TestModule tests("Parser - (negate)", verbose);
@@ -0,0 +1,242 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include "../lib/mathsolver.h"
+#include "../lib/test/test-common.h"
+
+using namespace MathSolver;
+
+// Parses and expands each expression, comparing against the expected output
+bool expandExpr(TestModule& tester, const std::string exprs[], size_t count)
+{
+	for (size_t i = 0; i < count; ++i)
+	{
+		ExprNode* expr = parseString(exprs[2 * i]);
+		flattenExpr(expr);
+		expr = expandPolynomial(expr);
+		tester.runTest(toInfixString(expr), exprs[2 * i + 1]);
+		freeExpression(expr);
+	}
+
+	std::cout << tester.result() << std::endl;
+	return tester.status();
+}
+
+std::string denseToString(const DensePoly& poly)
+{
+	ExprNode* expr = fromDensePoly(poly, "x");
+	std::string str = toInfixString(expr);
+	freeExpression(expr);
+	return str;
+}
+
+// Returns a random polynomial of the given length with coefficients in [-max, max].
+DensePoly randomPoly(std::mt19937& rng, size_t len, int max)
+{
+	std::uniform_int_distribution<int> dist(-max, max);
+	std::vector<Integer> coeffs;
+	for (size_t i = 0; i < len; ++i)
+		coeffs.push_back(Integer(dist(rng)));
+	return DensePoly(std::move(coeffs));
+}
+
+// Lowers each polynomial, comparing the Horner form and its value at x = 2, y = 3
+bool lowerExpr(TestModule& tester, const std::string exprs[], size_t count)
+{
+	for (size_t i = 0; i < count; ++i)
+	{
+		ExprNode* expr = parseString(exprs[3 * i]);
+		flattenExpr(expr);
+
+		PolyProgram prog;
+		ExprNode* horner = (prog.lower(expr) ? prog.toExpr() : parseString("undef"));
+		tester.runTest(toInfixString(horner), exprs[3 * i + 1]);
+		tester.runTest(prog.evaluate(std::vector<Float>({ Float("2"), Float("3") })).toString(), exprs[3 * i + 2]);
+		freeExpression(horner);
+		freeExpression(expr);
+	}
+
+	std::cout << tester.result() << std::endl;
+	return tester.status();
+}
+
+int main()
+{
+	bool status = true;
+	bool verbose = false;
+
+	{
+		DensePoly p1({ Integer(1), Integer(1) });			// x+1
+		DensePoly p2({ Integer(-1), Integer(0), Integer(2) });	// 2x^2-1
+		DensePoly p3 = DensePoly::monomial(Integer(3), 4);
+
+		TestModule tests("DensePoly", verbose);
+		tests.runTest(denseToString(p1), "x+1");
+		tests.runTest(denseToString(p2), "2x^2-1");
+		tests.runTest(denseToString(p3), "3x^4");
+		tests.runTest(denseToString(p1 + p2), "2x^2+x");
+		tests.runTest(denseToString(p1 - p1), "0");
+		tests.runTest(denseToString(p1 * p2), "2x^3+2x^2-x-1");
+		tests.runTest(denseToString(p1.pow(3)), "x^3+3x^2+3x+1");
+		tests.runTest(denseToString(-p3), "-3x^4");
+		tests.runTest(std::to_string((p1 - p1).degree()), "-1");
+
+		std::cout << tests.result() << std::endl;
+		status &= tests.status();
+	}
+
+	{
+		std::mt19937 rng(0);
+		DensePoly small = randomPoly(rng, 200, 1000);
+		DensePoly small2 = randomPoly(rng, 150, 1000);
+		DensePoly wide = randomPoly(rng, 100, 2000000000);
+		DensePoly big = DensePoly({ Integer("123456789012345678901234567890"), Integer(1) }).pow(3) * randomPoly(rng, 80, 100);
+		DensePoly ref = mulSchoolbook(small, small2);
+		DensePoly res;
+
+		TestModule tests("poly-math", verbose);
+		tests.runTest(std::to_string(mulKaratsuba(small, small2) == ref), "1");
+		tests.runTest(std::to_string(mulNTT(small, small2, res) && res == ref), "1");
+		tests.runTest(std::to_string(mul(small, small2) == ref), "1");
+		tests.runTest(std::to_string(mulNTT(wide, wide, res) && res == mulSchoolbook(wide, wide)), "1");
+		tests.runTest(std::to_string(mulNTT(big, small, res)), "0");	// coefficients too large
+		tests.runTest(std::to_string(mul(big, small) == mulSchoolbook(big, small)), "1");
+		tests.runTest(std::to_string(mulKaratsuba(small, DensePoly(Integer(3))) == small * DensePoly(Integer(3))), "1");
+		tests.runTest(std::to_string(pow(DensePoly({ Integer(1), Integer(1) }), 40) == DensePoly({ Integer(1), Integer(1) }).pow(40)), "1");
+
+		std::cout << tests.result() << std::endl;
+		status &= tests.status();
+	}
+
+	{
+		DensePoly x({ Integer(0), Integer(1) });
+		DensePoly cheb0(Integer(1)), cheb1 = x;
+		for (int i = 2; i <= 30; ++i)
+		{
+			DensePoly next = DensePoly(Integer(2)) * x * cheb1 - cheb0;
+			cheb0 = cheb1;
+			cheb1 = next;
+		}
+
+		DensePoly wilkinson(Integer(1));
+		for (int i = 1; i <= 20; ++i)
+			wilkinson *= DensePoly({ Integer(-i), Integer(1) });
+
+		std::string rounded;
+		for (const auto& r : isolateRealRoots(wilkinson))
+			rounded += refineRoot(wilkinson, r, 64).toString() + " ";
+
+		DensePoly sqrt2({ Integer(-2), Integer(0), Integer(1) });
+		DensePoly close = DensePoly({ Integer(-1), Integer(100000000) }) * DensePoly({ Integer(-1), Integer(100000001) });
+		DensePoly repeated = DensePoly({ Integer(-1), Integer(1) }).pow(3) * DensePoly({ Integer(2), Integer(1) });
+
+		TestModule tests("poly-roots", verbose);
+		tests.runTest(std::to_string(isolateRealRoots(cheb1).size()), "30");
+		tests.runTest(rounded, "1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 ");
+		tests.runTest(refineRoot(sqrt2, isolateRealRoots(sqrt2).back(), 64).toString(), "1.414213562373095");
+		tests.runTest(std::to_string(isolateRealRoots(close).size()), "2");
+		tests.runTest(std::to_string(isolateRealRoots(sqrt2 + DensePoly(Integer(3))).size()), "0");
+		tests.runTest(std::to_string(squarefreePart(repeated) == DensePoly({ Integer(-2), Integer(1), Integer(1) })), "1");
+		tests.runTest(std::to_string(derivative(repeated).degree()), "3");
+		tests.runTest(std::to_string(signAt(sqrt2, Rational(Integer(3), Integer(2)))), "1");
+
+		std::cout << tests.result() << std::endl;
+		status &= tests.status();
+	}
+
+	{
+		SparsePoly x = SparsePoly::variable("x");
+		SparsePoly y = SparsePoly::variable("y");
+		SparsePoly p = (x + y) * (x - y);
+
+		// One variable too many: the operation fails rather than packing past 64 bits
+		SparsePoly wide, term = SparsePoly(Integer(1));
+		for (size_t i = 0; i < MATHSOLVER_SPARSE_POLY_MAX_VARS; ++i)
+			wide += SparsePoly::variable("v" + std::to_string(i));
+		gErrorManager.clear();
+		SparsePoly sum = wide + x;
+		bool sumFailed = gErrorManager.hasError();
+		gErrorManager.clear();
+		SparsePoly prod = wide * (x + term);
+		bool prodFailed = gErrorManager.hasError();
+		gErrorManager.clear();
+		SparsePoly tooWide(std::vector<std::string>(MATHSOLVER_SPARSE_POLY_MAX_VARS + 1, "v"));
+		bool ctorFailed = gErrorManager.hasError();
+		gErrorManager.clear();
+
+		TestModule tests("SparsePoly", verbose);
+		tests.runTest(std::to_string(p.size()), "2");
+		tests.runTest(std::to_string(p.variables().size()), "2");
+		tests.runTest(std::to_string((x + y).pow(10).size()), "11");
+		tests.runTest(std::to_string((x + y + SparsePoly(Integer(1))).pow(20).size()), "231");
+		tests.runTest(std::to_string(p == x * x - y * y), "1");
+		tests.runTest(std::to_string(wide.size()) + " " + std::to_string(wide.variables().size()), "64 64");
+		tests.runTest(std::to_string(sumFailed && sum.isZero()), "1");
+		tests.runTest(std::to_string(prodFailed && prod.isZero()), "1");
+		tests.runTest(std::to_string(ctorFailed && tooWide.variables().empty()), "1");
+
+		std::cout << tests.result() << std::endl;
+		status &= tests.status();
+	}
+
+	{
+		const size_t COUNT = 9;
+		std::string exprs[COUNT * 2] =
+		{
+			"(x+1)^2",			"x^2+2x+1",
+			"(x+y)^2",			"x^2+2xy+y^2",
+			"(x-y)(x+y)",		"x^2-y^2",
+			"(a+b)(a-b)+b^2",	"a^2",
+			"2x(3x-1)",			"6x^2-2x",
+			"(1-x)^3",			"-x^3+3x^2-3x+1",
+			"(x+y+1)^2",		"x^2+2xy+y^2+2x+2y+1",
+			"x-x",				"0",
+			"(x+1)/2",			"(x+1)/2"
+		};
+
+		TestModule tests("expandPolynomial", verbose);
+		status &= expandExpr(tests, exprs, COUNT);
+	}
+
+	{
+		const size_t COUNT = 6;
+		std::string exprs[COUNT * 3] =
+		{
+			"2x^2+3x+1",			"(2*x+3)*x+1",				"15",
+			"x^5-1",				"x^5-1",					"31",
+			"x^3*y+2x*y^2-y+4",		"(y*x^2+2*y^2)*x+4-y",		"61",
+			"x/2+x^2",				"(x+0.5)*x",				"5",
+			"x-x",					"0",						"0",
+			"sin(x)+1",				"undef",					"0"
+		};
+
+		TestModule tests("PolyProgram", verbose);
+		status &= lowerExpr(tests, exprs, COUNT);
+	}
+
+	{
+		ExprNode* expr = parseString("x^8+x^7+x^6+x^5+x^4+x^3+x^2+x+1");
+		PolyProgram horner, estrin;
+		horner.lower(expr);
+		estrin.lower(expr, PolyProgram::ESTRIN);
+
+		ExprNode* form = estrin.toExpr();
+		TestModule tests("PolyProgram (Estrin)", verbose);
+		tests.runTest(toInfixString(form), "x^8+((x+1)*x^2+x+1)*x^4+(x+1)*x^2+x+1");
+		tests.runTest(std::to_string(estrin.evaluate(std::vector<double>({ 0.5 }))), std::to_string(horner.evaluate(std::vector<double>({ 0.5 }))));
+		tests.runTest(estrin.evaluate(std::vector<Float>({ Float("3") })).toString(), "9841");
+		tests.runTest(std::to_string(estrin.exact()), "1");
+
+		ExprNode* third = parseString("x^2+x/3");
+		horner.lower(third);
+		tests.runTest(std::to_string(horner.exact()), "0");
+		freeExpression(third);
+
+		std::cout << tests.result() << std::endl;
+		status &= tests.status();
+		freeExpression(form);
+		freeExpression(expr);
+	}
+
+	return (int)(!status);
+}
@@ -1,7 +1,11 @@
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <string>
+#include <vector>
 #include "../lib/test/test-common.h"
 #include "../lib/types/range.h"
+#include "../lib/types/range-index.h"
 
 using namespace MathSolver;
 
@@ -12,6 +16,25 @@ std::string bool_to_string(bool x)
 
 Range makeRange() { return Range(); }
 
+std::string ids(std::vector<size_t> res)
+{
+    std::string str;
+    std::sort(res.begin(), res.end());
+    for (size_t id : res)
+        str += std::to_string(id);
+    return str;
+}
+
+std::string classify(const Range& r, const std::vector<double>& pts)
+{
+    bool res[64];
+    std::string str;
+    r.contains(pts.data(), pts.size(), res);
+    for (size_t i = 0; i < pts.size(); ++i)
+        str += (res[i] ? "1" : "0");
+    return str;
+}
+
 int main()
 {
 	bool status = true;
@@ -52,6 +75,32 @@ int main()
         status &= tests.status();
     }
 
+    {
+        Range r1 = { { "0", "1", false, true }, { "2", "3", true, false } };
+        Range r2("0.1", "0.3", false, false);
+        Range r3;
+        for (int k = 19; k >= 0; --k)
+            r3 = r3.disjoin(Range(Float(std::to_string(2 * k)), Float(std::to_string(2 * k + 1)), true, false));
+
+        Float fpts[] = { "-1", "0", "0.5", "1", "1.5", "2", "3" };
+        bool fres[7];
+        std::string fstr;
+        r1.contains(fpts, 7, fres);
+        for (bool b : fres)
+            fstr += (b ? "1" : "0");
+
+        TestModule tests("contains (batch)", verbose);
+        tests.runTest(classify(r1, { -1, 0, 0.5, 1, 1.5, 2, 2.5, 3 }), "00110110");
+        tests.runTest(classify(r1, { 3, 0, 2, 1, -1, 2.5, 1.5, 0.5 }), "00110101");
+        tests.runTest(classify(r2, { 0.1, 0.3, std::nextafter(0.1, 0.0), std::nextafter(0.3, 1.0) }), "1100");
+        tests.runTest(classify(r3, { -1, 0, 0.5, 1, 20, 38.5, 39, 40 }), "01101100");
+        tests.runTest(classify(r3, { 39, 38.5, 20, 1, 0.5, 0, -1 }), "0110110");
+        tests.runTest(fstr, "0011010");
+
+        std::cout << tests.result() << std::endl;
+        status &= tests.status();
+    }
+
     {
         interval_t ival1 = { "0.0", "1.0", true, true };
         interval_t ival2 = { "-2.0", "-1.0", true , true };
@@ -218,5 +267,56 @@ int main()
         status &= tests.status();
     }
 
+    {
+        RangeIndex index({ Range("0", "10", true, true),
+                           Range({ { "-inf", "1", false, false }, { "5", "inf", false, false } }),
+                           Range("1", "5", false, true),
+                           Range("5", "6", false, false) });
+        interval_t ival1 = { "5", "5", true, true };
+        interval_t ival2 = { "-3", "-2", false, true };
+        interval_t ival3 = { "6", "7", true, true };
+
+        TestModule tests("RangeIndex", verbose);
+        tests.runTest(ids(index.stab("0.5")), "01");
+        tests.runTest(ids(index.stab("1")), "0");
+        tests.runTest(ids(index.stab("5")), "02");
+        tests.runTest(ids(index.stab("5.5")), "013");
+        tests.runTest(ids(index.stab("20")), "1");
+        tests.runTest(ids(index.overlap(ival1)), "02");
+        tests.runTest(ids(index.overlap(ival2)), "1");
+        tests.runTest(ids(index.overlap(ival3)), "01");
+
+        index.insert(Range("-2.5", "-2.5", true, true));
+        index.insert(Range({ { "0.5", "0.75", true, true }, { "5", "5", true, true } }));
+        tests.runTest(std::to_string(index.size()), "6");
+        tests.runTest(ids(index.stab("-2.5")), "14");
+        tests.runTest(ids(index.stab("5")), "025");
+        tests.runTest(ids(index.overlap(Range({ ival1, ival2 }))), "01245");
+
+        std::cout << tests.result() << std::endl;
+        status &= tests.status();
+    }
+
+    {
+        Range r1 = Range({ { "0", "1", true, false }, { "4", "5", true, true } });
+        Range r2 = Range({ { "1", "2", true, false }, { "3", "4", false, false } });
+        Range r3 = Range({ { "-1", "0.5", false, true }, { "4.5", "6", false, true } });
+        Range r4 = Range("-inf", "inf", false, false);
+        Range empty;
+
+        TestModule tests("n-ary disjoin, conjoin", verbose);
+        tests.runTest(Range::disjoin({ &r1, &r2, &r3 }).toString(), "(-1, 2) U (3, 6]");
+        tests.runTest(Range::disjoin({ &r1, &r2, &r3 }).toString(), r1.disjoin(r2).disjoin(r3).toString());
+        tests.runTest(Range::disjoin({ &empty, &r2 }).toString(), r2.toString());
+        tests.runTest(Range::disjoin(std::vector<const Range*>()).toString(), "{}");
+        tests.runTest(Range::conjoin({ &r1, &r3 }).toString(), "[0, 0.5] U (4.5, 5]");
+        tests.runTest(Range::conjoin({ &r1, &r3, &r4 }).toString(), r1.conjoin(r3).conjoin(r4).toString());
+        tests.runTest(Range::conjoin({ &r1, &r2 }).toString(), "{}");
+        tests.runTest(Range::conjoin({ &r4, &empty }).toString(), "{}");
+
+        std::cout << tests.result() << std::endl;
+        status &= tests.status();
+    }
+
     return (int)(!status);
 }
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include <iostream>
+#include <string>
+#include "../lib/test/test-common.h"
+#include "../lib/math/float-math.h"
+#include "../lib/math/integer-math.h"
+#include "../lib/types/rational.h"
+
+using namespace MathSolver;
+
+int main()
+{
+	bool status = true;
+	bool verbose = false;
+
+	{
+		TestModule tests("Constructor", verbose);
+		tests.runTest(Rational().toString(), "0");
+		tests.runTest(Rational(Integer(7)).toString(), "7");
+		tests.runTest(Rational(Integer(4), Integer(6)).toString(), "2/3");
+		tests.runTest(Rational(Integer(3), Integer(-6)).toString(), "-1/2");
+		tests.runTest(Rational(Integer(-8), Integer(-4)).toString(), "2");
+		tests.runTest(Rational(Integer(0), Integer(-5)).toString(), "0");
+		tests.runTest(Rational(Integer(1), Integer(0)).toString(), "undef");
+
+		std::cout << tests.result() << std::endl;
+		status &= tests.status();
+	}
+
+	{
+		Rational a(Integer(1), Integer(2));
+		Rational b(Integer(-2), Integer(3));
+		Rational c(Integer(5), Integer(6));
+
+		TestModule tests("Arithmetic", verbose);
+		tests.runTest((a + b).toString(), "-1/6");
+		tests.runTest((a - b).toString(), "7/6");
+		tests.runTest((a * b).toString(), "-1/3");
+		tests.runTest((a / b).toString(), "-3/4");
+		tests.runTest((a + c - b).toString(), "2");
+		tests.runTest((-c).toString(), "-5/6");
+		tests.runTest((a / Rational()).toString(), "undef");
+		tests.runTest(pow(b, Integer(3)).toString(), "-8/27");
+		tests.runTest(pow(b, Integer(-2)).toString(), "9/4");
+
+		Rational h;
+		for (int i = 1; i <= 30; ++i)
+			h += Rational(Integer(1), Integer(i));
+		tests.runTest(h.toString(), "9304682830147/2329089562800");
+
+		std::cout << tests.result() << std::endl;
+		status &= tests.status();
+	}
+
+	{
+		Rational a(Integer(1), Integer(3));
+		Rational b(Integer(2), Integer(6));
+		Rational c(Integer(-1), Integer(2));
+
+		TestModule tests("Comparison", verbose);
+		tests.runTest(std::to_string(a == b), "1");
+		tests.runTest(std::to_string(a > c), "1");
+		tests.runTest(std::to_string(c < Rational()), "1");
+		tests.runTest(std::to_string((a * Rational(Integer(3))).isInteger()), "1");
+		tests.runTest(std::to_string(Rational(Integer(1), Integer(0)) == Rational(Integer(1), Integer(0))), "0");
+		tests.runTest(rationalToFloat(a, 53).toString(), "0.3333333333333333");
+
+		std::cout << tests.result() << std::endl;
+		status &= tests.status();
+	}
+
+	return (int)(!status);
+}